@@ -0,0 +1,80 @@
+// Measure the throughput of EventLoopThread::executeThreadSafe() when several producer threads schedule callbacks
+// concurrently on the same event loop thread.
+//
+// Usage: benchmark_event_loop_thread [producers] [tasks per producer]
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "scaler/ymq/internal/event_loop_thread.h"
+
+using scaler::ymq::internal::EventLoopThread;
+
+int main(int argc, char* argv[])
+{
+    const size_t nProducers        = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8;
+    const size_t nTasksPerProducer = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000;
+    const size_t nTasks            = nProducers * nTasksPerProducer;
+
+    EventLoopThread thread {};
+
+    // Only accessed from the event loop thread
+    size_t nExecuted = 0;
+    std::promise<void> allExecuted {};
+
+    std::atomic<bool> start {false};
+
+    std::vector<std::jthread> producers {};
+    std::vector<std::chrono::nanoseconds> producerDurations(nProducers);
+
+    for (size_t i = 0; i < nProducers; ++i) {
+        producers.emplace_back([&, i]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            const auto producerStart = std::chrono::steady_clock::now();
+
+            for (size_t j = 0; j < nTasksPerProducer; ++j) {
+                thread.executeThreadSafe([&]() {
+                    if (++nExecuted == nTasks) {
+                        allExecuted.set_value();
+                    }
+                });
+            }
+
+            producerDurations[i] = std::chrono::steady_clock::now() - producerStart;
+        });
+    }
+
+    const auto benchmarkStart = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+
+    allExecuted.get_future().wait();
+    const auto benchmarkDuration = std::chrono::steady_clock::now() - benchmarkStart;
+
+    producers.clear();
+
+    std::chrono::nanoseconds totalProducerDuration {0};
+    for (const auto& duration: producerDurations) {
+        totalProducerDuration += duration;
+    }
+
+    const double seconds         = std::chrono::duration<double>(benchmarkDuration).count();
+    const double nsPerEnqueue    = static_cast<double>(totalProducerDuration.count()) / static_cast<double>(nTasks);
+    const double tasksPerSeconds = static_cast<double>(nTasks) / seconds;
+
+    std::cout << "producers:           " << nProducers << std::endl;
+    std::cout << "tasks:               " << nTasks << std::endl;
+    std::cout << "total time:          " << seconds << " s" << std::endl;
+    std::cout << "throughput:          " << tasksPerSeconds << " tasks/s" << std::endl;
+    std::cout << "producer cost:       " << nsPerEnqueue << " ns/executeThreadSafe()" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Compare the message rate and the CPU cost of the libuv and io_uring IO backends, with small messages over TCP.
+//
+// Usage: benchmark_io_backend [message size in bytes] [messages]
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <expected>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "scaler/ymq/buffered_bytes.h"
+#include "scaler/ymq/future/connector_socket.h"
+#include "scaler/ymq/io_backend.h"
+#include "scaler/ymq/io_context.h"
+#include "scaler/ymq/sync/connector_socket.h"
+
+using scaler::ymq::BufferedBytes;
+using scaler::ymq::IOBackend;
+using scaler::ymq::IOContext;
+
+namespace {
+
+// Messages sent but not yet acknowledged by the sending socket.
+constexpr size_t maxMessagesInFlight = 64;
+
+// The user and system CPU time consumed by all the threads of the process.
+std::chrono::duration<double> cpuTime()
+{
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+
+    const auto toDuration = [](const timeval& time) {
+        return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+    };
+
+    return toDuration(usage.ru_utime) + toDuration(usage.ru_stime);
+}
+
+// Returns the wall-clock and CPU durations of the transfer of nMessages messages of messageSize bytes.
+std::pair<std::chrono::duration<double>, std::chrono::duration<double>> run(
+    IOBackend backend, size_t messageSize, size_t nMessages)
+{
+    IOContext context {2, backend};
+
+    auto [receiver, address] =
+        scaler::ymq::sync::ConnectorSocket::bind(context, "receiver", "tcp://127.0.0.1:0").value();
+    auto sender = scaler::ymq::future::ConnectorSocket::connect(context, "sender", address.toString().value()).value();
+
+    // Make sure the connection is established before starting the clock.
+    sender.sendMessage(std::make_unique<BufferedBytes>(1)).get().value();
+    receiver.recvMessage().value();
+
+    const auto start    = std::chrono::steady_clock::now();
+    const auto startCPU = cpuTime();
+
+    std::jthread receiverThread([&]() {
+        for (size_t i = 0; i < nMessages; ++i) {
+            receiver.recvMessage().value();
+        }
+    });
+
+    std::vector<std::future<std::expected<void, scaler::ymq::Error>>> inFlight {};
+    for (size_t i = 0; i < nMessages; ++i) {
+        if (inFlight.size() >= maxMessagesInFlight) {
+            for (auto& future: inFlight) {
+                future.get().value();
+            }
+            inFlight.clear();
+        }
+
+        inFlight.emplace_back(sender.sendMessage(std::make_unique<BufferedBytes>(messageSize)));
+    }
+
+    for (auto& future: inFlight) {
+        future.get().value();
+    }
+
+    receiverThread.join();
+
+    return {std::chrono::steady_clock::now() - start, cpuTime() - startCPU};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t messageSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    const size_t nMessages   = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200'000;
+
+    std::cout << "message size:        " << messageSize << " bytes" << std::endl;
+    std::cout << "messages:            " << nMessages << std::endl;
+
+    const std::vector<std::pair<std::string, IOBackend>> backends {
+        {"libuv", IOBackend::LibUV},
+        {"io_uring", IOBackend::IOUring},
+    };
+
+    for (const auto& [name, backend]: backends) {
+        const auto [wallTime, cpu] = run(backend, messageSize, nMessages);
+
+        std::cout << name << ":" << std::endl;
+        std::cout << "  message rate:      " << static_cast<double>(nMessages) / wallTime.count() << " msg/s"
+                  << std::endl;
+        std::cout << "  CPU per message:   " << cpu.count() * 1e6 / static_cast<double>(nMessages) << " us"
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Measure the latency of small control messages sent while a concurrent bulk transfer saturates the same connection,
+// with the control messages sent at normal then at high priority.
+//
+// Usage: benchmark_priority_latency [control messages] [bulk message size in bytes]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scaler/ymq/buffered_bytes.h"
+#include "scaler/ymq/future/connector_socket.h"
+#include "scaler/ymq/io_context.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/sync/connector_socket.h"
+
+using scaler::ymq::BufferedBytes;
+using scaler::ymq::IOContext;
+using scaler::ymq::MessagePriority;
+
+namespace {
+
+// The first byte of each message tells the receiver what it is.
+constexpr char bulkTag    = 'b';
+constexpr char controlTag = 'c';
+constexpr char stopTag    = 's';
+
+// Bulk messages sent and not yet received by the receiving thread.
+constexpr size_t maxBulkMessagesInFlight = 4;
+
+constexpr std::chrono::milliseconds controlInterval {1};
+constexpr std::chrono::microseconds bulkPollInterval {100};
+
+std::unique_ptr<BufferedBytes> controlMessage()
+{
+    const int64_t sentAt = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    auto message       = std::make_unique<BufferedBytes>(1 + sizeof(sentAt));
+    message->data()[0] = controlTag;
+    std::memcpy(message->data() + 1, &sentAt, sizeof(sentAt));
+
+    return message;
+}
+
+// Returns the latencies of the control messages, sorted.
+std::vector<std::chrono::nanoseconds> run(
+    MessagePriority controlPriority, size_t nControlMessages, size_t bulkMessageSize)
+{
+    IOContext context {2};
+
+    auto [receiver, address] =
+        scaler::ymq::sync::ConnectorSocket::bind(context, "receiver", "tcp://127.0.0.1:0").value();
+    auto sender = scaler::ymq::future::ConnectorSocket::connect(context, "sender", address.toString().value()).value();
+
+    std::vector<std::chrono::nanoseconds> latencies {};
+    latencies.reserve(nControlMessages);
+
+    std::atomic<size_t> nControlReceived {0};
+    std::atomic<size_t> nBulkReceived {0};
+
+    std::jthread receiverThread([&]() {
+        while (true) {
+            auto message   = receiver.recvMessage().value();
+            const char tag = static_cast<char>(message.payload->data()[0]);
+
+            if (tag == stopTag) {
+                break;
+            } else if (tag == bulkTag) {
+                nBulkReceived.fetch_add(1, std::memory_order_release);
+            } else if (tag == controlTag) {
+                int64_t sentAt;
+                std::memcpy(&sentAt, message.payload->data() + 1, sizeof(sentAt));
+
+                const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+                latencies.emplace_back(now - sentAt);
+                nControlReceived.fetch_add(1, std::memory_order_release);
+            }
+        }
+    });
+
+    std::atomic<bool> stopBulk {false};
+
+    std::jthread bulkThread([&]() {
+        // Throttle on the receiving thread rather than on the send completions, or the received messages would pile up
+        // in the receiver's queue and delay the control messages regardless of their priority.
+        size_t nBulkSent = 0;
+
+        while (!stopBulk.load(std::memory_order_acquire)) {
+            if (nBulkSent - nBulkReceived.load(std::memory_order_acquire) >= maxBulkMessagesInFlight) {
+                std::this_thread::sleep_for(bulkPollInterval);
+                continue;
+            }
+
+            auto message       = std::make_unique<BufferedBytes>(bulkMessageSize);
+            message->data()[0] = bulkTag;
+            sender.sendMessage(std::move(message));
+            ++nBulkSent;
+        }
+    });
+
+    for (size_t i = 0; i < nControlMessages; ++i) {
+        std::this_thread::sleep_for(controlInterval);
+        sender.sendMessage(controlMessage(), controlPriority);
+    }
+
+    while (nControlReceived.load(std::memory_order_acquire) < nControlMessages) {
+        std::this_thread::sleep_for(controlInterval);
+    }
+
+    stopBulk.store(true, std::memory_order_release);
+    bulkThread.join();
+
+    auto stopMessage       = std::make_unique<BufferedBytes>(1);
+    stopMessage->data()[0] = stopTag;
+    sender.sendMessage(std::move(stopMessage)).get().value();
+
+    receiverThread.join();
+
+    std::ranges::sort(latencies);
+    return latencies;
+}
+
+double percentileMicroseconds(const std::vector<std::chrono::nanoseconds>& sortedLatencies, double percentile)
+{
+    const size_t index = std::min(
+        static_cast<size_t>(percentile / 100.0 * static_cast<double>(sortedLatencies.size())),
+        sortedLatencies.size() - 1);
+
+    return std::chrono::duration<double, std::micro>(sortedLatencies[index]).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t nControlMessages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000;
+    const size_t bulkMessageSize  = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32ULL * 1024ULL * 1024ULL;
+
+    std::cout << "control messages:    " << nControlMessages << std::endl;
+    std::cout << "bulk message size:   " << bulkMessageSize << " bytes" << std::endl;
+
+    for (const MessagePriority priority: {MessagePriority::Normal, MessagePriority::High}) {
+        const auto latencies = run(priority, nControlMessages, bulkMessageSize);
+
+        std::cout << (priority == MessagePriority::High ? "high priority:" : "normal priority:") << std::endl;
+        std::cout << "  p50 latency:       " << percentileMicroseconds(latencies, 50.0) << " us" << std::endl;
+        std::cout << "  p99 latency:       " << percentileMicroseconds(latencies, 99.0) << " us" << std::endl;
+        std::cout << "  max latency:       " << percentileMicroseconds(latencies, 100.0) << " us" << std::endl;
+    }
+
+    return 0;
+}
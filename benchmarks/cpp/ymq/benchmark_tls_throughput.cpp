@@ -0,0 +1,105 @@
+// Measure the one-way message throughput of a tls:// connection, with the encryption done in user space then offloaded
+// to the kernel (kTLS).
+//
+// Usage: benchmark_tls_throughput <certificate chain> <private key> [message size in bytes] [messages]
+//
+// When the kernel doesn't support kTLS (e.g. the tls module isn't loaded), both runs encrypt in user space.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <expected>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scaler/ymq/buffered_bytes.h"
+#include "scaler/ymq/future/connector_socket.h"
+#include "scaler/ymq/io_context.h"
+#include "scaler/ymq/sync/connector_socket.h"
+#include "scaler/ymq/tls_config.h"
+
+using scaler::ymq::BufferedBytes;
+using scaler::ymq::IOContext;
+using scaler::ymq::TLSConfig;
+
+namespace {
+
+// Messages sent but not yet acknowledged by the sending socket.
+constexpr size_t maxMessagesInFlight = 64;
+
+// Returns the transfer duration of nMessages messages of messageSize bytes.
+std::chrono::duration<double> run(const TLSConfig& tlsConfig, size_t messageSize, size_t nMessages)
+{
+    IOContext context {2};
+
+    auto [receiver, address] =
+        scaler::ymq::sync::ConnectorSocket::bind(context, "receiver", "tls://127.0.0.1:0", tlsConfig).value();
+    auto sender =
+        scaler::ymq::future::ConnectorSocket::connect(context, "sender", address.toString().value(), tlsConfig).value();
+
+    // Make sure the connection is established before starting the clock.
+    sender.sendMessage(std::make_unique<BufferedBytes>(1)).get().value();
+    receiver.recvMessage().value();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::jthread receiverThread([&]() {
+        for (size_t i = 0; i < nMessages; ++i) {
+            receiver.recvMessage().value();
+        }
+    });
+
+    std::vector<std::future<std::expected<void, scaler::ymq::Error>>> inFlight {};
+    for (size_t i = 0; i < nMessages; ++i) {
+        if (inFlight.size() >= maxMessagesInFlight) {
+            for (auto& future: inFlight) {
+                future.get().value();
+            }
+            inFlight.clear();
+        }
+
+        inFlight.emplace_back(sender.sendMessage(std::make_unique<BufferedBytes>(messageSize)));
+    }
+
+    for (auto& future: inFlight) {
+        future.get().value();
+    }
+
+    receiverThread.join();
+
+    return std::chrono::steady_clock::now() - start;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <certificate chain> <private key> [message size] [messages]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string certChain  = argv[1];
+    const std::string privateKey = argv[2];
+    const size_t messageSize     = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64ULL * 1024ULL;
+    const size_t nMessages       = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 10'000;
+
+    std::cout << "message size:        " << messageSize << " bytes" << std::endl;
+    std::cout << "messages:            " << nMessages << std::endl;
+
+    for (const bool kernelTLS: {false, true}) {
+        const double seconds = run(TLSConfig {certChain, privateKey, kernelTLS}, messageSize, nMessages).count();
+        const double bytes   = static_cast<double>(messageSize) * static_cast<double>(nMessages);
+
+        std::cout << (kernelTLS ? "kernel TLS:" : "user space TLS:") << std::endl;
+        std::cout << "  throughput:        " << bytes / seconds / 1e6 << " MB/s" << std::endl;
+        std::cout << "  message rate:      " << static_cast<double>(nMessages) / seconds << " msg/s" << std::endl;
+    }
+
+    return 0;
+}
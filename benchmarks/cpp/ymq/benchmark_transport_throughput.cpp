@@ -0,0 +1,100 @@
+// Measure the one-way message throughput between two connector sockets, for each of the given transports.
+//
+// Usage: benchmark_transport_throughput [message size in bytes] [messages] [bind addresses...]
+//
+// The bind addresses default to tcp://127.0.0.1:0 and ws://127.0.0.1:0/.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <expected>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scaler/ymq/buffered_bytes.h"
+#include "scaler/ymq/future/connector_socket.h"
+#include "scaler/ymq/io_context.h"
+#include "scaler/ymq/sync/connector_socket.h"
+
+using scaler::ymq::BufferedBytes;
+using scaler::ymq::IOContext;
+
+namespace {
+
+// Messages sent but not yet acknowledged by the sending socket.
+constexpr size_t maxMessagesInFlight = 64;
+
+// Returns the transfer duration of nMessages messages of messageSize bytes.
+std::chrono::duration<double> run(const std::string& bindAddress, size_t messageSize, size_t nMessages)
+{
+    IOContext context {2};
+
+    auto [receiver, address] = scaler::ymq::sync::ConnectorSocket::bind(context, "receiver", bindAddress).value();
+    auto sender = scaler::ymq::future::ConnectorSocket::connect(context, "sender", address.toString().value()).value();
+
+    // Make sure the connection is established before starting the clock.
+    sender.sendMessage(std::make_unique<BufferedBytes>(1)).get().value();
+    receiver.recvMessage().value();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::jthread receiverThread([&]() {
+        for (size_t i = 0; i < nMessages; ++i) {
+            receiver.recvMessage().value();
+        }
+    });
+
+    std::vector<std::future<std::expected<void, scaler::ymq::Error>>> inFlight {};
+    for (size_t i = 0; i < nMessages; ++i) {
+        if (inFlight.size() >= maxMessagesInFlight) {
+            for (auto& future: inFlight) {
+                future.get().value();
+            }
+            inFlight.clear();
+        }
+
+        inFlight.emplace_back(sender.sendMessage(std::make_unique<BufferedBytes>(messageSize)));
+    }
+
+    for (auto& future: inFlight) {
+        future.get().value();
+    }
+
+    receiverThread.join();
+
+    return std::chrono::steady_clock::now() - start;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t messageSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64ULL * 1024ULL;
+    const size_t nMessages   = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000;
+
+    std::vector<std::string> bindAddresses {};
+    for (int i = 3; i < argc; ++i) {
+        bindAddresses.emplace_back(argv[i]);
+    }
+    if (bindAddresses.empty()) {
+        bindAddresses = {"tcp://127.0.0.1:0", "ws://127.0.0.1:0/"};
+    }
+
+    std::cout << "message size:        " << messageSize << " bytes" << std::endl;
+    std::cout << "messages:            " << nMessages << std::endl;
+
+    for (const auto& bindAddress: bindAddresses) {
+        const double seconds = run(bindAddress, messageSize, nMessages).count();
+        const double bytes   = static_cast<double>(messageSize) * static_cast<double>(nMessages);
+
+        std::cout << bindAddress << ":" << std::endl;
+        std::cout << "  throughput:        " << bytes / seconds / 1e6 << " MB/s" << std::endl;
+        std::cout << "  message rate:      " << static_cast<double>(nMessages) / seconds << " msg/s" << std::endl;
+    }
+
+    return 0;
+}
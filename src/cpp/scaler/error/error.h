@@ -22,6 +22,7 @@ struct Error: public std::exception {
         ConnectorSocketClosedByRemoteEnd,
         SocketStopRequested,
         SysCallError,
+        SendQueueFull,
     };
 
     // NOTE:
@@ -56,6 +57,7 @@ struct Error: public std::exception {
                 return "Your connector socket connection is closed by remote end";
             case ErrorCode::SocketStopRequested: return "Current socket is requested to stop by another thread";
             case ErrorCode::SysCallError: return "A system call error occurred";
+            case ErrorCode::SendQueueFull: return "The send queue reached its high-water mark";
         }
         std::cerr << "Unrecognized ErrorCode value, program exits\n";
         std::exit(1);
@@ -0,0 +1,104 @@
+#include "scaler/wrapper/openssl/kernel_tls.h"
+
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+
+#include <string>
+#include <string_view>
+
+#include "scaler/wrapper/openssl/types.h"
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+namespace {
+
+// TLS 1.3 uses a 96-bit IV for all its AEAD ciphers (RFC 8446 section 5.3).
+constexpr size_t tls13IVLength = 12;
+
+// See HKDF-Expand-Label (RFC 8446 section 7.1), with an empty context.
+std::expected<std::vector<uint8_t>, uv::Error> hkdfExpandLabel(
+    const EVP_MD* digest, std::span<const uint8_t> secret, std::string_view label, size_t length) noexcept
+{
+    const std::string fullLabel = "tls13 " + std::string(label);
+
+    std::vector<uint8_t> hkdfLabel {};
+    hkdfLabel.push_back(static_cast<uint8_t>(length >> 8));
+    hkdfLabel.push_back(static_cast<uint8_t>(length & 0xFF));
+    hkdfLabel.push_back(static_cast<uint8_t>(fullLabel.size()));
+    hkdfLabel.insert(hkdfLabel.end(), fullLabel.begin(), fullLabel.end());
+    hkdfLabel.push_back(0);
+
+    SSLPtr<EVP_KDF> kdf {EVP_KDF_fetch(nullptr, OSSL_KDF_NAME_HKDF, nullptr)};
+    if (kdf == nullptr) {
+        return std::unexpected {uv::Error {UV_ENOTSUP}};
+    }
+
+    SSLPtr<EVP_KDF_CTX> context {EVP_KDF_CTX_new(kdf.get())};
+    if (context == nullptr) {
+        return std::unexpected {uv::Error {UV_ENOMEM}};
+    }
+
+    int mode = EVP_KDF_HKDF_MODE_EXPAND_ONLY;
+
+    const OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_int(OSSL_KDF_PARAM_MODE, &mode),
+        OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char*>(EVP_MD_get0_name(digest)), 0),
+        OSSL_PARAM_construct_octet_string(
+            OSSL_KDF_PARAM_KEY, const_cast<uint8_t*>(secret.data()), secret.size()),
+        OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, hkdfLabel.data(), hkdfLabel.size()),
+        OSSL_PARAM_construct_end(),
+    };
+
+    std::vector<uint8_t> output(length);
+    if (EVP_KDF_derive(context.get(), output.data(), output.size(), params) != 1) {
+        return std::unexpected {uv::Error {UV_EPROTO}};
+    }
+
+    return output;
+}
+
+}  // namespace
+
+TLS13TrafficKeys::~TLS13TrafficKeys() noexcept
+{
+    OPENSSL_cleanse(key.data(), key.size());
+    OPENSSL_cleanse(iv.data(), iv.size());
+}
+
+std::expected<TLS13TrafficKeys, uv::Error> deriveTLS13TrafficKeys(
+    const SSL_CIPHER* cipher, std::span<const uint8_t> trafficSecret) noexcept
+{
+    const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+    if (digest == nullptr) {
+        return std::unexpected {uv::Error {UV_ENOTSUP}};
+    }
+
+    const EVP_CIPHER* aead = EVP_get_cipherbynid(SSL_CIPHER_get_cipher_nid(cipher));
+    if (aead == nullptr) {
+        return std::unexpected {uv::Error {UV_ENOTSUP}};
+    }
+
+    TLS13TrafficKeys keys {};
+
+    auto key = hkdfExpandLabel(digest, trafficSecret, "key", static_cast<size_t>(EVP_CIPHER_get_key_length(aead)));
+    if (!key.has_value()) {
+        return std::unexpected {key.error()};
+    }
+    keys.key = std::move(key.value());
+
+    auto iv = hkdfExpandLabel(digest, trafficSecret, "iv", tls13IVLength);
+    if (!iv.has_value()) {
+        return std::unexpected {iv.error()};
+    }
+    keys.iv = std::move(iv.value());
+
+    return keys;
+}
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <openssl/ssl.h>
+#include <uv.h>
+
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+#include "scaler/wrapper/uv/error.h"
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+// The key and IV protecting one direction of a TLS 1.3 connection (RFC 8446 section 7.3).
+struct TLS13TrafficKeys {
+    std::vector<uint8_t> key;
+    std::vector<uint8_t> iv;
+
+    TLS13TrafficKeys() noexcept = default;
+    ~TLS13TrafficKeys() noexcept;
+
+    TLS13TrafficKeys(const TLS13TrafficKeys&)            = delete;
+    TLS13TrafficKeys& operator=(const TLS13TrafficKeys&) = delete;
+
+    TLS13TrafficKeys(TLS13TrafficKeys&&) noexcept            = default;
+    TLS13TrafficKeys& operator=(TLS13TrafficKeys&&) noexcept = default;
+};
+
+// Derives the traffic keys from a TLS 1.3 traffic secret, as logged by OpenSSL's keylog callback.
+std::expected<TLS13TrafficKeys, uv::Error> deriveTLS13TrafficKeys(
+    const SSL_CIPHER* cipher, std::span<const uint8_t> trafficSecret) noexcept;
+
+// Hands the encryption of the data sent on the TCP socket to the kernel (kTLS).
+//
+// Any data written to the socket afterwards is sent as TLS application data records, starting at the given record
+// sequence number. Returns UV_ENOTSUP if the platform, the running kernel or the cipher suite doesn't support it, in
+// which case the socket is left untouched.
+std::expected<void, uv::Error> enableKernelTLSSend(
+    uv_os_fd_t fd, const SSL_CIPHER* cipher, const TLS13TrafficKeys& keys, uint64_t recordSequence) noexcept;
+
+// Sends a TLS alert record on a socket on which enableKernelTLSSend() succeeded.
+std::expected<void, uv::Error> sendKernelTLSAlert(uv_os_fd_t fd, uint8_t level, uint8_t description) noexcept;
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
@@ -0,0 +1,121 @@
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "scaler/wrapper/openssl/kernel_tls.h"
+
+// Older libc headers lack these.
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+namespace {
+
+constexpr uint8_t recordTypeAlert = 21;
+
+// Fills one of the kernel's tls12_crypto_info_* structures, which all share the same layout.
+template <typename CryptoInfo>
+std::expected<void, uv::Error> setSendCryptoInfo(
+    uv_os_fd_t fd, uint16_t cipherType, const TLS13TrafficKeys& keys, uint64_t recordSequence) noexcept
+{
+    CryptoInfo info {};
+
+    // The 12-byte TLS 1.3 IV is split between the salt (implicit part) and the IV (RFC 8446 section 5.3).
+    if (keys.key.size() != sizeof(info.key) || keys.iv.size() != sizeof(info.salt) + sizeof(info.iv)) {
+        return std::unexpected {uv::Error {UV_ENOTSUP}};
+    }
+
+    info.info.version     = TLS_1_3_VERSION;
+    info.info.cipher_type = cipherType;
+
+    std::memcpy(info.key, keys.key.data(), sizeof(info.key));
+    std::memcpy(info.salt, keys.iv.data(), sizeof(info.salt));
+    std::memcpy(info.iv, keys.iv.data() + sizeof(info.salt), sizeof(info.iv));
+
+    for (size_t i = 0; i < sizeof(info.rec_seq); ++i) {
+        info.rec_seq[i] = static_cast<unsigned char>(recordSequence >> (8 * (sizeof(info.rec_seq) - 1 - i)));
+    }
+
+    int err = 0;
+
+    if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+        // ENOENT: the tls kernel module isn't available.
+        err = errno == ENOENT ? UV_ENOTSUP : uv_translate_sys_error(errno);
+    } else if (setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) != 0) {
+        err = uv_translate_sys_error(errno);
+    }
+
+    OPENSSL_cleanse(&info, sizeof(info));
+
+    if (err) {
+        return std::unexpected {uv::Error {err}};
+    }
+
+    return {};
+}
+
+}  // namespace
+
+std::expected<void, uv::Error> enableKernelTLSSend(
+    uv_os_fd_t fd, const SSL_CIPHER* cipher, const TLS13TrafficKeys& keys, uint64_t recordSequence) noexcept
+{
+    switch (SSL_CIPHER_get_protocol_id(cipher)) {
+        case 0x1301:  // TLS_AES_128_GCM_SHA256
+            return setSendCryptoInfo<tls12_crypto_info_aes_gcm_128>(fd, TLS_CIPHER_AES_GCM_128, keys, recordSequence);
+        case 0x1302:  // TLS_AES_256_GCM_SHA384
+            return setSendCryptoInfo<tls12_crypto_info_aes_gcm_256>(fd, TLS_CIPHER_AES_GCM_256, keys, recordSequence);
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case 0x1303:  // TLS_CHACHA20_POLY1305_SHA256
+            return setSendCryptoInfo<tls12_crypto_info_chacha20_poly1305>(
+                fd, TLS_CIPHER_CHACHA20_POLY1305, keys, recordSequence);
+#endif
+        default: return std::unexpected {uv::Error {UV_ENOTSUP}};
+    }
+}
+
+std::expected<void, uv::Error> sendKernelTLSAlert(uv_os_fd_t fd, uint8_t level, uint8_t description) noexcept
+{
+    uint8_t alert[] = {level, description};
+
+    iovec iov {};
+    iov.iov_base = alert;
+    iov.iov_len  = sizeof(alert);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint8_t))] {};
+
+    msghdr message {};
+    message.msg_iov        = &iov;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    // The record type of data sent through kTLS defaults to application data, override it.
+    cmsghdr* header    = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_TLS;
+    header->cmsg_type  = TLS_SET_RECORD_TYPE;
+    header->cmsg_len   = CMSG_LEN(sizeof(uint8_t));
+    *CMSG_DATA(header) = recordTypeAlert;
+
+    if (sendmsg(fd, &message, MSG_NOSIGNAL) < 0) {
+        return std::unexpected {uv::Error {uv_translate_sys_error(errno)}};
+    }
+
+    return {};
+}
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
@@ -0,0 +1,22 @@
+#include "scaler/wrapper/openssl/kernel_tls.h"
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+// Kernel TLS is only available on Linux.
+
+std::expected<void, uv::Error> enableKernelTLSSend(
+    uv_os_fd_t, const SSL_CIPHER*, const TLS13TrafficKeys&, uint64_t) noexcept
+{
+    return std::unexpected {uv::Error {UV_ENOTSUP}};
+}
+
+std::expected<void, uv::Error> sendKernelTLSAlert(uv_os_fd_t, uint8_t, uint8_t) noexcept
+{
+    return std::unexpected {uv::Error {UV_ENOTSUP}};
+}
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
@@ -1,13 +1,18 @@
 #include "scaler/wrapper/openssl/secure_socket.h"
 
+#include <openssl/crypto.h>
+
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
 #include <functional>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "scaler/wrapper/openssl/kernel_tls.h"
+
 namespace scaler {
 namespace wrapper {
 namespace openssl {
@@ -65,9 +70,21 @@ std::expected<SecureSocket, uv::Error> SecureSocket::init(uv::Loop& loop, SSLCon
     BIO_up_ref(writeBIO.get());
     SSL_set_bio(ssl.get(), readBIO.get(), writeBIO.get());
 
+    if (context.kernelTLSEnabled()) {
+        // The keylog callback is set on the shared context, it finds the socket's state through the SSL's app data.
+        SSL_CTX_set_keylog_callback(context.native(), &SecureSocket::onKeyLog);
+        SSL_set_msg_callback(ssl.get(), &SecureSocket::onProtocolMessage);
+    }
+
+    if (context.sessionCache() != nullptr) {
+        SSL_CTX_sess_set_new_cb(context.native(), &SecureSocket::onNewSession);
+    }
+
     auto state = std::make_shared<State>(
         std::move(context), std::move(tcpSocket.value()), std::move(ssl), std::move(readBIO), std::move(writeBIO));
 
+    SSL_set_app_data(state->_ssl.get(), state.get());
+
     return SecureSocket {std::move(state)};
 }
 
@@ -78,6 +95,19 @@ std::expected<uv::ConnectRequest, uv::Error> SecureSocket::connect(
         return std::unexpected {uv::Error {UV_EINVAL}};
     }
 
+    SessionCache* sessionCache = _state->_context.sessionCache();
+    if (sessionCache != nullptr) {
+        std::expected<std::string, uv::Error> server = address.toString();
+        if (server.has_value()) {
+            _state->_sessionCacheKey = std::move(server.value());
+
+            SSLPtr<SSL_SESSION> session = sessionCache->lookup(_state->_sessionCacheKey);
+            if (session != nullptr) {
+                SSL_set_session(_state->_ssl.get(), session.get());  // takes its own reference
+            }
+        }
+    }
+
     _state->_connectionState     = ConnectionState::Connecting;
     _state->_onHandshakeCallback = std::move(callback);
 
@@ -133,6 +163,11 @@ std::expected<void, uv::Error> SecureSocket::write(
         return {};
     }
 
+    if (_state->_kernelSend && _state->_pendingWrites.empty() &&
+        _state->_connectionState == ConnectionState::Established) {
+        return writeToKernel(_state, buffers, std::move(callback));
+    }
+
     // Queue each buffer as a single PendingWrite object.
     for (const auto& buffer: buffers) {
         // Only attach the callback to the last buffer; earlier get a noop.
@@ -201,6 +236,11 @@ bool SecureSocket::established() const noexcept
     return _state->_connectionState == ConnectionState::Established;
 }
 
+bool SecureSocket::sessionReused() const noexcept
+{
+    return SSL_session_reused(_state->_ssl.get()) == 1;
+}
+
 uv::TCPSocket& SecureSocket::transport() noexcept
 {
     return _state->_transport;
@@ -261,6 +301,8 @@ std::expected<void, uv::Error> SecureSocket::tryFinishHandshake(std::shared_ptr<
 
     state->_connectionState = ConnectionState::Established;
 
+    tryEnableKernelSend(state);
+
     (*state->_onHandshakeCallback)({});
     state->_onHandshakeCallback.reset();
 
@@ -280,6 +322,21 @@ std::expected<void, uv::Error> SecureSocket::tryFinishShutdown(std::shared_ptr<S
     assert(state->_onShutdownCallback.has_value());
     assert(state->_pendingWrites.empty());
 
+    if (state->_kernelSend) {
+        if (state->_kernelWritesInFlight > 0) {
+            return {};  // resumed by the last write's callback
+        }
+
+        // OpenSSL no longer knows the sending record sequence, the close_notify alert has to go through the kernel.
+        // This is best effort, the peer sees the transport shutdown regardless.
+        std::expected<uv_os_fd_t, uv::Error> fd = state->_transport.fileno();
+        if (fd.has_value()) {
+            (void)sendKernelTLSAlert(fd.value(), SSL3_AL_WARNING, SSL_AD_CLOSE_NOTIFY);
+        }
+
+        return shutdownTransport(state);
+    }
+
     const int status = SSL_shutdown(state->_ssl.get());
 
     std::expected<void, uv::Error> flushResult = flushToTransport(state);
@@ -310,6 +367,11 @@ std::expected<void, uv::Error> SecureSocket::tryFinishShutdown(std::shared_ptr<S
 
     // SSL shutdown completed, shut down the transport.
 
+    return shutdownTransport(state);
+}
+
+std::expected<void, uv::Error> SecureSocket::shutdownTransport(std::shared_ptr<State> state) noexcept
+{
     state->_transport.readStop();
 
     std::expected<uv::ShutdownRequest, uv::Error> shutdownResult =
@@ -372,6 +434,13 @@ std::expected<void, uv::Error> SecureSocket::flushToTransport(std::shared_ptr<St
             return {};
         }
 
+        if (state->_kernelSend) {
+            // OpenSSL wants to send a record (e.g. a KeyUpdate response) that it encrypted out of sequence with the
+            // kernel's records.
+            failWithError(state, uv::Error {UV_EPROTO});
+            return std::unexpected {uv::Error {UV_EPROTO}};
+        }
+
         auto buffer = std::make_unique<std::vector<uint8_t>>(pending);
 
         const int readCount =
@@ -401,13 +470,33 @@ std::expected<void, uv::Error> SecureSocket::processPendingWrites(std::shared_pt
         return {};
     }
 
+    tryEnableKernelSend(state);
+
+    while (state->_kernelSend && !state->_pendingWrites.empty()) {
+        PendingWrite pendingWrite = std::move(state->_pendingWrites.front());
+        state->_pendingWrites.pop_front();
+
+        const std::span<const std::span<const uint8_t>> buffers {&pendingWrite._payload, 1};
+
+        std::expected<void, uv::Error> writeResult = writeToKernel(state, buffers, std::move(pendingWrite._callback));
+        if (!writeResult.has_value()) {
+            return writeResult;
+        }
+    }
+
     while (!state->_pendingWrites.empty()) {
-        PendingWrite& pendingWrite             = state->_pendingWrites.front();
-        const std::span<const uint8_t> payload = pendingWrite._payload;
+        // A staged record is kept as is until SSL_write() accepts it, as OpenSSL requires retries to use the same
+        // buffer.
+        if (state->_stagedWrites == 0) {
+            stagePendingWrites(state);
+        }
+
+        const bool staged                      = state->_stagedWrites > 0;
+        const std::span<const uint8_t> payload = staged ? std::span<const uint8_t> {state->_stagingBuffer}
+                                                        : state->_pendingWrites.front()._payload;
 
         if (payload.empty()) {
-            pendingWrite._callback({});
-            state->_pendingWrites.pop_front();
+            completeWrites(state, staged ? state->_stagedWrites : 1);
             continue;
         }
 
@@ -435,11 +524,15 @@ std::expected<void, uv::Error> SecureSocket::processPendingWrites(std::shared_pt
 
         const size_t bytesWritten = static_cast<size_t>(status);
 
-        if (bytesWritten >= payload.size()) {
-            pendingWrite._callback({});
-            state->_pendingWrites.pop_front();
+        if (staged) {
+            // Without SSL_MODE_ENABLE_PARTIAL_WRITE, SSL_write() always writes the whole buffer.
+            assert(bytesWritten == payload.size());
+            state->_stagingBuffer.clear();
+            completeWrites(state, state->_stagedWrites);
+        } else if (bytesWritten >= payload.size()) {
+            completeWrites(state, 1);
         } else {
-            pendingWrite._payload = payload.subspan(bytesWritten);
+            state->_pendingWrites.front()._payload = payload.subspan(bytesWritten);
         }
     }
 
@@ -456,6 +549,122 @@ std::expected<void, uv::Error> SecureSocket::processPendingWrites(std::shared_pt
     return {};
 }
 
+void SecureSocket::stagePendingWrites(std::shared_ptr<State> state) noexcept
+{
+    assert(state->_stagedWrites == 0 && state->_stagingBuffer.empty());
+
+    for (PendingWrite& pendingWrite: state->_pendingWrites) {
+        const std::span<const uint8_t> payload = pendingWrite._payload;
+
+        // Large writes are directly split into full records by SSL_write(), copying them would be wasteful.
+        if (state->_stagingBuffer.empty() && payload.size() >= maxRecordSize) {
+            break;
+        }
+
+        const size_t stagedSize = std::min(payload.size(), maxRecordSize - state->_stagingBuffer.size());
+        state->_stagingBuffer.insert(state->_stagingBuffer.end(), payload.begin(), payload.begin() + stagedSize);
+
+        if (stagedSize < payload.size()) {
+            // The record is full, the remaining of the write will be part of the next ones.
+            pendingWrite._payload = payload.subspan(stagedSize);
+            break;
+        }
+
+        ++state->_stagedWrites;
+
+        if (state->_stagingBuffer.size() == maxRecordSize) {
+            break;
+        }
+    }
+}
+
+void SecureSocket::completeWrites(std::shared_ptr<State> state, size_t count) noexcept
+{
+    if (state->_stagedWrites > 0) {
+        assert(count == state->_stagedWrites);
+        state->_stagedWrites = 0;
+    }
+
+    // Dequeue the writes before calling their callbacks, as these might synchronously write again and re-enter
+    // processPendingWrites().
+    std::vector<uv::WriteCallback> callbacks;
+    callbacks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        callbacks.push_back(std::move(state->_pendingWrites.front()._callback));
+        state->_pendingWrites.pop_front();
+    }
+
+    for (uv::WriteCallback& callback: callbacks) {
+        callback({});
+    }
+}
+
+void SecureSocket::tryEnableKernelSend(std::shared_ptr<State> state) noexcept
+{
+    if (state->_kernelSend || state->_sendTrafficSecret.empty() ||
+        state->_connectionState != ConnectionState::Established) {
+        return;
+    }
+
+    // The kernel must pick up the record sequence exactly where OpenSSL left it.
+    if (state->_stagedWrites > 0 || BIO_ctrl_pending(state->_writeBIO.get()) > 0 ||
+        state->_transport.writeQueueSize() > 0) {
+        return;  // try again on the next write
+    }
+
+    // Only attempt the offload once, and don't keep the secret around.
+    std::vector<uint8_t> secret = std::move(state->_sendTrafficSecret);
+    state->_sendTrafficSecret.clear();
+
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(state->_ssl.get());
+
+    std::expected<TLS13TrafficKeys, uv::Error> keys = deriveTLS13TrafficKeys(cipher, secret);
+    OPENSSL_cleanse(secret.data(), secret.size());
+    if (!keys.has_value()) {
+        return;
+    }
+
+    std::expected<uv_os_fd_t, uv::Error> fd = state->_transport.fileno();
+    if (!fd.has_value()) {
+        return;
+    }
+
+    // On failure the socket is left untouched, and we keep encrypting in user space.
+    state->_kernelSend = enableKernelTLSSend(fd.value(), cipher, keys.value(), state->_sendRecordSequence).has_value();
+}
+
+std::expected<void, uv::Error> SecureSocket::writeToKernel(
+    std::shared_ptr<State> state,
+    std::span<const std::span<const uint8_t>> buffers,
+    uv::WriteCallback callback) noexcept
+{
+    // Shared so that the synchronous error path can still call it.
+    auto callbackPtr = std::make_shared<uv::WriteCallback>(std::move(callback));
+
+    ++state->_kernelWritesInFlight;
+
+    std::expected<uv::WriteRequest, uv::Error> result =
+        state->_transport.write(buffers, [state, callbackPtr](std::expected<void, uv::Error> writeResult) mutable {
+            --state->_kernelWritesInFlight;
+
+            (*callbackPtr)(std::move(writeResult));
+
+            if (state->_connectionState == ConnectionState::Closing && state->_onShutdownCallback.has_value() &&
+                state->_kernelWritesInFlight == 0) {
+                tryFinishShutdown(state);
+            }
+        });
+
+    if (!result.has_value()) {
+        --state->_kernelWritesInFlight;
+        (*callbackPtr)(std::unexpected {result.error()});
+        failWithError(state, result.error());
+        return std::unexpected {result.error()};
+    }
+
+    return {};
+}
+
 void SecureSocket::failWithError(std::shared_ptr<State> state, uv::Error error) noexcept
 {
     state->_connectionState = ConnectionState::Closed;
@@ -471,6 +680,8 @@ void SecureSocket::failWithError(std::shared_ptr<State> state, uv::Error error)
         pendingWrite._callback(std::unexpected {error});
     }
     state->_pendingWrites.clear();
+    state->_stagingBuffer.clear();
+    state->_stagedWrites = 0;
 
     if (state->_onHandshakeCallback.has_value()) {
         (*state->_onHandshakeCallback)(std::unexpected {error});
@@ -539,6 +750,71 @@ void SecureSocket::onTransportRead(
     }
 }
 
+void SecureSocket::onKeyLog(const SSL* ssl, const char* line) noexcept
+{
+    State* state = static_cast<State*>(SSL_get_app_data(ssl));
+    if (state == nullptr || state->_kernelSend) {
+        return;
+    }
+
+    // NSS key log format: "<label> <client random> <secret>", hex encoded.
+    const std::string_view entry {line};
+    const std::string_view sendLabel = SSL_is_server(ssl) ? "SERVER_TRAFFIC_SECRET_0 " : "CLIENT_TRAFFIC_SECRET_0 ";
+
+    if (!entry.starts_with(sendLabel)) {
+        return;
+    }
+
+    const size_t secretStart = entry.rfind(' ') + 1;
+
+    long secretLength      = 0;
+    unsigned char* secret = OPENSSL_hexstr2buf(line + secretStart, &secretLength);
+    if (secret == nullptr) {
+        return;
+    }
+
+    state->_sendTrafficSecret.assign(secret, secret + secretLength);
+    OPENSSL_clear_free(secret, static_cast<size_t>(secretLength));
+
+    // OpenSSL logs the secret as it starts sending with it, the following records are numbered from 0.
+    state->_sendRecordSequence = 0;
+}
+
+void SecureSocket::onProtocolMessage(
+    int writeP,
+    [[maybe_unused]] int version,
+    int contentType,
+    [[maybe_unused]] const void* buffer,
+    [[maybe_unused]] size_t length,
+    SSL* ssl,
+    [[maybe_unused]] void* arg) noexcept
+{
+    // OpenSSL reports the header of every record it sends.
+    if (writeP == 1 && contentType == SSL3_RT_HEADER) {
+        State* state = static_cast<State*>(SSL_get_app_data(ssl));
+        if (state != nullptr) {
+            ++state->_sendRecordSequence;
+        }
+    }
+}
+
+int SecureSocket::onNewSession(SSL* ssl, SSL_SESSION* session) noexcept
+{
+    const State* state = static_cast<const State*>(SSL_get_app_data(ssl));
+    if (state == nullptr || state->_sessionCacheKey.empty()) {
+        return 0;  // server side, or connected without a cache
+    }
+
+    SessionCache* sessionCache = state->_context.sessionCache();
+    if (sessionCache == nullptr) {
+        return 0;
+    }
+
+    sessionCache->store(state->_sessionCacheKey, SSLPtr<SSL_SESSION> {session});
+
+    return 1;  // we took ownership of the session reference
+}
+
 }  // namespace openssl
 }  // namespace wrapper
 }  // namespace scaler
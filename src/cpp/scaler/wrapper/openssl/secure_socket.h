@@ -10,6 +10,8 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string>
+#include <vector>
 
 #include "scaler/wrapper/openssl/ssl_context.h"
 #include "scaler/wrapper/uv/callback.h"
@@ -74,11 +76,17 @@ public:
 
     bool established() const noexcept;
 
+    // Whether the handshake resumed a previous session, see SSLContext::enableSessionResumption().
+    bool sessionReused() const noexcept;
+
     uv::TCPSocket& transport() noexcept;
 
 private:
     static constexpr size_t defaultDecryptChunkSize = 16 * 1024;
 
+    // The largest TLS record plaintext, see RFC 8446 section 5.1.
+    static constexpr size_t maxRecordSize = SSL3_RT_MAX_PLAIN_LENGTH;
+
     enum class HandshakeMode { Connect, Accept };
 
     struct PendingWrite {
@@ -104,6 +112,25 @@ private:
 
         std::deque<PendingWrite> _pendingWrites {};
 
+        // Small writes are gathered into full records before being encrypted, rather than each becoming its own
+        // record. The first _stagedWrites pending writes are entirely copied into the staging buffer, which might also
+        // hold the beginning of the following one.
+        std::vector<uint8_t> _stagingBuffer {};
+        size_t _stagedWrites {0};
+
+        // Kernel TLS send offload, see SSLContext::enableKernelTLS().
+        //
+        // The sending traffic secret and the number of records OpenSSL sent with it are tracked until the offload is
+        // attempted. Once offloaded, the application data is written to the transport as is, and the kernel encrypts
+        // it.
+        std::vector<uint8_t> _sendTrafficSecret {};
+        uint64_t _sendRecordSequence {0};
+        bool _kernelSend {false};
+        size_t _kernelWritesInFlight {0};
+
+        // The server connected to, under which the session tickets are stored in the context's SessionCache.
+        std::string _sessionCacheKey {};
+
         State(
             SSLContext context,
             uv::TCPSocket transport,
@@ -128,12 +155,39 @@ private:
 
     static std::expected<void, uv::Error> processPendingWrites(std::shared_ptr<State> state) noexcept;
 
+    static std::expected<void, uv::Error> shutdownTransport(std::shared_ptr<State> state) noexcept;
+
+    // Offloads the sending side to the kernel if it's supported, and if all the records encrypted by OpenSSL so far
+    // have been handed to the transport.
+    // Copies the leading small pending writes into the staging buffer, up to a full record.
+    static void stagePendingWrites(std::shared_ptr<State> state) noexcept;
+
+    // Calls the callbacks of the count first pending writes, and removes them.
+    static void completeWrites(std::shared_ptr<State> state, size_t count) noexcept;
+
+    static void tryEnableKernelSend(std::shared_ptr<State> state) noexcept;
+
+    static std::expected<void, uv::Error> writeToKernel(
+        std::shared_ptr<State> state,
+        std::span<const std::span<const uint8_t>> buffers,
+        uv::WriteCallback callback) noexcept;
+
     static void failWithError(std::shared_ptr<State> state, uv::Error error) noexcept;
 
     static void onTransportConnected(std::shared_ptr<State> state, std::expected<void, uv::Error> result) noexcept;
 
     static void onTransportRead(
         std::shared_ptr<State> state, std::expected<std::span<const uint8_t>, uv::Error> result) noexcept;
+
+    // See SSL_CTX_set_keylog_callback, captures the sending traffic secret for the kernel TLS offload.
+    static void onKeyLog(const SSL* ssl, const char* line) noexcept;
+
+    // See SSL_set_msg_callback, counts the records sent for the kernel TLS offload.
+    static void onProtocolMessage(
+        int writeP, int version, int contentType, const void* buffer, size_t length, SSL* ssl, void* arg) noexcept;
+
+    // See SSL_CTX_sess_set_new_cb, stores the session tickets received by client sockets.
+    static int onNewSession(SSL* ssl, SSL_SESSION* session) noexcept;
 };
 
 }  // namespace openssl
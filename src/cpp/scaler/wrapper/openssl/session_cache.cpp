@@ -0,0 +1,35 @@
+#include "scaler/wrapper/openssl/session_cache.h"
+
+#include <utility>
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+void SessionCache::store(const std::string& server, SSLPtr<SSL_SESSION> session) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sessions.insert_or_assign(server, std::move(session));
+}
+
+SSLPtr<SSL_SESSION> SessionCache::lookup(const std::string& server) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _sessions.find(server);
+    if (it == _sessions.end()) {
+        return nullptr;
+    }
+
+    if (SSL_SESSION_is_resumable(it->second.get()) != 1) {
+        _sessions.erase(it);
+        return nullptr;
+    }
+
+    SSL_SESSION_up_ref(it->second.get());
+    return SSLPtr<SSL_SESSION> {it->second.get()};
+}
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
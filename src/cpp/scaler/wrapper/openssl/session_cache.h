@@ -0,0 +1,43 @@
+#pragma once
+
+#include <openssl/ssl.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "scaler/wrapper/openssl/types.h"
+
+namespace scaler {
+namespace wrapper {
+namespace openssl {
+
+// A thread-safe store of the client TLS sessions, by server, used to resume the next connections to that server with
+// an abbreviated handshake.
+//
+// With TLS 1.3, a session is received as a ticket once the handshake completes. The last received ticket is kept, so
+// that connection retries can keep resuming until a new one replaces it.
+class SessionCache {
+public:
+    SessionCache() noexcept = default;
+
+    SessionCache(const SessionCache&)            = delete;
+    SessionCache& operator=(const SessionCache&) = delete;
+
+    SessionCache(SessionCache&&)            = delete;
+    SessionCache& operator=(SessionCache&&) = delete;
+
+    // Replaces the session stored for the server, if any.
+    void store(const std::string& server, SSLPtr<SSL_SESSION> session) noexcept;
+
+    // Returns a new reference to the stored session, or nullptr if there is no resumable session for the server.
+    SSLPtr<SSL_SESSION> lookup(const std::string& server) noexcept;
+
+private:
+    std::mutex _mutex {};
+    std::unordered_map<std::string, SSLPtr<SSL_SESSION>> _sessions {};
+};
+
+}  // namespace openssl
+}  // namespace wrapper
+}  // namespace scaler
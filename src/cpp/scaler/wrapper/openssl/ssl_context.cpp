@@ -42,6 +42,37 @@ std::expected<void, uv::Error> SSLContext::checkPrivateKey() const noexcept
     return {};
 }
 
+void SSLContext::enableKernelTLS() noexcept
+{
+    SSL_CTX_set_options(_context.get(), SSL_OP_ENABLE_KTLS);
+}
+
+bool SSLContext::kernelTLSEnabled() const noexcept
+{
+    return (SSL_CTX_get_options(_context.get()) & SSL_OP_ENABLE_KTLS) != 0;
+}
+
+void SSLContext::enableSessionResumption() noexcept
+{
+    if (_sessionCache != nullptr) {
+        return;
+    }
+
+    _sessionCache = std::make_shared<SessionCache>();
+
+    // Servers resume from stateless tickets, and clients store their sessions in the SessionCache (see
+    // SecureSocket::onNewSession()). OpenSSL's internal cache isn't needed.
+    SSL_CTX_set_session_cache_mode(_context.get(), SSL_SESS_CACHE_BOTH | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+
+    // Clients only keep the last ticket they receive.
+    SSL_CTX_set_num_tickets(_context.get(), 1);
+}
+
+SessionCache* SSLContext::sessionCache() const noexcept
+{
+    return _sessionCache.get();
+}
+
 SSL_CTX* SSLContext::native() const noexcept
 {
     return _context.get();
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include "scaler/wrapper/openssl/session_cache.h"
 #include "scaler/wrapper/openssl/types.h"
 #include "scaler/wrapper/uv/error.h"
 
@@ -30,6 +31,24 @@ public:
     // See SSL_CTX_check_private_key
     std::expected<void, uv::Error> checkPrivateKey() const noexcept;
 
+    // Let the kernel encrypt the data sent by the SecureSockets using this context, once their handshake completes
+    // (kTLS, see SSL_OP_ENABLE_KTLS).
+    //
+    // Only TLS 1.3 sessions using AES-GCM or ChaCha20-Poly1305 are offloaded, on Linux. Sockets on which the kernel
+    // refuses the offload transparently keep encrypting in user space. Received data is always decrypted in user space.
+    void enableKernelTLS() noexcept;
+
+    bool kernelTLSEnabled() const noexcept;
+
+    // Let the client SecureSockets using this context (or its copies made afterwards) resume the TLS session of their
+    // previous connection to the same server, skipping the certificate exchange and key agreement.
+    //
+    // Servers always issue session tickets, and accept them as long as they use the same context.
+    void enableSessionResumption() noexcept;
+
+    // Returns nullptr if session resumption isn't enabled.
+    SessionCache* sessionCache() const noexcept;
+
     // Access the underlying SSL_CTX pointer (non-owning).
     SSL_CTX* native() const noexcept;
 
@@ -37,6 +56,7 @@ private:
     SSLContext(std::shared_ptr<SSL_CTX> context) noexcept;
 
     std::shared_ptr<SSL_CTX> _context;
+    std::shared_ptr<SessionCache> _sessionCache {};
 };
 
 }  // namespace openssl
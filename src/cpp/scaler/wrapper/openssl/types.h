@@ -1,6 +1,7 @@
 #pragma once
 
 #include <openssl/bio.h>
+#include <openssl/kdf.h>
 #include <openssl/ssl.h>
 
 #include <memory>
@@ -35,6 +36,14 @@ struct SSLDeleter<SSL> {
     }
 };
 
+template <>
+struct SSLDeleter<SSL_SESSION> {
+    void operator()(SSL_SESSION* ptr) const noexcept
+    {
+        SSL_SESSION_free(ptr);
+    }
+};
+
 template <>
 struct SSLDeleter<BIO> {
     void operator()(BIO* ptr) const noexcept
@@ -43,6 +52,22 @@ struct SSLDeleter<BIO> {
     }
 };
 
+template <>
+struct SSLDeleter<EVP_KDF> {
+    void operator()(EVP_KDF* ptr) const noexcept
+    {
+        EVP_KDF_free(ptr);
+    }
+};
+
+template <>
+struct SSLDeleter<EVP_KDF_CTX> {
+    void operator()(EVP_KDF_CTX* ptr) const noexcept
+    {
+        EVP_KDF_CTX_free(ptr);
+    }
+};
+
 }  // namespace openssl
 }  // namespace wrapper
 }  // namespace scaler
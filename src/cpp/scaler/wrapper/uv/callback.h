@@ -19,6 +19,14 @@ namespace uv {
 // See uv_async_cb
 using AsyncCallback = scaler::utility::MoveOnlyFunction<void()>;
 
+// See uv_poll_cb
+//
+// Called with the bitmask of the ready events (UV_READABLE, UV_WRITABLE ...).
+using PollCallback = scaler::utility::MoveOnlyFunction<void(std::expected<int, Error> events)>;
+
+// See uv_prepare_cb
+using PrepareCallback = scaler::utility::MoveOnlyFunction<void()>;
+
 // See uv_read_cb
 //
 // The std::span buffer is valid only during the execution of this callback.
@@ -102,6 +102,54 @@ std::expected<std::string, Error> Pipe::getPeerName() const noexcept
     return details::getPeerName(handle().native());
 }
 
+std::expected<WriteRequest, Error> Pipe::write(
+    std::span<const std::span<const uint8_t>> buffers, uv_file sendFile, WriteCallback callback) noexcept
+{
+    uv_loop_t* loop = handle().native().loop;
+
+    // libuv only sends the file descriptors of handles, wrap it in a pipe handle that lives until the write completes.
+    Pipe sendHandle;
+
+    int err = uv_pipe_init(loop, &sendHandle.handle().native(), 0);
+    if (!err) {
+        err = uv_pipe_open(&sendHandle.handle().native(), sendFile);
+    }
+    if (err) {
+        uv_fs_t request;
+        uv_fs_close(loop, &request, sendFile, nullptr);
+        uv_fs_req_cleanup(&request);
+
+        return std::unexpected {Error {err}};
+    }
+
+    uv_stream_t* nativeSendHandle = reinterpret_cast<uv_stream_t*>(&sendHandle.handle().native());
+
+    return write2(
+        buffers,
+        nativeSendHandle,
+        [sendHandle = std::move(sendHandle), callback = std::move(callback)](
+            std::expected<void, Error> result) mutable { callback(std::move(result)); });
+}
+
+std::expected<Pipe, Error> Pipe::acceptPending() noexcept
+{
+    Pipe pending;
+
+    int err = uv_pipe_init(handle().native().loop, &pending.handle().native(), 0);
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    err = uv_accept(
+        reinterpret_cast<uv_stream_t*>(&handle().native()),
+        reinterpret_cast<uv_stream_t*>(&pending.handle().native()));
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return pending;
+}
+
 std::expected<PipeServer, Error> PipeServer::init(Loop& loop, bool ipc) noexcept
 {
     PipeServer server;
@@ -2,7 +2,9 @@
 
 #include <uv.h>
 
+#include <cstdint>
 #include <expected>
+#include <span>
 #include <string>
 
 #include "scaler/wrapper/uv/callback.h"
@@ -31,6 +33,21 @@ public:
     // See uv_pipe_getpeername
     std::expected<std::string, Error> getPeerName() const noexcept;
 
+    using Stream<uv_pipe_t>::write;
+
+    // See uv_write2
+    //
+    // Sends the file descriptor along with the buffers, over a pipe initialized with ipc. Takes the ownership of the
+    // file descriptor, which is closed once the write completes.
+    std::expected<WriteRequest, Error> write(
+        std::span<const std::span<const uint8_t>> buffers, uv_file sendFile, WriteCallback callback) noexcept;
+
+    // See uv_accept
+    //
+    // Accepts the next file descriptor received along with the data read by a pipe initialized with ipc. The returned
+    // handle owns the file descriptor, see fileno(). Fails with UV_EAGAIN if none is pending.
+    std::expected<Pipe, Error> acceptPending() noexcept;
+
 private:
     Pipe() noexcept = default;
 };
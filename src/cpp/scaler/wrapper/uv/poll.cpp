@@ -0,0 +1,58 @@
+#include "scaler/wrapper/uv/poll.h"
+
+#include <cassert>
+
+namespace scaler {
+namespace wrapper {
+namespace uv {
+
+std::expected<Poll, Error> Poll::init(Loop& loop, int fd) noexcept
+{
+    Poll poll;
+
+    const int err = uv_poll_init(&loop.native(), &poll._handle.native(), fd);
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return poll;
+}
+
+std::expected<void, Error> Poll::start(int events, PollCallback callback) noexcept
+{
+    _handle.setData(std::move(callback));
+
+    const int err = uv_poll_start(&_handle.native(), events, &onPollCallback);
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return {};
+}
+
+std::expected<void, Error> Poll::stop() noexcept
+{
+    const int err = uv_poll_stop(&_handle.native());
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return {};
+}
+
+void Poll::onPollCallback(uv_poll_t* poll, int status, int events) noexcept
+{
+    PollCallback* callback = reinterpret_cast<PollCallback*>(uv_handle_get_data(reinterpret_cast<uv_handle_t*>(poll)));
+
+    assert(callback != nullptr);
+
+    if (status < 0) {
+        (*callback)(std::unexpected {Error {status}});
+    } else {
+        (*callback)(events);
+    }
+}
+
+}  // namespace uv
+}  // namespace wrapper
+}  // namespace scaler
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <uv.h>
+
+#include <expected>
+
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/handle.h"
+#include "scaler/wrapper/uv/loop.h"
+
+namespace scaler {
+namespace wrapper {
+namespace uv {
+
+// See uv_poll_t
+class Poll {
+public:
+    // See uv_poll_init
+    //
+    // The file descriptor must remain open until the Poll object is destroyed.
+    static std::expected<Poll, Error> init(Loop& loop, int fd) noexcept;
+
+    // See uv_poll_start
+    std::expected<void, Error> start(int events, PollCallback callback) noexcept;
+
+    // See uv_poll_stop
+    std::expected<void, Error> stop() noexcept;
+
+private:
+    Handle<uv_poll_t, PollCallback> _handle;
+
+    Poll() noexcept = default;
+
+    static void onPollCallback(uv_poll_t* poll, int status, int events) noexcept;
+};
+
+}  // namespace uv
+}  // namespace wrapper
+}  // namespace scaler
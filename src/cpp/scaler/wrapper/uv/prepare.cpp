@@ -0,0 +1,55 @@
+#include "scaler/wrapper/uv/prepare.h"
+
+#include <cassert>
+
+namespace scaler {
+namespace wrapper {
+namespace uv {
+
+std::expected<Prepare, Error> Prepare::init(Loop& loop) noexcept
+{
+    Prepare prepare;
+
+    const int err = uv_prepare_init(&loop.native(), &prepare._handle.native());
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return prepare;
+}
+
+std::expected<void, Error> Prepare::start(PrepareCallback callback) noexcept
+{
+    _handle.setData(std::move(callback));
+
+    const int err = uv_prepare_start(&_handle.native(), &onPrepareCallback);
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return {};
+}
+
+std::expected<void, Error> Prepare::stop() noexcept
+{
+    const int err = uv_prepare_stop(&_handle.native());
+    if (err) {
+        return std::unexpected {Error {err}};
+    }
+
+    return {};
+}
+
+void Prepare::onPrepareCallback(uv_prepare_t* prepare) noexcept
+{
+    PrepareCallback* callback =
+        reinterpret_cast<PrepareCallback*>(uv_handle_get_data(reinterpret_cast<uv_handle_t*>(prepare)));
+
+    assert(callback != nullptr);
+
+    (*callback)();
+}
+
+}  // namespace uv
+}  // namespace wrapper
+}  // namespace scaler
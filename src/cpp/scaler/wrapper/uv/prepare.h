@@ -0,0 +1,38 @@
+#pragma once
+
+#include <uv.h>
+
+#include <expected>
+
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/handle.h"
+#include "scaler/wrapper/uv/loop.h"
+
+namespace scaler {
+namespace wrapper {
+namespace uv {
+
+// See uv_prepare_t
+class Prepare {
+public:
+    // See uv_prepare_init
+    static std::expected<Prepare, Error> init(Loop& loop) noexcept;
+
+    // See uv_prepare_start
+    std::expected<void, Error> start(PrepareCallback callback) noexcept;
+
+    // See uv_prepare_stop
+    std::expected<void, Error> stop() noexcept;
+
+private:
+    Handle<uv_prepare_t, PrepareCallback> _handle;
+
+    Prepare() noexcept = default;
+
+    static void onPrepareCallback(uv_prepare_t* prepare) noexcept;
+};
+
+}  // namespace uv
+}  // namespace wrapper
+}  // namespace scaler
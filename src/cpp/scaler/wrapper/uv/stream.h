@@ -60,6 +60,63 @@ public:
     // responsible for freeing these buffers.
     std::expected<WriteRequest, Error> write(
         std::span<const std::span<const uint8_t>> buffers, WriteCallback callback) noexcept
+    {
+        return write2(buffers, nullptr, std::move(callback));
+    }
+
+    // A single buffer alternative to write().
+    std::expected<WriteRequest, Error> write(std::span<const uint8_t> buffer, WriteCallback callback) noexcept
+    {
+        return write(std::span<std::span<const uint8_t>>(&buffer, 1), std::move(callback));
+    }
+
+    // See uv_shutdown
+    std::expected<ShutdownRequest, Error> shutdown(ShutdownCallback callback) noexcept
+    {
+        ShutdownRequest request([callback = std::move(callback)](int status) mutable {
+            if (status < 0) {
+                callback(std::unexpected {Error {status}});
+            } else {
+                callback({});
+            }
+        });
+
+        const int err = uv_shutdown(
+            &request.native(), reinterpret_cast<uv_stream_t*>(&handle().native()), ShutdownRequest::onCallback);
+
+        if (err) {
+            request.release();
+            return std::unexpected(Error {err});
+        }
+
+        return request;
+    }
+
+    // See uv_stream_get_write_queue_size
+    size_t writeQueueSize() const noexcept
+    {
+        return uv_stream_get_write_queue_size(reinterpret_cast<const uv_stream_t*>(&handle().native()));
+    }
+
+    // See uv_fileno
+    std::expected<uv_os_fd_t, Error> fileno() const noexcept
+    {
+        uv_os_fd_t fd;
+
+        const int err = uv_fileno(reinterpret_cast<const uv_handle_t*>(&handle().native()), &fd);
+        if (err) {
+            return std::unexpected(Error {err});
+        }
+
+        return fd;
+    }
+
+protected:
+    // See uv_write2
+    //
+    // sendHandle is nullptr, or a handle whose file descriptor is sent along with the buffers (ipc pipes only).
+    std::expected<WriteRequest, Error> write2(
+        std::span<const std::span<const uint8_t>> buffers, uv_stream_t* sendHandle, WriteCallback callback) noexcept
     {
         std::vector<uv_buf_t> nativeBuffers {};
         nativeBuffers.reserve(buffers.size());
@@ -82,11 +139,12 @@ public:
             }
         });
 
-        const int err = uv_write(
+        const int err = uv_write2(
             &request.native(),
             reinterpret_cast<uv_stream_t*>(&handle().native()),
             nativeBuffers.data(),
             static_cast<unsigned int>(nativeBuffers.size()),
+            sendHandle,
             &WriteRequest::onCallback);
 
         if (err) {
@@ -97,34 +155,6 @@ public:
         return request;
     }
 
-    // A single buffer alternative to write().
-    std::expected<WriteRequest, Error> write(std::span<const uint8_t> buffer, WriteCallback callback) noexcept
-    {
-        return write(std::span<std::span<const uint8_t>>(&buffer, 1), std::move(callback));
-    }
-
-    // See uv_shutdown
-    std::expected<ShutdownRequest, Error> shutdown(ShutdownCallback callback) noexcept
-    {
-        ShutdownRequest request([callback = std::move(callback)](int status) mutable {
-            if (status < 0) {
-                callback(std::unexpected {Error {status}});
-            } else {
-                callback({});
-            }
-        });
-
-        const int err = uv_shutdown(
-            &request.native(), reinterpret_cast<uv_stream_t*>(&handle().native()), ShutdownRequest::onCallback);
-
-        if (err) {
-            request.release();
-            return std::unexpected(Error {err});
-        }
-
-        return request;
-    }
-
 private:
     Handle<NativeHandleType, ReadCallback> _handle;
 
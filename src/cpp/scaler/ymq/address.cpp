@@ -50,6 +50,11 @@ std::expected<Address::AddressValue, Error> fromIPCString(std::string_view addrP
     return {std::string {addrPart}};
 }
 
+std::expected<Address::AddressValue, Error> fromSHMString(std::string_view addrPart) noexcept
+{
+    return {SharedMemoryAddress {std::string {addrPart}}};
+}
+
 // Parse host:port/path address.
 std::expected<Address::AddressValue, Error> fromWSString(std::string_view addrPart) noexcept
 {
@@ -94,6 +99,19 @@ std::expected<Address::AddressValue, Error> fromWSString(std::string_view addrPa
     };
 }
 
+// Returns std::nullopt on failure.
+std::optional<scaler::wrapper::openssl::SSLContext> createDefaultSSLContext() noexcept
+{
+    auto context = scaler::wrapper::openssl::SSLContext::init();
+    if (!context.has_value()) {
+        return std::nullopt;
+    }
+
+    context->enableSessionResumption();
+
+    return std::move(context.value());
+}
+
 }  // namespace details
 
 Address::Address(AddressValue value, bool secure, std::optional<TLSConfig> tlsConfig) noexcept
@@ -114,6 +132,8 @@ Address::Type Address::type() const noexcept
         return Type::IPC;
     } else if (std::holds_alternative<WebSocketAddress>(_value)) {
         return Type::WebSocket;
+    } else if (std::holds_alternative<SharedMemoryAddress>(_value)) {
+        return Type::SharedMemory;
     } else {
         std::unreachable();
     }
@@ -147,6 +167,12 @@ const WebSocketAddress& Address::asWebSocket() const noexcept
     return std::get<WebSocketAddress>(_value);
 }
 
+const SharedMemoryAddress& Address::asSharedMemory() const noexcept
+{
+    assert(type() == Type::SharedMemory);
+    return std::get<SharedMemoryAddress>(_value);
+}
+
 std::expected<std::string, Error> Address::toString() const noexcept
 {
     switch (type()) {
@@ -165,6 +191,7 @@ std::expected<std::string, Error> Address::toString() const noexcept
             const std::string_view prefix = _secure ? _wssPrefix : _wsPrefix;
             return std::string(prefix) + ws.host + ":" + std::to_string(ws.port) + ws.path;
         }
+        case Type::SharedMemory: return std::string {_shmPrefix} + asSharedMemory().path;
         default: std::unreachable();
     };
 }
@@ -179,12 +206,13 @@ std::expected<Address, Error> Address::fromString(std::string_view address, std:
         bool secure;
     };
 
-    static constexpr std::array<PrefixEntry, 5> prefixParsers {{
+    static constexpr std::array<PrefixEntry, 6> prefixParsers {{
         {_tcpPrefix, details::fromTCPString, false},
         {_tlsPrefix, details::fromTCPString, true},
         {_ipcPrefix, details::fromIPCString, false},
         {_wsPrefix, details::fromWSString, false},
         {_wssPrefix, details::fromWSString, true},
+        {_shmPrefix, details::fromSHMString, false},
     }};
 
     for (const PrefixEntry& entry: prefixParsers) {
@@ -199,7 +227,7 @@ std::expected<Address, Error> Address::fromString(std::string_view address, std:
 
     return std::unexpected {Error {
         Error::ErrorCode::InvalidAddressFormat,
-        "Address must start with 'tcp://', 'tls://', 'ipc://', 'ws://', or 'wss://'"}};
+        "Address must start with 'tcp://', 'tls://', 'ipc://', 'ws://', 'wss://', or 'shm://'"}};
 }
 
 std::expected<std::optional<scaler::wrapper::openssl::SSLContext>, Error> Address::getSSLContext() const noexcept
@@ -216,12 +244,14 @@ std::expected<std::optional<scaler::wrapper::openssl::SSLContext>, Error> Addres
         return std::move(context.value());
     }
 
-    // No TLS config provided, use default SSL context.
-    auto context = scaler::wrapper::openssl::SSLContext::init();
-    if (!context.has_value()) {
+    // No TLS config provided, use the default SSL context, shared by all the connections.
+    static const std::optional<scaler::wrapper::openssl::SSLContext> defaultContext =
+        details::createDefaultSSLContext();
+
+    if (!defaultContext.has_value()) {
         return std::unexpected {Error {Error::ErrorCode::SysCallError, "SSLContext::init() failed"}};
     }
-    return std::move(context.value());
+    return defaultContext.value();
 }
 
 }  // namespace ymq
@@ -23,15 +23,23 @@ struct WebSocketAddress {
     std::string path;                               // request path, always starts with '/'
 };
 
-// A socket address, can either be a SocketAddress (IPv4/6), an IPC path, or a WebSocket address.
+// Parsed representation of a shm:// address.
+struct SharedMemoryAddress {
+    std::string path;  // the IPC socket the shared memory segments are negotiated on
+};
+
+// A socket address, can either be a SocketAddress (IPv4/6), an IPC path, a WebSocket address, or a shared memory
+// address.
 class Address {
 public:
-    using AddressValue = std::variant<scaler::wrapper::uv::SocketAddress, std::string, WebSocketAddress>;
+    using AddressValue =
+        std::variant<scaler::wrapper::uv::SocketAddress, std::string, WebSocketAddress, SharedMemoryAddress>;
 
     enum class Type {
         IPC,
         TCP,
         WebSocket,
+        SharedMemory,
     };
 
     Address(AddressValue value, bool secure = false, std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
@@ -57,6 +65,8 @@ public:
 
     const WebSocketAddress& asWebSocket() const noexcept;
 
+    const SharedMemoryAddress& asSharedMemory() const noexcept;
+
     std::expected<std::string, Error> toString() const noexcept;
 
     // Try to parse a string to an Address instance.
@@ -69,6 +79,7 @@ public:
     //     tcp://2001:db8::1:1211
     //     ws://127.0.0.1:8765/
     //     wss://example.com:443/ymq
+    //     shm:///tmp/some_ipc_socket_name
     //
     static std::expected<Address, Error> fromString(
         std::string_view address, std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
@@ -84,6 +95,7 @@ private:
     static constexpr std::string_view _ipcPrefix = "ipc://";
     static constexpr std::string_view _wsPrefix  = "ws://";
     static constexpr std::string_view _wssPrefix = "wss://";
+    static constexpr std::string_view _shmPrefix = "shm://";
 
     AddressValue _value;
 
@@ -1,20 +1,46 @@
 #include "scaler/ymq/binder_socket.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <functional>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "scaler/ymq/buffered_bytes.h"
 #include "scaler/ymq/configuration.h"
+#include "scaler/ymq/shared_bytes.h"
 
 namespace scaler {
 namespace ymq {
 
-BinderSocket::BinderSocket(IOContext& context, Identity identity) noexcept
+BinderSocket::BinderSocket(
+    IOContext& context,
+    Identity identity,
+    size_t numThreads,
+    SendQueueLimits connectionSendQueueLimits,
+    SendQueueLimits socketSendQueueLimits) noexcept
 {
-    internal::EventLoopThread& thread = context.nextThread();
-    _state                            = std::make_shared<State>(thread, std::move(identity));
+    // IOContext::nextThread() is round-robin, the next calls return distinct threads as long as numThreads does not
+    // exceed the size of the pool.
+    numThreads = std::clamp(numThreads, size_t {1}, context.numThreads());
+
+    std::vector<internal::EventLoopThread*> threads {};
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.push_back(&context.nextThread());
+    }
+
+    // The IOContext stores its threads contiguously and destroys them in reverse order, pick the last created as the
+    // primary thread.
+    std::ranges::sort(threads, std::greater<> {});
+
+    _state = std::make_shared<State>(
+        *threads.front(), std::move(identity), connectionSendQueueLimits, socketSendQueueLimits);
+    for (size_t i = 0; i < threads.size(); ++i) {
+        _state->_shards.push_back(std::make_unique<Shard>(*threads[i], i));
+    }
 }
 
 BinderSocket::~BinderSocket() noexcept
@@ -30,32 +56,39 @@ void BinderSocket::shutdown(ShutdownCallback onShutdownCallback) noexcept
     }
 
     _state->_thread.executeThreadSafe([state = _state, onShutdownCallback = std::move(onShutdownCallback)]() mutable {
-        // Disconnect all servers
-        state->_servers.clear();
+        {
+            std::lock_guard<std::mutex> lock(state->_stoppedMutex);
+            state->_stopped = true;
+        }
 
-        // Disconnect all connections
-        state->_connections.clear();
         state->_identityToConnectionID.clear();
 
         // Fail all pending receive callbacks
-        while (!state->_pendingRecvCallbacks.empty()) {
-            auto callback = std::move(state->_pendingRecvCallbacks.front());
-            state->_pendingRecvCallbacks.pop();
-            callback(std::unexpected {Error {Error::ErrorCode::SocketStopRequested}});
-        }
+        state->_recvQueue.failPendingRecvs(Error {Error::ErrorCode::SocketStopRequested});
 
         // Fail all pending send callbacks
         for (auto& [_, pendingMessages]: state->_pendingSendMessages) {
-            for (auto& pendingMessage: pendingMessages) {
+            for (auto& pendingMessage: pendingMessages.messages) {
                 pendingMessage.onMessageSent(
                     std::unexpected {Error {Error::ErrorCode::SocketStopRequested}},
                     std::move(pendingMessage.messagePayload));
             }
         }
         state->_pendingSendMessages.clear();
-        state->_pendingRecvMessages = {};
+        state->_recvQueue.clearPendingMessages();
 
-        onShutdownCallback();
+        // Disconnect all servers and connections, on their own threads.
+        //
+        // The primary shard must be cleared immediately: the IOContext might stop the thread right after this callback.
+        auto clearShard = [](Shard& shard) {
+            shard._servers.clear();
+            shard._identityIndex.clear();
+            shard._connections.clear();
+        };
+
+        clearShard(*state->_shards.front());
+
+        executeOnShards(state, 1, std::move(clearShard), std::move(onShutdownCallback));
     });
 
     _state = nullptr;
@@ -66,6 +99,16 @@ const Identity& BinderSocket::identity() const noexcept
     return _state->_identity;
 }
 
+size_t BinderSocket::numThreads() const noexcept
+{
+    return _state->_shards.size();
+}
+
+SendQueueDepth BinderSocket::sendQueueDepth() const noexcept
+{
+    return _state->_sendQueueCounter->depth();
+}
+
 void BinderSocket::bindTo(std::string address, BindCallback onBindCallback, std::optional<TLSConfig> tlsConfig) noexcept
 {
     _state->_thread.executeThreadSafe([state     = _state,
@@ -78,28 +121,88 @@ void BinderSocket::bindTo(std::string address, BindCallback onBindCallback, std:
             return;
         }
 
+        Shard& primaryShard = *state->_shards.front();
+
+        // Unix domain sockets (also used by shm://) cannot be shared between listeners, these are only served by the
+        // primary shard.
+        bool shareAddress = state->_shards.size() > 1 && parsedAddress->type() != Address::Type::IPC &&
+                            parsedAddress->type() != Address::Type::SharedMemory;
+
         auto server = internal::AcceptServer::init(
-            state->_thread.loop(), parsedAddress.value(), std::bind_front(&BinderSocket::onClientConnect, state));
+            state->_thread.loop(),
+            parsedAddress.value(),
+            std::bind_front(&BinderSocket::onClientConnect, state, primaryShard._index),
+            shareAddress);
+        if (!server.has_value() && shareAddress) {
+            // SO_REUSEPORT load balancing might not be supported by the platform, fallback on a single listener.
+            state->_logger.log(
+                Logger::LoggingLevel::warning,
+                "Failed to bind ",
+                address,
+                " to multiple threads, connections will be handled by a single thread: ",
+                server.error().what());
+
+            shareAddress = false;
+            server       = internal::AcceptServer::init(
+                state->_thread.loop(),
+                parsedAddress.value(),
+                std::bind_front(&BinderSocket::onClientConnect, state, primaryShard._index));
+        }
         if (!server.has_value()) {
             callback(std::unexpected {std::move(server.error())});
             return;
         }
 
-        state->_servers.push_back(std::move(server.value()));
+        primaryShard._servers.push_back(std::move(server.value()));
 
         // Get the actual bound address (useful when binding to port 0)
-        Address boundAddress = state->_servers.back().address();
-        callback(boundAddress);
+        Address boundAddress = primaryShard._servers.back().address();
+
+        if (!shareAddress) {
+            callback(boundAddress);
+            return;
+        }
+
+        // Make the other shards listen on the same address, and only report the bound address once all of them do.
+        Address shardAddress {boundAddress.value(), parsedAddress->secure(), parsedAddress->tlsConfig()};
+
+        executeOnShards(
+            state,
+            1,
+            [state, shardAddress](Shard& shard) { bindShard(state, shard, shardAddress); },
+            [callback = std::move(callback), boundAddress = std::move(boundAddress)]() mutable {
+                callback(std::move(boundAddress));
+            });
     });
 }
 
 void BinderSocket::sendMessage(
-    Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept
+    Identity remoteIdentity,
+    std::unique_ptr<Bytes> messagePayload,
+    SendMessageCallback onMessageSent,
+    MessagePriority priority) noexcept
 {
     _state->_thread.executeThreadSafe([state          = _state,
                                        remoteIdentity = std::move(remoteIdentity),
                                        messagePayload = std::move(messagePayload),
-                                       callback       = std::move(onMessageSent)]() mutable {
+                                       callback       = std::move(onMessageSent),
+                                       priority]() mutable {
+        const size_t messageSize = messagePayload->size();
+
+        if (!reserveSendQueue(*state, remoteIdentity, messageSize)) {
+            callback(std::unexpected {Error {Error::ErrorCode::SendQueueFull}}, std::move(messagePayload));
+            return;
+        }
+
+        state->_sendQueueCounter->add(messageSize);
+
+        SendMessageCallback onMessageSent =
+            [counter = state->_sendQueueCounter, messageSize, callback = std::move(callback)](
+                std::expected<void, Error> result, std::unique_ptr<Bytes> payload) mutable {
+                counter->remove(messageSize);
+                callback(std::move(result), std::move(payload));
+            };
+
         auto it = state->_identityToConnectionID.find(remoteIdentity);
         if (it == state->_identityToConnectionID.end()) {
             // The peer is not currently connected.
@@ -109,57 +212,54 @@ void BinderSocket::sendMessage(
             // is a send-before-first-connect case (used by some tests and the warm-up path);
             // queue until the peer eventually identifies itself.
             if (state->_disconnectedIdentities.count(remoteIdentity) > 0) {
-                callback(
+                onMessageSent(
                     std::unexpected {Error {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd}},
                     std::move(messagePayload));
                 return;
             }
 
-            state->_pendingSendMessages[remoteIdentity].emplace_back(
-                PendingSendMessage {std::move(messagePayload), std::move(callback)});
+            PendingSendQueue& pending = state->_pendingSendMessages[remoteIdentity];
+            pending.depth.messages += 1;
+            pending.depth.bytes += messageSize;
+            pending.messages.emplace_back(
+                PendingSendMessage {std::move(messagePayload), std::move(onMessageSent), priority});
             return;
         }
 
-        internal::MessageConnection& connection = *state->_connections.at(it->second);
-        connection.sendMessage(std::move(messagePayload), std::move(callback));
+        sendOnConnection(state, it->second, std::move(messagePayload), std::move(onMessageSent), priority);
     });
 }
 
 void BinderSocket::sendMulticastMessage(
     std::unique_ptr<Bytes> messagePayload, std::optional<Identity> remotePrefix) noexcept
 {
-    _state->_thread.executeThreadSafe(
-        [state = _state, messagePayload = std::move(messagePayload), remotePrefix = std::move(remotePrefix)]() mutable {
-            for (const auto& [_, connectionPtr]: state->_connections) {
-                if (remotePrefix.has_value()) {
-                    const std::optional<Identity>& remoteIdentity = connectionPtr->remoteIdentity();
-                    if (!remoteIdentity.has_value() || !remoteIdentity->starts_with(remotePrefix.value())) {
-                        continue;
-                    }
-                }
-
-                connectionPtr->sendMessage(
-                    std::make_unique<BufferedBytes>(
-                        reinterpret_cast<const char*>(messagePayload->data()), messagePayload->size()),
-                    []([[maybe_unused]] std::expected<void, Error> result,
-                       [[maybe_unused]] std::unique_ptr<Bytes>) noexcept {});
-            }
-        });
+    _state->_thread.executeThreadSafe([state          = _state,
+                                       messagePayload = std::shared_ptr<const Bytes>(std::move(messagePayload)),
+                                       remotePrefix   = std::move(remotePrefix)]() mutable {
+        // All the connections of all the shards share the same payload buffer, which is released after the last write.
+        auto multicast = [messagePayload, remotePrefix](Shard& shard) {
+            multicastOnShard(shard, messagePayload, remotePrefix);
+        };
+
+        multicast(*state->_shards.front());
+
+        if (state->_shards.size() > 1) {
+            executeOnShards(state, 1, std::move(multicast), []() {});
+        }
+    });
 }
 
 void BinderSocket::recvMessage(RecvMessageCallback onRecvMessage) noexcept
 {
     _state->_thread.executeThreadSafe([state = _state, onRecvMessage = std::move(onRecvMessage)]() mutable {
-        if (!state->_pendingRecvMessages.empty()) {
-            // There is a message ready, call the callback immediately
-            Message message = std::move(state->_pendingRecvMessages.front());
-            state->_pendingRecvMessages.pop();
-            onRecvMessage(std::move(message));
-            return;
-        }
+        state->_recvQueue.recvMessage(std::move(onRecvMessage));
+    });
+}
 
-        // No messages are pending, queue the callback until a message arrives
-        state->_pendingRecvCallbacks.push(std::move(onRecvMessage));
+void BinderSocket::recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept
+{
+    _state->_thread.executeThreadSafe([state = _state, maxCount, onRecvMessages = std::move(onRecvMessages)]() mutable {
+        state->_recvQueue.recvMessages(maxCount, std::move(onRecvMessages));
     });
 }
 
@@ -173,24 +273,289 @@ void BinderSocket::closeConnection(Identity remoteIdentity) noexcept
         }
         ConnectionID connectionID = it->second;
 
-        // Reuse the disconnect path: it extracts the connection from _connections, erases the
-        // identity mapping, populates _disconnectedIdentities, and drains _pendingSendMessages.
-        onRemoteDisconnect(std::move(state), connectionID, internal::MessageConnection::DisconnectReason::Disconnected);
+        destroyConnection(state, connectionID);
+
+        // Reuse the disconnect path: it erases the identity mapping, populates _disconnectedIdentities, and drains
+        // _pendingSendMessages.
+        onRemoteDisconnect(
+            std::move(state),
+            connectionID,
+            std::move(remoteIdentity),
+            internal::MessageConnection::DisconnectReason::Disconnected);
     });
 }
 
-void BinderSocket::onClientConnect(std::shared_ptr<State> state, internal::Client client) noexcept
+size_t BinderSocket::shardIndex(ConnectionID connectionId) noexcept
 {
-    internal::MessageConnection& connection = createConnection(state, std::nullopt);
+    return static_cast<size_t>(connectionId >> connectionShardShift);
+}
+
+void BinderSocket::executeOnPrimary(
+    State& state, const Shard& shard, internal::EventLoopThread::Callback callback) noexcept
+{
+    if (&shard._thread == &state._thread) {
+        callback();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state._stoppedMutex);
+    if (state._stopped) {
+        return;
+    }
+
+    state._thread.executeThreadSafe(std::move(callback));
+}
+
+void BinderSocket::executeOnConnectionShard(
+    State& state, ConnectionID connectionId, internal::EventLoopThread::Callback callback) noexcept
+{
+    Shard& shard = *state._shards.at(shardIndex(connectionId));
+
+    if (&shard._thread == &state._thread) {
+        callback();
+        return;
+    }
+
+    shard._thread.executeThreadSafe(std::move(callback));
+}
+
+void BinderSocket::executeOnShards(
+    std::shared_ptr<State> state,
+    size_t firstShard,
+    ShardCallback callback,
+    internal::EventLoopThread::Callback onDone) noexcept
+{
+    struct Completion {
+        std::atomic<size_t> remaining;
+        internal::EventLoopThread::Callback onDone;
+    };
+
+    auto completion = std::make_shared<Completion>(state->_shards.size() - firstShard, std::move(onDone));
+    if (completion->remaining == 0) {
+        completion->onDone();
+        return;
+    }
+
+    auto sharedCallback = std::make_shared<ShardCallback>(std::move(callback));
+
+    for (size_t i = firstShard; i < state->_shards.size(); ++i) {
+        Shard& shard = *state->_shards[i];
+        // Capturing the state keeps the shard alive.
+        shard._thread.executeThreadSafe([state, &shard, sharedCallback, completion]() {
+            (*sharedCallback)(shard);
+
+            // Do not post back to the primary thread, as it might already be stopped when shutting down.
+            if (completion->remaining.fetch_sub(1) == 1) {
+                completion->onDone();
+            }
+        });
+    }
+}
+
+void BinderSocket::bindShard(std::shared_ptr<State> state, Shard& shard, const Address& address) noexcept
+{
+    auto server = internal::AcceptServer::init(
+        shard._thread.loop(), address, std::bind_front(&BinderSocket::onClientConnect, state, shard._index), true);
+    if (!server.has_value()) {
+        // Not fatal, the primary shard is already listening on this address.
+        state->_logger.log(
+            Logger::LoggingLevel::warning,
+            "Failed to bind thread ",
+            shard._index,
+            " of the binder socket: ",
+            server.error().what());
+        return;
+    }
+
+    shard._servers.push_back(std::move(server.value()));
+}
+
+void BinderSocket::sendOnConnection(
+    std::shared_ptr<State> state,
+    ConnectionID connectionId,
+    std::unique_ptr<Bytes> messagePayload,
+    SendMessageCallback onMessageSent,
+    MessagePriority priority) noexcept
+{
+    Shard& shard = *state->_shards.at(shardIndex(connectionId));
+
+    executeOnConnectionShard(
+        *state,
+        connectionId,
+        [&shard,
+         connectionId,
+         messagePayload = std::move(messagePayload),
+         onMessageSent  = std::move(onMessageSent),
+         priority]() mutable {
+            auto it = shard._connections.find(connectionId);
+            if (it == shard._connections.end()) {
+                // The connection got destroyed while the message was being forwarded to its thread.
+                onMessageSent(
+                    std::unexpected {Error {Error::ErrorCode::SocketStopRequested}}, std::move(messagePayload));
+                return;
+            }
+
+            it->second->sendMessage(std::move(messagePayload), std::move(onMessageSent), priority);
+        });
+}
+
+bool BinderSocket::reserveSendQueue(State& state, const Identity& remoteIdentity, size_t messageSize) noexcept
+{
+    auto pendingIt = state._pendingSendMessages.find(remoteIdentity);
+
+    while (true) {
+        const bool socketFull = state._socketSendQueueLimits.exceeded(state._sendQueueCounter->depth(), messageSize);
+
+        // The limits of connected identities are checked by their MessageConnection.
+        const bool identityFull = pendingIt != state._pendingSendMessages.end() &&
+                                  state._connectionSendQueueLimits.exceeded(pendingIt->second.depth, messageSize);
+
+        if (!socketFull && !identityFull) {
+            return true;
+        }
+
+        const bool canDrop =
+            (!socketFull || state._socketSendQueueLimits.policy == SendQueueFullPolicy::DropOldest) &&
+            (!identityFull || state._connectionSendQueueLimits.policy == SendQueueFullPolicy::DropOldest);
+
+        // Only the messages pending for the same identity can be dropped.
+        if (!canDrop || pendingIt == state._pendingSendMessages.end() || pendingIt->second.messages.empty()) {
+            return false;
+        }
+
+        PendingSendQueue& pending = pendingIt->second;
+
+        PendingSendMessage dropped = std::move(pending.messages.front());
+        pending.messages.pop_front();
+        pending.depth.messages -= 1;
+        pending.depth.bytes -= dropped.messagePayload->size();
+
+        dropped.onMessageSent(
+            std::unexpected {Error {Error::ErrorCode::SendQueueFull}}, std::move(dropped.messagePayload));
+    }
+}
+
+void BinderSocket::destroyConnection(std::shared_ptr<State> state, ConnectionID connectionId) noexcept
+{
+    Shard& shard = *state->_shards.at(shardIndex(connectionId));
+
+    executeOnConnectionShard(
+        *state, connectionId, [&shard, connectionId]() { extractConnection(shard, connectionId); });
+}
+
+std::unique_ptr<internal::MessageConnection> BinderSocket::extractConnection(
+    Shard& shard, ConnectionID connectionId) noexcept
+{
+    auto node = shard._connections.extract(connectionId);
+    if (node.empty()) {
+        return nullptr;
+    }
+
+    const std::optional<Identity>& remoteIdentity = node.mapped()->remoteIdentity();
+    if (remoteIdentity.has_value()) {
+        shard._identityIndex.erase({remoteIdentity.value(), connectionId});
+    }
+
+    return std::move(node.mapped());
+}
+
+void BinderSocket::multicastOnShard(
+    Shard& shard, std::shared_ptr<const Bytes> messagePayload, const std::optional<Identity>& remotePrefix) noexcept
+{
+    // Collect the recipients first, as sending might synchronously destroy a connection.
+    std::vector<ConnectionID> recipients {};
+
+    if (remotePrefix.has_value()) {
+        // The identities starting with the prefix are contiguous in the sorted index.
+        auto it = shard._identityIndex.lower_bound({remotePrefix.value(), ConnectionID {0}});
+        for (; it != shard._identityIndex.end() && it->first.starts_with(remotePrefix.value()); ++it) {
+            recipients.push_back(it->second);
+        }
+    } else {
+        recipients.reserve(shard._connections.size());
+        for (const auto& [connectionId, _]: shard._connections) {
+            recipients.push_back(connectionId);
+        }
+    }
+
+    for (ConnectionID connectionId: recipients) {
+        auto it = shard._connections.find(connectionId);
+        if (it == shard._connections.end()) {
+            continue;
+        }
+
+        it->second->sendMessage(
+            std::make_unique<SharedBytes>(messagePayload),
+            []([[maybe_unused]] std::expected<void, Error> result,
+               [[maybe_unused]] std::unique_ptr<Bytes>) noexcept {});
+    }
+}
+
+void BinderSocket::onClientConnect(std::shared_ptr<State> state, size_t shardIndex, internal::Client client) noexcept
+{
+    Shard& shard = *state->_shards.at(shardIndex);
+
+    if (internal::IOUring* ioUring = shard._thread.ioUring()) {
+        client.useIOUring(*ioUring);
+    }
+
+    internal::MessageConnection& connection = createConnection(state, shard, std::nullopt);
     connection.connect(std::move(client));
 }
 
+void BinderSocket::onConnectionIdentity(
+    std::shared_ptr<State> state, ConnectionID connectionId, Identity remoteIdentity) noexcept
+{
+    Shard& shard = *state->_shards.at(shardIndex(connectionId));
+
+    shard._identityIndex.emplace(remoteIdentity, connectionId);
+
+    executeOnPrimary(*state, shard, [state, connectionId, remoteIdentity = std::move(remoteIdentity)]() mutable {
+        onRemoteIdentity(std::move(state), connectionId, std::move(remoteIdentity));
+    });
+}
+
+void BinderSocket::onConnectionDisconnect(
+    std::shared_ptr<State> state,
+    ConnectionID connectionId,
+    internal::MessageConnection::DisconnectReason reason) noexcept
+{
+    Shard& shard = *state->_shards.at(shardIndex(connectionId));
+
+    std::unique_ptr<internal::MessageConnection> connection = extractConnection(shard, connectionId);
+    assert(connection != nullptr);
+
+    std::optional<Identity> remoteIdentity = connection->remoteIdentity();
+
+    executeOnPrimary(
+        *state, shard, [state, connectionId, remoteIdentity = std::move(remoteIdentity), reason]() mutable {
+            onRemoteDisconnect(std::move(state), connectionId, std::move(remoteIdentity), reason);
+        });
+}
+
+void BinderSocket::onConnectionMessage(
+    std::shared_ptr<State> state, ConnectionID connectionId, std::unique_ptr<Bytes> messagePayload) noexcept
+{
+    const Shard& shard = *state->_shards.at(shardIndex(connectionId));
+
+    internal::MessageConnection& connection = *shard._connections.at(connectionId);
+    assert(connection.remoteIdentity().has_value());
+
+    Message message;
+    message.address = std::make_unique<BufferedBytes>(connection.remoteIdentity().value());
+    message.payload = std::move(messagePayload);
+
+    executeOnPrimary(*state, shard, [state, message = std::move(message)]() mutable {
+        onMessage(std::move(state), std::move(message));
+    });
+}
+
 void BinderSocket::onRemoteIdentity(
     std::shared_ptr<State> state, ConnectionID connectionId, Identity remoteIdentity) noexcept
 {
     if (state->_identityToConnectionID.contains(remoteIdentity)) {
         // Another connection already established to this remote. Disconnect and destroy the old one.
-        state->_connections.erase(state->_identityToConnectionID[remoteIdentity]);
+        destroyConnection(state, state->_identityToConnectionID[remoteIdentity]);
     }
 
     state->_identityToConnectionID[remoteIdentity] = connectionId;
@@ -199,9 +564,13 @@ void BinderSocket::onRemoteIdentity(
     // Send any pending messages previously queued for this identity
     auto pendingIt = state->_pendingSendMessages.find(remoteIdentity);
     if (pendingIt != state->_pendingSendMessages.end()) {
-        internal::MessageConnection& connection = *state->_connections.at(connectionId);
-        for (auto& pending: pendingIt->second) {
-            connection.sendMessage(std::move(pending.messagePayload), std::move(pending.onMessageSent));
+        for (auto& pending: pendingIt->second.messages) {
+            sendOnConnection(
+                state,
+                connectionId,
+                std::move(pending.messagePayload),
+                std::move(pending.onMessageSent),
+                pending.priority);
         }
         state->_pendingSendMessages.erase(pendingIt);
     }
@@ -210,18 +579,20 @@ void BinderSocket::onRemoteIdentity(
 void BinderSocket::onRemoteDisconnect(
     std::shared_ptr<State> state,
     ConnectionID connectionId,
+    std::optional<Identity> remoteIdentity,
     [[maybe_unused]] internal::MessageConnection::DisconnectReason reason) noexcept
 {
-    auto node = state->_connections.extract(connectionId);
-    assert(!node.empty());
+    if (!remoteIdentity) {
+        return;
+    }
 
-    internal::MessageConnection& connection = *node.mapped();
-    if (!connection.remoteIdentity()) {
+    auto it = state->_identityToConnectionID.find(remoteIdentity.value());
+    if (it == state->_identityToConnectionID.end() || it->second != connectionId) {
+        // The connection has already been replaced or closed while this event was forwarded from its shard.
         return;
     }
 
-    const Identity& remoteIdentity = connection.remoteIdentity().value();
-    state->_identityToConnectionID.erase(remoteIdentity);
+    state->_identityToConnectionID.erase(it);
 
     // For an aborted disconnect we expect the remote to reconnect, so keep _pendingSendMessages
     // intact - onRemoteIdentity will drain them onto the new MessageConnection. Only graceful
@@ -237,14 +608,14 @@ void BinderSocket::onRemoteDisconnect(
     // even under workloads that churn many short-lived peers (e.g. nested-task clients).
     const auto now = std::chrono::steady_clock::now();
     purgeExpiredDisconnectedIdentities(*state, now);
-    state->_disconnectedIdentities[remoteIdentity] = now;
-    state->_disconnectedIdentityInsertions.emplace_back(now, remoteIdentity);
+    state->_disconnectedIdentities[remoteIdentity.value()] = now;
+    state->_disconnectedIdentityInsertions.emplace_back(now, remoteIdentity.value());
 
     // Drain any sends already queued for this identity (rare: covers the case where Python
     // raced ahead of the disconnect).
-    auto pendingIt = state->_pendingSendMessages.find(remoteIdentity);
+    auto pendingIt = state->_pendingSendMessages.find(remoteIdentity.value());
     if (pendingIt != state->_pendingSendMessages.end()) {
-        for (auto& pending: pendingIt->second) {
+        for (auto& pending: pendingIt->second.messages) {
             pending.onMessageSent(
                 std::unexpected {Error {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd}},
                 std::move(pending.messagePayload));
@@ -253,40 +624,27 @@ void BinderSocket::onRemoteDisconnect(
     }
 }
 
-void BinderSocket::onMessage(
-    std::shared_ptr<State> state, ConnectionID connectionId, std::unique_ptr<Bytes> messagePayload) noexcept
+void BinderSocket::onMessage(std::shared_ptr<State> state, Message message) noexcept
 {
-    internal::MessageConnection& connection = *state->_connections.at(connectionId);
-    assert(connection.remoteIdentity().has_value());
-
-    Message message;
-    message.address = std::make_unique<BufferedBytes>(connection.remoteIdentity().value());
-    message.payload = std::move(messagePayload);
-
-    if (state->_pendingRecvCallbacks.empty()) {
-        // No callback waiting, buffer the message until the user calls recvMessage()
-        state->_pendingRecvMessages.push(std::move(message));
-        return;
-    }
-
-    RecvMessageCallback callback = std::move(state->_pendingRecvCallbacks.front());
-    state->_pendingRecvCallbacks.pop();
-    callback(std::move(message));
+    state->_recvQueue.onMessage(std::move(message));
 }
 
 internal::MessageConnection& BinderSocket::createConnection(
-    std::shared_ptr<State> state, std::optional<Identity> remoteIdentity) noexcept
+    std::shared_ptr<State> state, Shard& shard, std::optional<Identity> remoteIdentity) noexcept
 {
-    ConnectionID connectionId = state->_connectionCounter++;
+    ConnectionID connectionId = (static_cast<ConnectionID>(shard._index) << connectionShardShift) |
+                                shard._connectionCounter++;
 
     auto connection = std::make_unique<internal::MessageConnection>(
         state->_identity,
         remoteIdentity,
-        std::bind_front(&BinderSocket::onRemoteIdentity, state, connectionId),
-        std::bind_front(&BinderSocket::onRemoteDisconnect, state, connectionId),
-        std::bind_front(&BinderSocket::onMessage, state, connectionId));
+        std::bind_front(&BinderSocket::onConnectionIdentity, state, connectionId),
+        std::bind_front(&BinderSocket::onConnectionDisconnect, state, connectionId),
+        std::bind_front(&BinderSocket::onConnectionMessage, state, connectionId));
+
+    connection->setSendQueueLimits(state->_connectionSendQueueLimits);
 
-    auto [it, inserted] = state->_connections.emplace(connectionId, std::move(connection));
+    auto [it, inserted] = shard._connections.emplace(connectionId, std::move(connection));
 
     return *it->second;
 }
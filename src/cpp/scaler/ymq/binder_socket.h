@@ -4,22 +4,29 @@
 #include <cstdint>
 #include <deque>
 #include <expected>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <queue>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "scaler/error/error.h"
+#include "scaler/logging/logging.h"
 #include "scaler/utility/move_only_function.h"
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/internal/accept_server.h"
 #include "scaler/ymq/internal/event_loop_thread.h"
 #include "scaler/ymq/internal/message_connection.h"
+#include "scaler/ymq/internal/recv_queue.h"
+#include "scaler/ymq/internal/send_queue_counter.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/typedefs.h"
 
 namespace scaler {
@@ -28,6 +35,12 @@ namespace ymq {
 // A socket that binds to a local address and accepts messages from multiple remote peers.
 //
 // Thread-safe: all operations are scheduled onto the socket's event loop thread.
+//
+// When created with more than one thread, the accepted connections are distributed across several of the IOContext's
+// threads (shards). Every shard listens on the bound TCP/WebSocket addresses using SO_REUSEPORT, letting the kernel
+// balance incoming connections between them. The connections' framing and I/O then run on their shard's thread, while
+// the identity routing and the received messages are kept on the socket's primary thread. Send callbacks are called
+// from the thread owning the connection.
 class BinderSocket {
 public:
     using ShutdownCallback = scaler::utility::MoveOnlyFunction<void()>;
@@ -39,7 +52,18 @@ public:
 
     using RecvMessageCallback = scaler::utility::MoveOnlyFunction<void(std::expected<Message, Error>)>;
 
-    BinderSocket(IOContext& context, Identity identity) noexcept;
+    using RecvMessagesCallback = scaler::utility::MoveOnlyFunction<void(std::expected<std::vector<Message>, Error>)>;
+
+    // Use up to `numThreads` of the context's threads to handle the accepted connections.
+    //
+    // `connectionSendQueueLimits` bounds the messages queued for each remote identity, and `socketSendQueueLimits` the
+    // messages queued for all of them. Sends exceeding these fail with SendQueueFull. Unlimited by default.
+    BinderSocket(
+        IOContext& context,
+        Identity identity,
+        size_t numThreads = 1,
+        SendQueueLimits connectionSendQueueLimits = {},
+        SendQueueLimits socketSendQueueLimits = {}) noexcept;
 
     ~BinderSocket() noexcept;
 
@@ -54,19 +78,37 @@ public:
 
     const Identity& identity() const noexcept;
 
+    // The number of event loop threads the connections are distributed across.
+    size_t numThreads() const noexcept;
+
+    // The messages sent with sendMessage() and not yet written to the network, for all remote identities.
+    //
+    // Can be called from any thread.
+    SendQueueDepth sendQueueDepth() const noexcept;
+
     // Bind to a TCP or IPC address string (e.g. "tcp://127.0.0.1:9000", "ipc://my_socket").
     //
     // Multiple bind calls are allowed: the socket will accept connections on all bound addresses.
+    //
+    // In multi-threaded mode, IPC addresses are only served by the primary thread. If the platform does not support
+    // SO_REUSEPORT load balancing, the TCP/WebSocket addresses are also only served by the primary thread.
     void bindTo(
         std::string address, BindCallback onBindCallback, std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
 
     // Send a message to a remote identity.
+    //
+    // Fails with SendQueueFull if the message would exceed the send queue limits.
+    //
+    // High priority messages are sent before the normal priority messages queued for the same remote identity.
     void sendMessage(
-        Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept;
+        Identity remoteIdentity,
+        std::unique_ptr<Bytes> messagePayload,
+        SendMessageCallback onMessageSent,
+        MessagePriority priority = MessagePriority::Normal) noexcept;
 
     // Send a message to multiple currently connected peers.
     //
-    // This method is "fire-and-forget" and always succeeds.
+    // This method is "fire-and-forget" and always succeeds. Peers whose send queue is full silently skip the message.
     //
     // If remotePrefix is provided, only peers whose identity starts with the prefix will receive the message.
     void sendMulticastMessage(
@@ -75,6 +117,11 @@ public:
     // Receive a message from any remote identity.
     void recvMessage(RecvMessageCallback onRecvMessage) noexcept;
 
+    // Receive up to `maxCount` messages from any remote identity, in a single callback.
+    //
+    // If no message is buffered, the callback is called as soon as the next message arrives.
+    void recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept;
+
     // Close a connection to a remote identity.
     //
     // Do nothing if the connection does not exist.
@@ -83,18 +130,31 @@ public:
 private:
     // Assign a unique, internal, ID to connections.
     //
-    // This allows fast retrieval even when these don't have a remote identity yet.
+    // This allows fast retrieval even when these don't have a remote identity yet. The upper bits hold the index of the
+    // shard owning the connection.
     using ConnectionID = uint64_t;
 
+    static constexpr int connectionShardShift = 48;
+
     struct PendingSendMessage {
         std::unique_ptr<Bytes> messagePayload;
         SendMessageCallback onMessageSent;
+        MessagePriority priority;
     };
 
-    struct State {
+    // The messages sent to an identity that isn't connected yet.
+    struct PendingSendQueue {
+        std::deque<PendingSendMessage> messages {};
+        SendQueueDepth depth {};
+    };
+
+    // The accepting servers and the connections owned by one of the socket's threads.
+    //
+    // Only accessed from the shard's thread.
+    struct Shard {
         internal::EventLoopThread& _thread;
 
-        const Identity _identity;
+        const size_t _index;
 
         // Support binding to multiple addresses (TCP and/or IPC)
         std::vector<internal::AcceptServer> _servers {};
@@ -102,6 +162,28 @@ private:
         ConnectionID _connectionCounter {0};
 
         std::map<ConnectionID, std::unique_ptr<internal::MessageConnection>> _connections {};
+
+        // The connections that completed the identity exchange, sorted by remote identity so that multicast prefix
+        // lookups only visit the matching connections.
+        std::set<std::pair<Identity, ConnectionID>> _identityIndex {};
+
+        Shard(internal::EventLoopThread& thread, size_t index) noexcept: _thread(thread), _index(index) {}
+    };
+
+    using ShardCallback = std::function<void(Shard&)>;
+
+    struct State {
+        // The primary thread, owning the routing tables and the receive queues. Also runs the first shard.
+        //
+        // This is the last created of the socket's threads, so that the IOContext stops it first. When shutting down,
+        // the primary thread clears the other shards before their threads get stopped.
+        internal::EventLoopThread& _thread;
+
+        const Identity _identity;
+
+        // Immutable after construction. _shards[0] runs on _thread.
+        std::vector<std::unique_ptr<Shard>> _shards {};
+
         std::map<Identity, ConnectionID> _identityToConnectionID {};
 
         // Identities that completed identity exchange and then disconnected, mapped to the time
@@ -118,31 +200,126 @@ private:
         std::map<Identity, std::chrono::steady_clock::time_point> _disconnectedIdentities {};
         std::deque<std::pair<std::chrono::steady_clock::time_point, Identity>> _disconnectedIdentityInsertions {};
 
-        std::map<Identity, std::vector<PendingSendMessage>> _pendingSendMessages {};
+        std::map<Identity, PendingSendQueue> _pendingSendMessages {};
+
+        const SendQueueLimits _connectionSendQueueLimits;
+        const SendQueueLimits _socketSendQueueLimits;
+
+        // Shared with the send callbacks, which are called from the connections' threads.
+        std::shared_ptr<internal::SendQueueCounter> _sendQueueCounter {std::make_shared<internal::SendQueueCounter>()};
+
+        internal::RecvQueue _recvQueue {};
 
-        std::queue<RecvMessageCallback> _pendingRecvCallbacks {};
-        std::queue<Message> _pendingRecvMessages {};
+        // Set when shutting down. The shards stop forwarding their events to the primary thread, as it might be
+        // destroyed right after.
+        std::mutex _stoppedMutex {};
+        bool _stopped {false};
 
-        State(internal::EventLoopThread& thread, Identity identity) noexcept
-            : _thread(thread), _identity(std::move(identity))
+        Logger _logger {};
+
+        State(
+            internal::EventLoopThread& thread,
+            Identity identity,
+            SendQueueLimits connectionSendQueueLimits,
+            SendQueueLimits socketSendQueueLimits) noexcept
+            : _thread(thread)
+            , _identity(std::move(identity))
+            , _connectionSendQueueLimits(connectionSendQueueLimits)
+            , _socketSendQueueLimits(socketSendQueueLimits)
         {
         }
     };
 
     std::shared_ptr<State> _state;
 
-    static void onClientConnect(std::shared_ptr<State> state, internal::Client client) noexcept;
+    static size_t shardIndex(ConnectionID connectionId) noexcept;
+
+    // Execute the callback on the primary thread, immediately if the calling shard already runs on it.
+    //
+    // Drops the callback if the socket is shutting down.
+    static void executeOnPrimary(
+        State& state, const Shard& shard, internal::EventLoopThread::Callback callback) noexcept;
+
+    // Execute the callback on the thread of the shard owning the connection, immediately if it is the primary thread.
+    //
+    // Must be called from the primary thread.
+    static void executeOnConnectionShard(
+        State& state, ConnectionID connectionId, internal::EventLoopThread::Callback callback) noexcept;
+
+    // Execute the callback on the threads of all shards starting at `firstShard`, then call `onDone` once all of them
+    // completed, from the thread of the last shard to complete.
+    //
+    // Must be called from the primary thread.
+    static void executeOnShards(
+        std::shared_ptr<State> state,
+        size_t firstShard,
+        ShardCallback callback,
+        internal::EventLoopThread::Callback onDone) noexcept;
+
+    // Bind the shard to an address already bound by the primary shard.
+    static void bindShard(std::shared_ptr<State> state, Shard& shard, const Address& address) noexcept;
+
+    // Send a message on a connection owned by any shard.
+    //
+    // Must be called from the primary thread.
+    static void sendOnConnection(
+        std::shared_ptr<State> state,
+        ConnectionID connectionId,
+        std::unique_ptr<Bytes> messagePayload,
+        SendMessageCallback onMessageSent,
+        MessagePriority priority) noexcept;
+
+    // Returns false if a message of `messageSize` bytes to the remote identity doesn't fit in the send queues, after
+    // dropping the oldest messages pending for the identity if the policies allow it.
+    //
+    // Must be called from the primary thread.
+    static bool reserveSendQueue(State& state, const Identity& remoteIdentity, size_t messageSize) noexcept;
+
+    // Disconnect and destroy a connection owned by any shard.
+    //
+    // Must be called from the primary thread.
+    static void destroyConnection(std::shared_ptr<State> state, ConnectionID connectionId) noexcept;
+
+    // Remove a connection from its shard, and return it.
+    //
+    // Must be called from the shard's thread.
+    static std::unique_ptr<internal::MessageConnection> extractConnection(
+        Shard& shard, ConnectionID connectionId) noexcept;
+
+    // Send the payload to all the shard's connections, or only to those whose remote identity starts with the prefix.
+    static void multicastOnShard(
+        Shard& shard,
+        std::shared_ptr<const Bytes> messagePayload,
+        const std::optional<Identity>& remotePrefix) noexcept;
+
+    // Shard-side handlers, called from the shard's thread.
+
+    static void onClientConnect(std::shared_ptr<State> state, size_t shardIndex, internal::Client client) noexcept;
+
+    static void onConnectionIdentity(
+        std::shared_ptr<State> state, ConnectionID connectionId, Identity remoteIdentity) noexcept;
+
+    static void onConnectionDisconnect(
+        std::shared_ptr<State> state,
+        ConnectionID connectionId,
+        internal::MessageConnection::DisconnectReason reason) noexcept;
+
+    static void onConnectionMessage(
+        std::shared_ptr<State> state, ConnectionID connectionId, std::unique_ptr<Bytes> messagePayload) noexcept;
+
+    // Primary-side handlers, called from the primary thread.
 
     static void onRemoteIdentity(
         std::shared_ptr<State> state, ConnectionID connectionId, Identity remoteIdentity) noexcept;
 
+    // `remoteIdentity` is empty if the connection disconnected before the identity exchange completed.
     static void onRemoteDisconnect(
         std::shared_ptr<State> state,
         ConnectionID connectionId,
+        std::optional<Identity> remoteIdentity,
         internal::MessageConnection::DisconnectReason reason) noexcept;
 
-    static void onMessage(
-        std::shared_ptr<State> state, ConnectionID connectionId, std::unique_ptr<Bytes> messagePayload) noexcept;
+    static void onMessage(std::shared_ptr<State> state, Message message) noexcept;
 
     // Drop any _disconnectedIdentities entries older than disconnectedIdentityTTL. Called from
     // onRemoteDisconnect so the work amortises against new disconnect activity rather than a
@@ -151,7 +328,7 @@ private:
     static void purgeExpiredDisconnectedIdentities(State& state, std::chrono::steady_clock::time_point now) noexcept;
 
     static internal::MessageConnection& createConnection(
-        std::shared_ptr<State> state, std::optional<Identity> remoteIdentity) noexcept;
+        std::shared_ptr<State> state, Shard& shard, std::optional<Identity> remoteIdentity) noexcept;
 };
 
 }  // namespace ymq
@@ -9,7 +9,9 @@ namespace scaler {
 namespace ymq {
 
 // Expect all connections to start with this string.
-constexpr std::array<uint8_t, 4> magicString {'Y', 'M', 'Q', 1};
+//
+// The last byte is the protocol version.
+constexpr std::array<uint8_t, 4> magicString {'Y', 'M', 'Q', 3};
 
 constexpr size_t defaultClientMaxRetryTimes = 8;
 constexpr std::chrono::milliseconds defaultClientInitRetryDelay {100};
@@ -21,6 +23,34 @@ constexpr int serverListenBacklog = 1024;
 // Some OSes discourage large writes (macOS, Windows).
 constexpr size_t maxWriteBufferSize = 256ULL * 1024ULL * 1024ULL;  // 256 MB
 
+// Normal priority messages larger than this are sent in fragments of this size, so that high priority messages can be
+// sent in between.
+constexpr size_t messageFragmentSize = 256ULL * 1024ULL;  // 256 KB
+
+// Normal priority messages of at least this size are passed as attachments on ipc:// connections, instead of being
+// written to the socket (see internal/attachment.h).
+constexpr size_t minAttachmentSize = 1024ULL * 1024ULL;  // 1 MB
+
+static_assert(minAttachmentSize > messageFragmentSize, "only the messages sent in fragments can be attachments");
+
+// Maximum number of bytes a connection submits for writing before waiting for the previous writes to complete.
+//
+// Messages are only prioritized before being submitted: this bounds how long a high priority message waits behind the
+// fragments of a large message.
+constexpr size_t maxWriteQueueSize = 1024ULL * 1024ULL;  // 1 MB
+
+// Size of each of the two ring buffers shared by the peers of a shm:// connection. Must be a power of two.
+constexpr size_t sharedMemoryRingCapacity = 1024ULL * 1024ULL;  // 1 MB
+
+// Size of the io_uring instance of each IO thread (see IOBackend::IOUring), and of the receive buffers it provides to
+// the kernel. These are shared by all the thread's connections.
+constexpr unsigned ioUringQueueDepth      = 256;
+constexpr unsigned ioUringRecvBufferCount = 64;
+constexpr size_t ioUringRecvBufferSize    = 64ULL * 1024ULL;  // 64 KB
+
+// Maximum number of writes a connection submits as a single chain of linked sends.
+constexpr size_t ioUringMaxLinkedWrites = 64;
+
 // How long a BinderSocket remembers a disconnected peer's identity so that subsequent
 // sendMessage() calls to it fail fast instead of queueing in _pendingSendMessages. The window
 // only needs to bracket the worst-case lag between libuv processing the disconnect and the user
@@ -16,7 +16,8 @@ ConnectorSocket ConnectorSocket::connect(
     ConnectCallback onConnectCallback,
     std::optional<TLSConfig> tlsConfig,
     size_t maxRetryTimes,
-    std::chrono::milliseconds initRetryDelay) noexcept
+    std::chrono::milliseconds initRetryDelay,
+    SendQueueLimits sendQueueLimits) noexcept
 {
     internal::EventLoopThread& thread = context.nextThread();
 
@@ -27,7 +28,8 @@ ConnectorSocket ConnectorSocket::connect(
     }
 
     ConnectorSocket socket;
-    socket._state                  = std::make_shared<State>(thread, std::move(identity), parsedAddress.value(), false);
+    socket._state = std::make_shared<State>(thread, std::move(identity), parsedAddress.value(), false, sendQueueLimits);
+
     socket._state->_maxRetryTimes  = maxRetryTimes;
     socket._state->_initRetryDelay = initRetryDelay;
 
@@ -46,7 +48,8 @@ ConnectorSocket ConnectorSocket::bind(
     Identity identity,
     std::string address,
     BindCallback onBindCallback,
-    std::optional<TLSConfig> tlsConfig) noexcept
+    std::optional<TLSConfig> tlsConfig,
+    SendQueueLimits sendQueueLimits) noexcept
 {
     internal::EventLoopThread& thread = context.nextThread();
 
@@ -57,7 +60,7 @@ ConnectorSocket ConnectorSocket::bind(
     }
 
     ConnectorSocket socket;
-    socket._state = std::make_shared<State>(thread, std::move(identity), parsedAddress.value(), true);
+    socket._state = std::make_shared<State>(thread, std::move(identity), parsedAddress.value(), true, sendQueueLimits);
 
     socket._state->_thread.executeThreadSafe(
         [state = socket._state, onBindCallback = std::move(onBindCallback)]() mutable {
@@ -100,7 +103,7 @@ void ConnectorSocket::shutdown(ShutdownCallback onShutdownCallback) noexcept
         // Fail all pending receive callbacks
         fillPendingRecvCallbacksWithErr(state, Error::ErrorCode::SocketStopRequested);
 
-        state->_pendingRecvMessages = {};
+        state->_recvQueue.clearPendingMessages();
 
         onShutdownCallback();
     });
@@ -113,38 +116,60 @@ const Identity& ConnectorSocket::identity() const noexcept
     return _state->_identity;
 }
 
-void ConnectorSocket::sendMessage(std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept
+SendQueueDepth ConnectorSocket::sendQueueDepth() const noexcept
+{
+    return _state->_sendQueueCounter->depth();
+}
+
+void ConnectorSocket::sendMessage(
+    std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent, MessagePriority priority) noexcept
 {
     _state->_thread.executeThreadSafe([state          = _state,
                                        messagePayload = std::move(messagePayload),
-                                       onMessageSent  = std::move(onMessageSent)]() mutable {
+                                       onMessageSent  = std::move(onMessageSent),
+                                       priority]() mutable {
         if (state->_disconnected) {
             onMessageSent(
                 std::unexpected {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd}, std::move(messagePayload));
             return;
         }
-        state->_connection->sendMessage(std::move(messagePayload), std::move(onMessageSent));
+
+        // The limits are checked by the MessageConnection, only keep track of the socket's queue depth.
+        const size_t messageSize = messagePayload->size();
+        state->_sendQueueCounter->add(messageSize);
+
+        state->_connection->sendMessage(
+            std::move(messagePayload),
+            [counter = state->_sendQueueCounter, messageSize, onMessageSent = std::move(onMessageSent)](
+                std::expected<void, Error> result, std::unique_ptr<Bytes> payload) mutable {
+                counter->remove(messageSize);
+                onMessageSent(std::move(result), std::move(payload));
+            },
+            priority);
     });
 }
 
 void ConnectorSocket::recvMessage(RecvMessageCallback onRecvMessage) noexcept
 {
     _state->_thread.executeThreadSafe([state = _state, onRecvMessage = std::move(onRecvMessage)]() mutable {
-        if (!state->_pendingRecvMessages.empty()) {
-            // There is a message ready, call the callback immediately
-            Message message = std::move(state->_pendingRecvMessages.front());
-            state->_pendingRecvMessages.pop();
-            onRecvMessage(std::move(message));
+        if (!state->_recvQueue.hasPendingMessages() && state->_disconnected) {
+            onRecvMessage(std::unexpected {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd});
             return;
         }
 
-        if (state->_disconnected) {
-            onRecvMessage(std::unexpected {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd});
+        state->_recvQueue.recvMessage(std::move(onRecvMessage));
+    });
+}
+
+void ConnectorSocket::recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept
+{
+    _state->_thread.executeThreadSafe([state = _state, maxCount, onRecvMessages = std::move(onRecvMessages)]() mutable {
+        if (!state->_recvQueue.hasPendingMessages() && state->_disconnected) {
+            onRecvMessages(std::unexpected {Error::ErrorCode::ConnectorSocketClosedByRemoteEnd});
             return;
         }
 
-        // No messages are pending, queue the callback until a message arrives
-        state->_pendingRecvCallbacks.push(std::move(onRecvMessage));
+        state->_recvQueue.recvMessages(maxCount, std::move(onRecvMessages));
     });
 }
 
@@ -191,6 +216,10 @@ void ConnectorSocket::onClientConnected(
         return;
     }
 
+    if (internal::IOUring* ioUring = state->_thread.ioUring()) {
+        result->useIOUring(*ioUring);
+    }
+
     // Connection succeeded, now link it to the MessageConnection
     state->_connection->connect(std::move(result.value()));
 
@@ -207,6 +236,10 @@ void ConnectorSocket::onClientAccepted(std::shared_ptr<State> state, internal::C
         return;
     }
 
+    if (internal::IOUring* ioUring = state->_thread.ioUring()) {
+        client.useIOUring(*ioUring);
+    }
+
     // Establish the connection with the new client. Possibly replacing any existing client
     state->_connection->connect(std::move(client));
 }
@@ -232,15 +265,7 @@ void ConnectorSocket::onMessage(std::shared_ptr<State> state, std::unique_ptr<By
     message.address = std::make_unique<BufferedBytes>(state->_connection->remoteIdentity().value());
     message.payload = std::move(messagePayload);
 
-    if (state->_pendingRecvCallbacks.empty()) {
-        // No callback waiting, buffer the message until the user calls recvMessage()
-        state->_pendingRecvMessages.push(std::move(message));
-        return;
-    }
-
-    RecvMessageCallback onRecvMessage = std::move(state->_pendingRecvCallbacks.front());
-    state->_pendingRecvCallbacks.pop();
-    onRecvMessage(std::move(message));
+    state->_recvQueue.onMessage(std::move(message));
 }
 
 void ConnectorSocket::emplaceMessageConnection(std::shared_ptr<State> state) noexcept
@@ -251,15 +276,13 @@ void ConnectorSocket::emplaceMessageConnection(std::shared_ptr<State> state) noe
         [](Identity) {},
         std::bind_front(&ConnectorSocket::onRemoteDisconnect, state),
         std::bind_front(&ConnectorSocket::onMessage, state));
+
+    state->_connection->setSendQueueLimits(state->_sendQueueLimits);
 }
 
 void ConnectorSocket::fillPendingRecvCallbacksWithErr(std::shared_ptr<State> state, Error err) noexcept
 {
-    while (!state->_pendingRecvCallbacks.empty()) {
-        auto callback = std::move(state->_pendingRecvCallbacks.front());
-        state->_pendingRecvCallbacks.pop();
-        callback(std::unexpected(err));
-    }
+    state->_recvQueue.failPendingRecvs(std::move(err));
 }
 
 }  // namespace ymq
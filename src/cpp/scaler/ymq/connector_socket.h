@@ -4,8 +4,8 @@
 #include <expected>
 #include <memory>
 #include <optional>
-#include <queue>
 #include <string>
+#include <vector>
 
 #include "scaler/error/error.h"
 #include "scaler/utility/move_only_function.h"
@@ -15,8 +15,12 @@
 #include "scaler/ymq/internal/connect_client.h"
 #include "scaler/ymq/internal/event_loop_thread.h"
 #include "scaler/ymq/internal/message_connection.h"
+#include "scaler/ymq/internal/recv_queue.h"
+#include "scaler/ymq/internal/send_queue_counter.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/typedefs.h"
 
 namespace scaler {
@@ -41,11 +45,15 @@ public:
 
     using RecvMessageCallback = scaler::utility::MoveOnlyFunction<void(std::expected<Message, Error>)>;
 
+    using RecvMessagesCallback = scaler::utility::MoveOnlyFunction<void(std::expected<std::vector<Message>, Error>)>;
+
     // Create a connector socket and initiate connection to the remote address.
     //
     // The socket will automatically retry connecting to the remote address up to maxRetryTimes on failure.
     //
     // The onConnectCallback will be invoked once the connection succeeds or all retries are exhausted.
+    //
+    // Sends exceeding `sendQueueLimits` fail with SendQueueFull. Unlimited by default.
     static ConnectorSocket connect(
         IOContext& context,
         Identity identity,
@@ -53,19 +61,23 @@ public:
         ConnectCallback onConnectCallback,
         std::optional<TLSConfig> tlsConfig       = std::nullopt,
         size_t maxRetryTimes                     = defaultClientMaxRetryTimes,
-        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay) noexcept;
+        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay,
+        SendQueueLimits sendQueueLimits          = {}) noexcept;
 
     // Create a connector socket that binds to a local address and waits for a single incoming connection.
     //
     // If the remote unexpectedly disconnect, the socket will wait for reconnection.
     //
     // The onBindCallback will be invoked once the server is listening, or with an error.
+    //
+    // Sends exceeding `sendQueueLimits` fail with SendQueueFull. Unlimited by default.
     static ConnectorSocket bind(
         IOContext& context,
         Identity identity,
         std::string address,
         BindCallback onBindCallback,
-        std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
+        std::optional<TLSConfig> tlsConfig = std::nullopt,
+        SendQueueLimits sendQueueLimits    = {}) noexcept;
 
     ~ConnectorSocket() noexcept;
 
@@ -80,14 +92,31 @@ public:
 
     const Identity& identity() const noexcept;
 
+    // The messages sent with sendMessage() and not yet written to the network.
+    //
+    // Can be called from any thread.
+    SendQueueDepth sendQueueDepth() const noexcept;
+
     // Send a message to the connected remote peer.
     //
     // If not yet connected, the message will be queued and sent once the connection is established.
-    void sendMessage(std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept;
+    //
+    // Fails with SendQueueFull if the message would exceed the send queue limits.
+    //
+    // High priority messages are sent before the queued normal priority messages.
+    void sendMessage(
+        std::unique_ptr<Bytes> messagePayload,
+        SendMessageCallback onMessageSent,
+        MessagePriority priority = MessagePriority::Normal) noexcept;
 
     // Receive a message from the connected remote peer.
     void recvMessage(RecvMessageCallback onRecvMessage) noexcept;
 
+    // Receive up to `maxCount` messages from the connected remote peer, in a single callback.
+    //
+    // If no message is buffered, the callback is called as soon as the next message arrives.
+    void recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept;
+
 private:
     struct State {
         internal::EventLoopThread& _thread;
@@ -109,11 +138,24 @@ private:
 
         // Common fields
         std::unique_ptr<internal::MessageConnection> _connection {};
-        std::queue<RecvMessageCallback> _pendingRecvCallbacks {};
-        std::queue<Message> _pendingRecvMessages {};
-
-        State(internal::EventLoopThread& thread, Identity identity, Address address, bool isBinding) noexcept
-            : _thread(thread), _identity(std::move(identity)), _address(std::move(address)), _isBinding(isBinding)
+        internal::RecvQueue _recvQueue {};
+
+        const SendQueueLimits _sendQueueLimits;
+
+        // Shared with the send callbacks, as these might be called after the socket got destroyed.
+        std::shared_ptr<internal::SendQueueCounter> _sendQueueCounter {std::make_shared<internal::SendQueueCounter>()};
+
+        State(
+            internal::EventLoopThread& thread,
+            Identity identity,
+            Address address,
+            bool isBinding,
+            SendQueueLimits sendQueueLimits) noexcept
+            : _thread(thread)
+            , _identity(std::move(identity))
+            , _address(std::move(address))
+            , _isBinding(isBinding)
+            , _sendQueueLimits(sendQueueLimits)
         {
         }
     };
@@ -7,7 +7,13 @@ namespace scaler {
 namespace ymq {
 namespace future {
 
-BinderSocket::BinderSocket(IOContext& context, Identity identity) noexcept: _socket(context, std::move(identity))
+BinderSocket::BinderSocket(
+    IOContext& context,
+    Identity identity,
+    size_t numThreads,
+    SendQueueLimits connectionSendQueueLimits,
+    SendQueueLimits socketSendQueueLimits) noexcept
+    : _socket(context, std::move(identity), numThreads, connectionSendQueueLimits, socketSendQueueLimits)
 {
 }
 
@@ -16,6 +22,16 @@ const Identity& BinderSocket::identity() const noexcept
     return _socket.identity();
 }
 
+size_t BinderSocket::numThreads() const noexcept
+{
+    return _socket.numThreads();
+}
+
+SendQueueDepth BinderSocket::sendQueueDepth() const noexcept
+{
+    return _socket.sendQueueDepth();
+}
+
 std::future<std::expected<Address, Error>> BinderSocket::bindTo(std::string address, std::optional<TLSConfig> tlsConfig)
 {
     std::promise<std::expected<Address, Error>> promise {};
@@ -32,7 +48,7 @@ std::future<std::expected<Address, Error>> BinderSocket::bindTo(std::string addr
 }
 
 std::future<std::expected<void, Error>> BinderSocket::sendMessage(
-    Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload)
+    Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload, MessagePriority priority)
 {
     std::promise<std::expected<void, Error>> promise {};
     auto future = promise.get_future();
@@ -43,7 +59,8 @@ std::future<std::expected<void, Error>> BinderSocket::sendMessage(
         [promise = std::move(promise)](
             std::expected<void, Error> result, [[maybe_unused]] std::unique_ptr<Bytes> payload) mutable {
             promise.set_value(std::move(result));
-        });
+        },
+        priority);
 
     return future;
 }
@@ -66,6 +83,19 @@ std::future<std::expected<Message, Error>> BinderSocket::recvMessage()
     return future;
 }
 
+std::future<std::expected<std::vector<Message>, Error>> BinderSocket::recvMessages(size_t maxCount)
+{
+    std::promise<std::expected<std::vector<Message>, Error>> promise {};
+    auto future = promise.get_future();
+
+    _socket.recvMessages(
+        maxCount, [promise = std::move(promise)](std::expected<std::vector<Message>, Error> result) mutable {
+            promise.set_value(std::move(result));
+        });
+
+    return future;
+}
+
 void BinderSocket::closeConnection(Identity remoteIdentity) noexcept
 {
     _socket.closeConnection(std::move(remoteIdentity));
@@ -5,12 +5,15 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "scaler/error/error.h"
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/binder_socket.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/typedefs.h"
 
 namespace scaler {
@@ -20,7 +23,12 @@ namespace future {
 // Future-based wrapper for BinderSocket that returns std::future objects.
 class BinderSocket {
 public:
-    BinderSocket(IOContext& context, Identity identity) noexcept;
+    BinderSocket(
+        IOContext& context,
+        Identity identity,
+        size_t numThreads = 1,
+        SendQueueLimits connectionSendQueueLimits = {},
+        SendQueueLimits socketSendQueueLimits = {}) noexcept;
 
     ~BinderSocket() noexcept = default;
 
@@ -32,16 +40,25 @@ public:
 
     const Identity& identity() const noexcept;
 
+    size_t numThreads() const noexcept;
+
+    SendQueueDepth sendQueueDepth() const noexcept;
+
     std::future<std::expected<Address, Error>> bindTo(
         std::string address, std::optional<TLSConfig> tlsConfig = std::nullopt);
 
-    std::future<std::expected<void, Error>> sendMessage(Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload);
+    std::future<std::expected<void, Error>> sendMessage(
+        Identity remoteIdentity,
+        std::unique_ptr<Bytes> messagePayload,
+        MessagePriority priority = MessagePriority::Normal);
 
     void sendMulticastMessage(
         std::unique_ptr<Bytes> messagePayload, std::optional<Identity> remotePrefix = std::nullopt) noexcept;
 
     std::future<std::expected<Message, Error>> recvMessage();
 
+    std::future<std::expected<std::vector<Message>, Error>> recvMessages(size_t maxCount);
+
     void closeConnection(Identity remoteIdentity) noexcept;
 
 private:
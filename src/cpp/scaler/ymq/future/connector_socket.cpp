@@ -13,7 +13,8 @@ std::expected<ConnectorSocket, scaler::ymq::Error> ConnectorSocket::connect(
     std::string address,
     std::optional<TLSConfig> tlsConfig,
     size_t maxRetryTimes,
-    std::chrono::milliseconds initRetryDelay)
+    std::chrono::milliseconds initRetryDelay,
+    SendQueueLimits sendQueueLimits)
 {
     std::promise<std::expected<void, scaler::ymq::Error>> promise {};
     auto future = promise.get_future();
@@ -27,7 +28,8 @@ std::expected<ConnectorSocket, scaler::ymq::Error> ConnectorSocket::connect(
         },
         std::move(tlsConfig),
         maxRetryTimes,
-        initRetryDelay);
+        initRetryDelay,
+        sendQueueLimits);
 
     auto connectResult = future.get();
     if (!connectResult.has_value()) {
@@ -38,7 +40,11 @@ std::expected<ConnectorSocket, scaler::ymq::Error> ConnectorSocket::connect(
 }
 
 std::expected<std::pair<ConnectorSocket, Address>, scaler::ymq::Error> ConnectorSocket::bind(
-    IOContext& context, Identity identity, std::string address, std::optional<TLSConfig> tlsConfig)
+    IOContext& context,
+    Identity identity,
+    std::string address,
+    std::optional<TLSConfig> tlsConfig,
+    SendQueueLimits sendQueueLimits)
 {
     std::promise<std::expected<Address, scaler::ymq::Error>> promise {};
     auto future = promise.get_future();
@@ -50,7 +56,8 @@ std::expected<std::pair<ConnectorSocket, Address>, scaler::ymq::Error> Connector
         [promise = std::move(promise)](std::expected<Address, scaler::ymq::Error> result) mutable {
             promise.set_value(std::move(result));
         },
-        std::move(tlsConfig));
+        std::move(tlsConfig),
+        sendQueueLimits);
 
     auto bindResult = future.get();
     if (!bindResult.has_value()) {
@@ -69,8 +76,13 @@ const Identity& ConnectorSocket::identity() const noexcept
     return _socket.identity();
 }
 
+SendQueueDepth ConnectorSocket::sendQueueDepth() const noexcept
+{
+    return _socket.sendQueueDepth();
+}
+
 std::future<std::expected<void, scaler::ymq::Error>> ConnectorSocket::sendMessage(
-    std::unique_ptr<scaler::ymq::Bytes> messagePayload)
+    std::unique_ptr<scaler::ymq::Bytes> messagePayload, scaler::ymq::MessagePriority priority)
 {
     std::promise<std::expected<void, scaler::ymq::Error>> promise {};
     auto future = promise.get_future();
@@ -81,7 +93,8 @@ std::future<std::expected<void, scaler::ymq::Error>> ConnectorSocket::sendMessag
             std::expected<void, scaler::ymq::Error> result,
             [[maybe_unused]] std::unique_ptr<scaler::ymq::Bytes> payload) mutable {
             promise.set_value(std::move(result));
-        });
+        },
+        priority);
 
     return future;
 }
@@ -99,6 +112,22 @@ std::future<std::expected<scaler::ymq::Message, scaler::ymq::Error>> ConnectorSo
     return future;
 }
 
+std::future<std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error>> ConnectorSocket::recvMessages(
+    size_t maxCount)
+{
+    std::promise<std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error>> promise {};
+    auto future = promise.get_future();
+
+    _socket.recvMessages(
+        maxCount,
+        [promise = std::move(promise)](
+            std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error> result) mutable {
+            promise.set_value(std::move(result));
+        });
+
+    return future;
+}
+
 }  // namespace future
 }  // namespace ymq
 }  // namespace scaler
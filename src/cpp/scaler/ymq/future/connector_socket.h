@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "scaler/error/error.h"
 #include "scaler/ymq/address.h"
@@ -13,6 +14,8 @@
 #include "scaler/ymq/connector_socket.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/tls_config.h"
 #include "scaler/ymq/typedefs.h"
 
@@ -29,10 +32,15 @@ public:
         std::string address,
         std::optional<TLSConfig> tlsConfig       = std::nullopt,
         size_t maxRetryTimes                     = defaultClientMaxRetryTimes,
-        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay);
+        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay,
+        SendQueueLimits sendQueueLimits          = {});
 
     static std::expected<std::pair<ConnectorSocket, Address>, scaler::ymq::Error> bind(
-        IOContext& context, Identity identity, std::string address, std::optional<TLSConfig> tlsConfig = std::nullopt);
+        IOContext& context,
+        Identity identity,
+        std::string address,
+        std::optional<TLSConfig> tlsConfig = std::nullopt,
+        SendQueueLimits sendQueueLimits    = {});
 
     ~ConnectorSocket() noexcept = default;
 
@@ -44,11 +52,16 @@ public:
 
     const Identity& identity() const noexcept;
 
+    SendQueueDepth sendQueueDepth() const noexcept;
+
     std::future<std::expected<void, scaler::ymq::Error>> sendMessage(
-        std::unique_ptr<scaler::ymq::Bytes> messagePayload);
+        std::unique_ptr<scaler::ymq::Bytes> messagePayload,
+        scaler::ymq::MessagePriority priority = scaler::ymq::MessagePriority::Normal);
 
     std::future<std::expected<scaler::ymq::Message, scaler::ymq::Error>> recvMessage();
 
+    std::future<std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error>> recvMessages(size_t maxCount);
+
 private:
     ConnectorSocket(scaler::ymq::ConnectorSocket socket) noexcept;
 
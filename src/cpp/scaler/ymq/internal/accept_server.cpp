@@ -11,6 +11,8 @@
 #include "scaler/wrapper/uv/socket_address.h"
 #include "scaler/wrapper/uv/tcp.h"
 #include "scaler/ymq/configuration.h"
+#include "scaler/ymq/internal/attachment.h"
+#include "scaler/ymq/internal/shared_memory_stream.h"
 #include "scaler/ymq/internal/websocket_stream.h"
 
 namespace scaler {
@@ -34,8 +36,10 @@ Error toYMQError(scaler::wrapper::uv::Error uvError) noexcept
 }  // namespace details
 
 std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
-    scaler::wrapper::uv::Loop& loop, Address address, ConnectionCallback onConnectionCallback) noexcept
+    scaler::wrapper::uv::Loop& loop, Address address, ConnectionCallback onConnectionCallback, bool reusePort) noexcept
 {
+    const uv_tcp_flags tcpFlags = reusePort ? UV_TCP_REUSEPORT : uv_tcp_flags(0);
+
     auto sslContext = address.getSSLContext();
     if (!sslContext.has_value()) {
         return std::unexpected {std::move(sslContext.error())};
@@ -43,6 +47,7 @@ std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
 
     std::optional<Server> server;
     std::optional<WebSocketAddress> webSocketAddress;
+    bool sharedMemory = false;
 
     switch (address.type()) {
         case Address::Type::TCP: {
@@ -51,7 +56,7 @@ std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
                 if (!secureServer.has_value()) {
                     return std::unexpected {details::toYMQError(secureServer.error())};
                 }
-                if (auto bindResult = secureServer->bind(address.asTCP(), uv_tcp_flags(0)); !bindResult.has_value()) {
+                if (auto bindResult = secureServer->bind(address.asTCP(), tcpFlags); !bindResult.has_value()) {
                     return std::unexpected {details::toYMQError(bindResult.error())};
                 }
                 server = std::move(secureServer.value());
@@ -60,7 +65,7 @@ std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
                 if (!tcpServer.has_value()) {
                     return std::unexpected {details::toYMQError(tcpServer.error())};
                 }
-                if (auto bindResult = tcpServer->bind(address.asTCP(), uv_tcp_flags(0)); !bindResult.has_value()) {
+                if (auto bindResult = tcpServer->bind(address.asTCP(), tcpFlags); !bindResult.has_value()) {
                     return std::unexpected {details::toYMQError(bindResult.error())};
                 }
                 server = std::move(tcpServer.value());
@@ -85,13 +90,25 @@ std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
             if (!tcpServer.has_value()) {
                 return std::unexpected {details::toYMQError(tcpServer.error())};
             }
-            if (auto bindResult = tcpServer->bind(webSocketAddress->tcpAddress, uv_tcp_flags(0));
-                !bindResult.has_value()) {
+            if (auto bindResult = tcpServer->bind(webSocketAddress->tcpAddress, tcpFlags); !bindResult.has_value()) {
                 return std::unexpected {details::toYMQError(bindResult.error())};
             }
             server = std::move(tcpServer.value());
             break;
         }
+        case Address::Type::SharedMemory: {
+            // The shared memory segments are negotiated over the IPC connections.
+            sharedMemory    = true;
+            auto pipeServer = scaler::wrapper::uv::PipeServer::init(loop, false);
+            if (!pipeServer.has_value()) {
+                return std::unexpected {details::toYMQError(pipeServer.error())};
+            }
+            if (auto bindResult = pipeServer->bind(address.asSharedMemory().path); !bindResult.has_value()) {
+                return std::unexpected {details::toYMQError(bindResult.error())};
+            }
+            server = std::move(pipeServer.value());
+            break;
+        }
         default: std::unreachable();
     }
 
@@ -100,6 +117,7 @@ std::expected<AcceptServer, scaler::ymq::Error> AcceptServer::init(
         std::move(onConnectionCallback),
         std::move(server.value()),
         std::move(webSocketAddress),
+        sharedMemory,
         std::move(sslContext.value()));
 
     auto listenCallback = std::bind_front(&AcceptServer::onConnection, state);
@@ -132,11 +150,13 @@ AcceptServer::State::State(
     ConnectionCallback onConnectionCallback,
     Server server,
     std::optional<WebSocketAddress> webSocketAddress,
+    bool sharedMemory,
     std::optional<scaler::wrapper::openssl::SSLContext> sslContext) noexcept
     : _loop(loop)
     , _onConnectionCallback(std::move(onConnectionCallback))
     , _server(std::move(server))
     , _webSocketAddress(std::move(webSocketAddress))
+    , _sharedMemory(sharedMemory)
     , _sslContext(std::move(sslContext))
 {
 }
@@ -167,6 +187,10 @@ Address AcceptServer::address() const noexcept
     } else if (auto* secureServer = std::get_if<scaler::wrapper::openssl::SecureServer>(&_state->_server.value())) {
         return Address {UV_EXIT_ON_ERROR(secureServer->getSockName()), true};
     } else if (auto* pipeServer = std::get_if<scaler::wrapper::uv::PipeServer>(&_state->_server.value())) {
+        if (_state->_sharedMemory) {
+            return Address {SharedMemoryAddress {UV_EXIT_ON_ERROR(pipeServer->getSockName())}};
+        }
+
         return Address {UV_EXIT_ON_ERROR(pipeServer->getSockName())};
     } else {
         std::unreachable();
@@ -228,8 +252,25 @@ void AcceptServer::onConnection(
         UV_EXIT_ON_ERROR(secureServer->accept(secureClient));
         return state->_onConnectionCallback(Client(std::move(secureClient)));
     } else if (auto* pipeServer = std::get_if<scaler::wrapper::uv::PipeServer>(&state->_server.value())) {
-        scaler::wrapper::uv::Pipe pipeClient = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(state->_loop, false));
+        // ipc:// connections can receive attachments (see attachment.h).
+        const bool ipc = !state->_sharedMemory && attachmentsSupported();
+
+        scaler::wrapper::uv::Pipe pipeClient = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(state->_loop, ipc));
         UV_EXIT_ON_ERROR(pipeServer->accept(pipeClient));
+
+        if (state->_sharedMemory) {
+            SharedMemoryStream::upgradeAsServer(
+                std::move(pipeClient),
+                [state](std::expected<SharedMemoryStream, scaler::wrapper::uv::Error> shmResult) mutable {
+                    if (!shmResult.has_value()) {
+                        // Reject this connection silently; the server keeps running.
+                        return;
+                    }
+                    state->_onConnectionCallback(Client(std::move(shmResult.value())));
+                });
+            return;
+        }
+
         return state->_onConnectionCallback(Client(std::move(pipeClient)));
     } else {
         std::unreachable();
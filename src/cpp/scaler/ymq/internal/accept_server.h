@@ -28,8 +28,15 @@ public:
 
     // Create a server bound to and listening on `address`. Returns an error instead of an
     // instance when binding or listening fails (e.g. EADDRINUSE when the address is in use).
+    //
+    // With `reusePort`, TCP and WebSocket servers are bound with SO_REUSEPORT, allowing several servers to listen on
+    // the same address while the kernel balances the incoming connections between them. Fails with an error if the
+    // platform does not support it. Ignored for IPC and shared memory.
     static std::expected<AcceptServer, Error> init(
-        scaler::wrapper::uv::Loop& loop, Address address, ConnectionCallback onConnectionCallback) noexcept;
+        scaler::wrapper::uv::Loop& loop,
+        Address address,
+        ConnectionCallback onConnectionCallback,
+        bool reusePort = false) noexcept;
 
     ~AcceptServer() noexcept;
 
@@ -61,6 +68,9 @@ private:
         // Set when the transport is WebSocket; used to reconstruct the address() return value.
         std::optional<WebSocketAddress> _webSocketAddress;
 
+        // Set when the transport is shared memory, negotiated over the accepted pipes.
+        bool _sharedMemory;
+
         std::optional<scaler::wrapper::openssl::SSLContext> _sslContext;
 
         State(
@@ -68,6 +78,7 @@ private:
             ConnectionCallback onConnectionCallback,
             Server server,
             std::optional<WebSocketAddress> webSocketAddress,
+            bool sharedMemory,
             std::optional<scaler::wrapper::openssl::SSLContext> sslContext) noexcept;
     };
 
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <uv.h>
+
+#include <expected>
+#include <memory>
+#include <span>
+
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/ymq/bytes.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// Large messages sent over ipc:// connections are passed as attachments: sealed memory files (see memfd_create())
+// whose file descriptors are sent along with the frame header, and that the receiver maps instead of reading the
+// payload through the socket.
+//
+// Only supported on Linux, other platforms fail with UV_ENOTSUP.
+
+// Returns false if the platform cannot pass attachments, in which case ipc:// connections don't use them.
+bool attachmentsSupported() noexcept;
+
+// Creates a sealed memory file holding a copy of the payload. The caller owns the returned file descriptor.
+std::expected<uv_file, scaler::wrapper::uv::Error> createAttachment(std::span<const uint8_t> payload) noexcept;
+
+// Maps a received attachment, which must be a sealed memory file of exactly size bytes.
+//
+// The mapping is private: writing to the returned buffer doesn't change the file. The file descriptor can be closed
+// once this returns.
+std::expected<std::unique_ptr<Bytes>, scaler::wrapper::uv::Error> mapAttachment(uv_os_fd_t fd, size_t size) noexcept;
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
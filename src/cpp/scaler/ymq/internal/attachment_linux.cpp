@@ -0,0 +1,140 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <optional>
+#include <string>
+
+#include "scaler/ymq/buffered_bytes.h"
+#include "scaler/ymq/internal/attachment.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+namespace {
+
+// Once sealed, the sender can neither modify nor resize the file, which would crash the receiver (SIGBUS) or change
+// a message it already received.
+constexpr int attachmentSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+// The private mapping of a received attachment.
+class AttachmentBytes final: public Bytes {
+public:
+    AttachmentBytes(uint8_t* data, size_t size) noexcept: _data(data), _size(size) {}
+
+    ~AttachmentBytes() noexcept override
+    {
+        ::munmap(_data, _size);
+    }
+
+    AttachmentBytes(const AttachmentBytes&)            = delete;
+    AttachmentBytes& operator=(const AttachmentBytes&) = delete;
+
+    const uint8_t* data() const noexcept override
+    {
+        return _data;
+    }
+
+    uint8_t* data() noexcept override
+    {
+        return _data;
+    }
+
+    size_t size() const noexcept override
+    {
+        return _size;
+    }
+
+    std::optional<std::string> asString() const override
+    {
+        return std::string(reinterpret_cast<const char*>(_data), _size);
+    }
+
+private:
+    uint8_t* _data;
+    size_t _size;
+};
+
+scaler::wrapper::uv::Error lastError() noexcept
+{
+    return scaler::wrapper::uv::Error {uv_translate_sys_error(errno)};
+}
+
+}  // namespace
+
+bool attachmentsSupported() noexcept
+{
+    return true;
+}
+
+std::expected<uv_file, scaler::wrapper::uv::Error> createAttachment(std::span<const uint8_t> payload) noexcept
+{
+    const int fd = ::memfd_create("ymq-attachment", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return std::unexpected {lastError()};
+    }
+
+    size_t offset = 0;
+    while (offset < payload.size()) {
+        const ssize_t written =
+            ::pwrite(fd, payload.data() + offset, payload.size() - offset, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            const scaler::wrapper::uv::Error error = lastError();
+            ::close(fd);
+            return std::unexpected {error};
+        }
+
+        offset += static_cast<size_t>(written);
+    }
+
+    if (::fcntl(fd, F_ADD_SEALS, attachmentSeals) != 0) {
+        const scaler::wrapper::uv::Error error = lastError();
+        ::close(fd);
+        return std::unexpected {error};
+    }
+
+    return fd;
+}
+
+std::expected<std::unique_ptr<Bytes>, scaler::wrapper::uv::Error> mapAttachment(uv_os_fd_t fd, size_t size) noexcept
+{
+    const int seals = ::fcntl(fd, F_GET_SEALS);
+    if (seals < 0) {
+        return std::unexpected {lastError()};
+    }
+
+    if ((seals & attachmentSeals) != attachmentSeals) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EPROTO}};
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        return std::unexpected {lastError()};
+    }
+
+    if (static_cast<size_t>(status.st_size) != size) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EPROTO}};
+    }
+
+    if (size == 0) {
+        return std::make_unique<BufferedBytes>(0);  // mmap() rejects empty mappings
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return std::unexpected {lastError()};
+    }
+
+    return std::make_unique<AttachmentBytes>(static_cast<uint8_t*>(data), size);
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,26 @@
+#include "scaler/ymq/internal/attachment.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// Memory files can only be created on Linux.
+
+bool attachmentsSupported() noexcept
+{
+    return false;
+}
+
+std::expected<uv_file, scaler::wrapper::uv::Error> createAttachment(std::span<const uint8_t>) noexcept
+{
+    return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+}
+
+std::expected<std::unique_ptr<Bytes>, scaler::wrapper::uv::Error> mapAttachment(uv_os_fd_t, size_t) noexcept
+{
+    return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
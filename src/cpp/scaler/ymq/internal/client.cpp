@@ -23,6 +23,14 @@ Client::Client(WebSocketStream stream) noexcept: _socket(std::move(stream))
 {
 }
 
+Client::Client(SharedMemoryStream stream) noexcept: _socket(std::move(stream))
+{
+}
+
+Client::Client(IOUringStream stream) noexcept: _socket(std::move(stream))
+{
+}
+
 bool Client::isTCP() const noexcept
 {
     return std::holds_alternative<scaler::wrapper::uv::TCPSocket>(_socket);
@@ -38,6 +46,13 @@ bool Client::isWebSocket() const noexcept
     return std::holds_alternative<WebSocketStream>(_socket);
 }
 
+void Client::useIOUring(IOUring& ring) noexcept
+{
+    if (auto* tcp = std::get_if<scaler::wrapper::uv::TCPSocket>(&_socket)) {
+        _socket = IOUringStream(ring, std::move(*tcp));
+    }
+}
+
 std::expected<void, scaler::wrapper::uv::Error> Client::write(
     std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept
 {
@@ -57,6 +72,14 @@ std::expected<void, scaler::wrapper::uv::Error> Client::write(
         if (auto result = ws->write(buffers, std::move(callback)); !result) {
             return std::unexpected(result.error());
         }
+    } else if (auto* shm = std::get_if<SharedMemoryStream>(&_socket)) {
+        if (auto result = shm->write(buffers, std::move(callback)); !result) {
+            return std::unexpected(result.error());
+        }
+    } else if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        if (auto result = ioUring->write(buffers, std::move(callback)); !result) {
+            return std::unexpected(result.error());
+        }
     } else {
         std::unreachable();
     }
@@ -64,6 +87,37 @@ std::expected<void, scaler::wrapper::uv::Error> Client::write(
     return {};
 }
 
+bool Client::supportsAttachments() const noexcept
+{
+    const auto* pipe = std::get_if<scaler::wrapper::uv::Pipe>(&_socket);
+    return pipe != nullptr && pipe->handle().native().ipc;
+}
+
+std::expected<void, scaler::wrapper::uv::Error> Client::write(
+    std::span<const std::span<const uint8_t>> buffers,
+    uv_file attachment,
+    scaler::wrapper::uv::WriteCallback callback) noexcept
+{
+    assert(supportsAttachments());
+
+    auto& pipe = std::get<scaler::wrapper::uv::Pipe>(_socket);
+    if (auto result = pipe.write(buffers, attachment, std::move(callback)); !result) {
+        return std::unexpected(result.error());
+    }
+
+    return {};
+}
+
+std::expected<scaler::wrapper::uv::Pipe, scaler::wrapper::uv::Error> Client::acceptAttachment() noexcept
+{
+    auto* pipe = std::get_if<scaler::wrapper::uv::Pipe>(&_socket);
+    if (pipe == nullptr) {
+        return std::unexpected(scaler::wrapper::uv::Error {UV_ENOTSUP});
+    }
+
+    return pipe->acceptPending();
+}
+
 std::expected<void, scaler::wrapper::uv::Error> Client::readStart(scaler::wrapper::uv::ReadCallback callback) noexcept
 {
     if (auto* tcp = std::get_if<scaler::wrapper::uv::TCPSocket>(&_socket)) {
@@ -74,6 +128,10 @@ std::expected<void, scaler::wrapper::uv::Error> Client::readStart(scaler::wrappe
         return pipe->readStart(std::move(callback));
     } else if (auto* ws = std::get_if<WebSocketStream>(&_socket)) {
         return ws->readStart(std::move(callback));
+    } else if (auto* shm = std::get_if<SharedMemoryStream>(&_socket)) {
+        return shm->readStart(std::move(callback));
+    } else if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        return ioUring->readStart(std::move(callback));
     } else {
         std::unreachable();
     }
@@ -89,6 +147,10 @@ void Client::readStop() noexcept
         pipe->readStop();
     } else if (auto* ws = std::get_if<WebSocketStream>(&_socket)) {
         ws->readStop();
+    } else if (auto* shm = std::get_if<SharedMemoryStream>(&_socket)) {
+        shm->readStop();
+    } else if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        ioUring->readStop();
     } else {
         std::unreachable();
     }
@@ -102,8 +164,11 @@ std::expected<void, scaler::wrapper::uv::Error> Client::setNoDelay(bool enable)
     if (auto* tls = std::get_if<scaler::wrapper::openssl::SecureSocket>(&_socket)) {
         return tls->nodelay(enable);
     }
+    if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        return ioUring->nodelay(enable);
+    }
     // WebSocket is TCP-backed but TCP_NODELAY is already set during connection setup.
-    // IPC does not support TCP_NODELAY.
+    // IPC and shared memory do not support TCP_NODELAY.
     return {};
 }
 
@@ -126,6 +191,14 @@ std::expected<void, scaler::wrapper::uv::Error> Client::shutdown(
         if (auto result = ws->shutdown(std::move(callback)); !result) {
             return std::unexpected(result.error());
         }
+    } else if (auto* shm = std::get_if<SharedMemoryStream>(&_socket)) {
+        if (auto result = shm->shutdown(std::move(callback)); !result) {
+            return std::unexpected(result.error());
+        }
+    } else if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        if (auto result = ioUring->shutdown(std::move(callback)); !result) {
+            return std::unexpected(result.error());
+        }
     } else {
         std::unreachable();
     }
@@ -144,6 +217,12 @@ std::expected<void, scaler::wrapper::uv::Error> Client::closeReset() noexcept
     if (auto* ws = std::get_if<WebSocketStream>(&_socket)) {
         return ws->closeReset();
     }
+    if (auto* shm = std::get_if<SharedMemoryStream>(&_socket)) {
+        return shm->closeReset();
+    }
+    if (auto* ioUring = std::get_if<IOUringStream>(&_socket)) {
+        return ioUring->closeReset();
+    }
     if ([[maybe_unused]] auto* pipe = std::get_if<scaler::wrapper::uv::Pipe>(&_socket)) {
         // IPC don't support RST-style close.
         return std::unexpected(scaler::wrapper::uv::Error {UV_ENOTSUP});
@@ -10,19 +10,26 @@
 #include "scaler/wrapper/uv/error.h"
 #include "scaler/wrapper/uv/pipe.h"
 #include "scaler/wrapper/uv/tcp.h"
+#include "scaler/ymq/internal/io_uring.h"
+#include "scaler/ymq/internal/io_uring_stream.h"
+#include "scaler/ymq/internal/shared_memory_stream.h"
 #include "scaler/ymq/internal/websocket_stream.h"
 
 namespace scaler {
 namespace ymq {
 namespace internal {
 
-// A connected client socket abstracting TCP, TLS, IPC, and WebSocket transports.
+// A connected client socket abstracting TCP, TLS, IPC, WebSocket, and shared memory transports.
+//
+// TCP connections might also be served through io_uring (see IOBackend::IOUring).
 class Client {
 public:
     explicit Client(scaler::wrapper::uv::TCPSocket socket) noexcept;
     explicit Client(scaler::wrapper::openssl::SecureSocket socket) noexcept;
     explicit Client(scaler::wrapper::uv::Pipe pipe) noexcept;
     explicit Client(WebSocketStream stream) noexcept;
+    explicit Client(SharedMemoryStream stream) noexcept;
+    explicit Client(IOUringStream stream) noexcept;
 
     ~Client() noexcept = default;
 
@@ -38,10 +45,27 @@ public:
 
     bool isWebSocket() const noexcept;
 
+    // Moves the IOs of a plain TCP client to the io_uring instance. The other transports are left on libuv.
+    //
+    // Must be called before the first read or write.
+    void useIOUring(IOUring& ring) noexcept;
+
     // The buffers' content must remain valid until the callback is called.
     std::expected<void, scaler::wrapper::uv::Error> write(
         std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept;
 
+    // Whether write() can pass attachments, i.e. if the client is a pipe initialized with ipc (see attachment.h).
+    bool supportsAttachments() const noexcept;
+
+    // Writes the buffers along with an attachment's file descriptor, which is closed once written.
+    std::expected<void, scaler::wrapper::uv::Error> write(
+        std::span<const std::span<const uint8_t>> buffers,
+        uv_file attachment,
+        scaler::wrapper::uv::WriteCallback callback) noexcept;
+
+    // Accepts the next attachment received along with the read data. The returned handle owns its file descriptor.
+    std::expected<scaler::wrapper::uv::Pipe, scaler::wrapper::uv::Error> acceptAttachment() noexcept;
+
     std::expected<void, scaler::wrapper::uv::Error> readStart(scaler::wrapper::uv::ReadCallback callback) noexcept;
 
     void readStop() noexcept;
@@ -60,7 +84,9 @@ private:
         scaler::wrapper::uv::TCPSocket,
         scaler::wrapper::openssl::SecureSocket,
         scaler::wrapper::uv::Pipe,
-        WebSocketStream>
+        WebSocketStream,
+        SharedMemoryStream,
+        IOUringStream>
         _socket;
 };
 
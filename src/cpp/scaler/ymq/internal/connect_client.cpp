@@ -10,6 +10,8 @@
 #include "scaler/wrapper/uv/pipe.h"
 #include "scaler/wrapper/uv/socket_address.h"
 #include "scaler/wrapper/uv/tcp.h"
+#include "scaler/ymq/internal/attachment.h"
+#include "scaler/ymq/internal/shared_memory_stream.h"
 #include "scaler/ymq/internal/websocket_stream.h"
 
 namespace scaler {
@@ -79,6 +81,7 @@ void ConnectClient::disconnect() noexcept
 
     _state->_connectRequest.reset();
     _state->_upgradeSocket.reset();
+    _state->_upgradePipe.reset();
     _state->_client.reset();
 }
 
@@ -105,7 +108,8 @@ void ConnectClient::tryConnect(std::shared_ptr<State> state) noexcept
             break;
         }
         case Address::Type::IPC: {
-            auto ipcClient = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(state->_loop, false));
+            // ipc:// connections can receive attachments (see attachment.h).
+            auto ipcClient = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(state->_loop, attachmentsSupported()));
 
             state->_connectRequest = UV_EXIT_ON_ERROR(
                 ipcClient.connect(state->_address.asIPC(), std::bind_front(&ConnectClient::onConnect, state)));
@@ -122,6 +126,15 @@ void ConnectClient::tryConnect(std::shared_ptr<State> state) noexcept
             state->_upgradeSocket = std::move(tcpClient);
             break;
         }
+        case Address::Type::SharedMemory: {
+            auto ipcClient = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(state->_loop, false));
+
+            state->_connectRequest = UV_EXIT_ON_ERROR(ipcClient.connect(
+                state->_address.asSharedMemory().path, std::bind_front(&ConnectClient::onConnectSHM, state)));
+
+            state->_upgradePipe = std::move(ipcClient);
+            break;
+        }
         default: std::unreachable();
     }
 }
@@ -178,6 +191,38 @@ void ConnectClient::onConnectWS(
         });
 }
 
+void ConnectClient::onConnectSHM(
+    std::shared_ptr<State> state, std::expected<void, scaler::wrapper::uv::Error> result) noexcept
+{
+    if (!result.has_value()) {
+        state->_upgradePipe.reset();
+
+        if (result.error() == scaler::wrapper::uv::Error {UV_ECANCELED}) {
+            state->_onConnectCallback(
+                std::unexpected(scaler::ymq::Error(scaler::ymq::Error::ErrorCode::SocketStopRequested)));
+            state->_onConnectCallback = {};
+        } else {
+            retry(std::move(state));
+        }
+        return;
+    }
+
+    scaler::wrapper::uv::Pipe pipe = std::move(state->_upgradePipe.value());
+    state->_upgradePipe.reset();
+
+    SharedMemoryStream::upgradeAsClient(
+        std::move(pipe),
+        [state](std::expected<SharedMemoryStream, scaler::wrapper::uv::Error> shmResult) mutable {
+            if (!shmResult.has_value()) {
+                retry(state);
+                return;
+            }
+
+            state->_onConnectCallback(Client(std::move(shmResult.value())));
+            state->_onConnectCallback = {};
+        });
+}
+
 void ConnectClient::retry(std::shared_ptr<State> state) noexcept
 {
     ++state->_retryTimes;
@@ -64,6 +64,9 @@ private:
         // Holds the TCP socket during the WebSocket upgrade phase (after TCP connect, before upgrade done).
         std::optional<scaler::wrapper::uv::TCPSocket> _upgradeSocket {};
 
+        // Holds the pipe during the shared memory setup (after pipe connect, before the segment is mapped).
+        std::optional<scaler::wrapper::uv::Pipe> _upgradePipe {};
+
         std::optional<scaler::wrapper::openssl::SSLContext> _sslContext;
 
         size_t _maxRetryTimes;
@@ -94,6 +97,11 @@ private:
     static void onConnectWS(
         std::shared_ptr<State> state, std::expected<void, scaler::wrapper::uv::Error> result) noexcept;
 
+    // Called when the underlying pipe for a shared memory address is connected.
+    // Kicks off the shared memory segment setup.
+    static void onConnectSHM(
+        std::shared_ptr<State> state, std::expected<void, scaler::wrapper::uv::Error> result) noexcept;
+
     static void retry(std::shared_ptr<State> state) noexcept;
 };
 
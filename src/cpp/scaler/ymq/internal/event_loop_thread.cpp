@@ -3,18 +3,32 @@
 #include <functional>
 #include <utility>
 
+#include "scaler/logging/logging.h"
 #include "scaler/wrapper/uv/error.h"
 
 namespace scaler {
 namespace ymq {
 namespace internal {
 
-EventLoopThread::EventLoopThread() noexcept
+EventLoopThread::EventLoopThread(IOBackend backend) noexcept
     : _loop(UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init()))
-    , _executeMutex {std::make_unique<std::mutex>()}
+    , _executeQueue {std::make_unique<MPSCQueue<ExecuteTask>>()}
+    , _executeWakeupPending {std::make_unique<std::atomic<bool>>(false)}
     , _executeAsync(UV_EXIT_ON_ERROR(
           scaler::wrapper::uv::Async::init(_loop, std::bind_front(&EventLoopThread::processExecuteCallbacks, this))))
 {
+    if (backend == IOBackend::IOUring) {
+        auto ioUring = IOUring::init(_loop);
+        if (ioUring.has_value()) {
+            _ioUring.emplace(std::move(ioUring.value()));
+        } else {
+            Logger {}.log(
+                Logger::LoggingLevel::warning,
+                "io_uring is not available, falling back to the libuv backend: ",
+                ioUring.error().message());
+        }
+    }
+
     _thread = std::jthread([this]([[maybe_unused]] std::stop_token stop_token) { run(); });
 }
 
@@ -26,20 +40,25 @@ EventLoopThread::~EventLoopThread() noexcept
 
     _thread.join();
 }
+
 scaler::wrapper::uv::Loop& EventLoopThread::loop() noexcept
 {
     return _loop;
 }
 
+IOUring* EventLoopThread::ioUring() noexcept
+{
+    return _ioUring.has_value() ? &_ioUring.value() : nullptr;
+}
+
 void EventLoopThread::executeThreadSafe(Callback callback) noexcept
 {
-    {
-        std::lock_guard<std::mutex> lock(*_executeMutex);
-        _executeQueue.push(std::move(callback));
-    }
+    _executeQueue->push(std::make_unique<ExecuteTask>(std::move(callback)));
 
-    // Wake up the event loop
-    UV_EXIT_ON_ERROR(_executeAsync.send());
+    // Wake up the event loop, unless another producer already did since the loop last processed the queue
+    if (!_executeWakeupPending->exchange(true, std::memory_order_acq_rel)) {
+        UV_EXIT_ON_ERROR(_executeAsync.send());
+    }
 }
 
 void EventLoopThread::run() noexcept
@@ -51,17 +70,10 @@ void EventLoopThread::run() noexcept
 
 void EventLoopThread::processExecuteCallbacks() noexcept
 {
-    std::queue<Callback> callbacks;
-    {
-        std::lock_guard<std::mutex> lock(*_executeMutex);
-        std::swap(callbacks, _executeQueue);
-    }
-
-    // Process all callbacks outside the lock
-    while (!callbacks.empty()) {
-        callbacks.front()();
-        callbacks.pop();
-    }
+    // Reset the flag before consuming, so that callbacks scheduled while processing this batch trigger a new
+    // notification.
+    _executeWakeupPending->exchange(false, std::memory_order_acq_rel);
+    _executeQueue->consumeAll([](std::unique_ptr<ExecuteTask> task) { task->_callback(); });
 }
 
 }  // namespace internal
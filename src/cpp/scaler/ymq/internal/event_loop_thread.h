@@ -1,15 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <expected>
 #include <memory>
-#include <mutex>
 #include <optional>
-#include <queue>
 #include <thread>
+#include <utility>
 
 #include "scaler/utility/move_only_function.h"
 #include "scaler/wrapper/uv/async.h"
 #include "scaler/wrapper/uv/loop.h"
+#include "scaler/ymq/internal/io_uring.h"
+#include "scaler/ymq/internal/mpsc_queue.h"
+#include "scaler/ymq/io_backend.h"
 
 namespace scaler {
 namespace ymq {
@@ -20,7 +23,7 @@ class EventLoopThread {
 public:
     using Callback = scaler::utility::MoveOnlyFunction<void()>;
 
-    EventLoopThread() noexcept;
+    EventLoopThread(IOBackend backend = IOBackend::LibUV) noexcept;
     ~EventLoopThread() noexcept;
 
     EventLoopThread(EventLoopThread&&) noexcept            = default;
@@ -31,6 +34,9 @@ public:
 
     scaler::wrapper::uv::Loop& loop() noexcept;
 
+    // The io_uring instance driven by the loop, or nullptr if the thread runs the libuv backend.
+    IOUring* ioUring() noexcept;
+
     // Schedule the execution of a function within the event loop thread.
     //
     // Thread-safe.
@@ -39,13 +45,25 @@ public:
 private:
     scaler::wrapper::uv::Loop _loop;
 
+    std::optional<IOUring> _ioUring;
+
     std::jthread _thread;
 
-    // executeThreadSafe() add callbacks to a thread-safe queue, and then wake up the the UV loop using an uv::Async
+    // executeThreadSafe() add callbacks to a lock-free queue, and then wake up the the UV loop using an uv::Async
     // notification.
+    //
+    // Only the first producer after the loop processed the queue sends the notification: the others know a wakeup is
+    // already pending and that the loop will process their callback with the same batch.
+
+    struct ExecuteTask: public MPSCQueueNode {
+        Callback _callback;
+
+        ExecuteTask(Callback callback) noexcept: _callback(std::move(callback)) {}
+    };
 
-    std::unique_ptr<std::mutex> _executeMutex;
-    std::queue<Callback> _executeQueue;
+    // Heap-allocated as the queue and the atomic are not movable.
+    std::unique_ptr<MPSCQueue<ExecuteTask>> _executeQueue;
+    std::unique_ptr<std::atomic<bool>> _executeWakeupPending;
     scaler::wrapper::uv::Async _executeAsync;
 
     void initialize() noexcept;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <uv.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "scaler/utility/move_only_function.h"
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/loop.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// An io_uring instance, driven by a libuv event loop (see IOBackend::IOUring).
+//
+// Operations are queued in user space and submitted all at once, with a single io_uring_enter() syscall per loop
+// iteration, right before libuv polls for IOs. Completions are processed when the ring's file descriptor becomes
+// readable.
+//
+// Only supported on Linux, other platforms fail with UV_ENOTSUP.
+class IOUring {
+public:
+    using OperationID = uint64_t;
+
+    // Called with the number of bytes sent.
+    using SendCallback = scaler::utility::MoveOnlyFunction<void(std::expected<size_t, scaler::wrapper::uv::Error>)>;
+
+    struct Send {
+        // The buffers' content must remain valid until the callback is called.
+        std::span<const std::span<const uint8_t>> _buffers;
+        SendCallback _callback;
+    };
+
+    static std::expected<IOUring, scaler::wrapper::uv::Error> init(scaler::wrapper::uv::Loop& loop) noexcept;
+
+    ~IOUring() noexcept;
+
+    IOUring(const IOUring&)            = delete;
+    IOUring& operator=(const IOUring&) = delete;
+
+    IOUring(IOUring&&) noexcept;
+    IOUring& operator=(IOUring&&) noexcept;
+
+    // Receive from the socket into the ring's provided buffers, until cancelled or the connection ends.
+    //
+    // Each received chunk is passed to the callback, followed by a final error: UV_EOF if the peer shut its sending
+    // side down, UV_ECANCELED if cancelled. The chunks are only valid during the execution of the callback.
+    OperationID recv(uv_os_fd_t socket, scaler::wrapper::uv::ReadCallback callback) noexcept;
+
+    // Send the buffers of each Send in order, as a chain of linked operations: a send only starts once the previous
+    // one completed.
+    //
+    // Each send is expected to complete in full. If one fails or is short, the following ones complete with
+    // UV_ECANCELED.
+    void sendLinked(uv_os_fd_t socket, std::vector<Send> sends) noexcept;
+
+    // Cancel a pending operation. Does nothing if it already completed.
+    void cancel(OperationID operation) noexcept;
+
+    // Cancel all the pending operations on the socket.
+    void cancelAll(uv_os_fd_t socket) noexcept;
+
+private:
+    // Holds the platform specific state, see io_uring_linux.cpp.
+    struct State;
+
+    explicit IOUring(std::unique_ptr<State> state) noexcept;
+
+    std::unique_ptr<State> _state;
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,588 @@
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include "scaler/wrapper/uv/poll.h"
+#include "scaler/wrapper/uv/prepare.h"
+#include "scaler/ymq/configuration.h"
+#include "scaler/ymq/internal/io_uring.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+namespace {
+
+static_assert(ioUringMaxLinkedWrites <= ioUringQueueDepth, "a chain must fit in the submission queue");
+
+// The user data of the submissions we don't track the completion of (cancellations, provided buffers).
+constexpr IOUring::OperationID untrackedOperation = 0;
+
+// The group of the receive buffers provided to the kernel.
+constexpr uint16_t recvBufferGroup = 0;
+
+// glibc doesn't provide wrappers for the io_uring syscalls.
+
+int ioUringSetup(unsigned entries, io_uring_params* params) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+// Multishot receives were introduced in Linux 6.0.
+bool kernelSupportsMultishotRecv() noexcept
+{
+    utsname name {};
+    if (::uname(&name) != 0) {
+        return false;
+    }
+
+    int major = 0;
+    if (std::sscanf(name.release, "%d.", &major) != 1) {
+        return false;
+    }
+
+    return major >= 6;
+}
+
+scaler::wrapper::uv::Error lastError() noexcept
+{
+    return scaler::wrapper::uv::Error {uv_translate_sys_error(errno)};
+}
+
+// io_uring reports errors as negative errno values.
+scaler::wrapper::uv::Error completionError(int32_t result) noexcept
+{
+    return scaler::wrapper::uv::Error {uv_translate_sys_error(-result)};
+}
+
+// A memory mapping, unmapped on destruction.
+class Mapping {
+public:
+    Mapping() noexcept = default;
+
+    Mapping(void* data, size_t size) noexcept: _data(data), _size(size) {}
+
+    ~Mapping() noexcept
+    {
+        if (_data != nullptr) {
+            ::munmap(_data, _size);
+        }
+    }
+
+    Mapping(const Mapping&)            = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    Mapping(Mapping&& other) noexcept: _data(std::exchange(other._data, nullptr)), _size(other._size) {}
+
+    Mapping& operator=(Mapping&& other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    static std::expected<Mapping, scaler::wrapper::uv::Error> map(size_t size, int fd, off_t offset) noexcept
+    {
+        const int flags = fd < 0 ? MAP_PRIVATE | MAP_ANONYMOUS : MAP_SHARED | MAP_POPULATE;
+
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, offset);
+        if (data == MAP_FAILED) {
+            return std::unexpected {lastError()};
+        }
+
+        return Mapping {data, size};
+    }
+
+    template <typename T>
+    T* at(size_t offset) const noexcept
+    {
+        return reinterpret_cast<T*>(static_cast<uint8_t*>(_data) + offset);
+    }
+
+private:
+    void* _data {nullptr};
+    size_t _size {0};
+};
+
+}  // namespace
+
+struct IOUring::State {
+    struct RecvOperation {
+        uv_os_fd_t _socket;
+        scaler::wrapper::uv::ReadCallback _callback;
+        bool _cancelled {false};
+    };
+
+    struct SendOperation {
+        std::vector<iovec> _iovecs;
+        msghdr _message {};
+        SendCallback _callback;
+    };
+
+    using Operation = std::variant<RecvOperation, SendOperation>;
+
+    // A prepared submission queue entry, not yet copied to the submission ring.
+    struct PendingSubmission {
+        io_uring_sqe _entry;
+
+        // The last entry of a chain of linked operations, or a standalone operation.
+        bool _endsChain;
+    };
+
+    int _fd;
+
+    Mapping _rings;
+    Mapping _entries;
+
+    std::atomic_ref<unsigned> _sqHead;
+    std::atomic_ref<unsigned> _sqTail;
+    const unsigned _sqMask;
+    const unsigned _sqSize;
+    unsigned* _sqArray;
+    std::atomic_ref<unsigned> _sqFlags;
+    io_uring_sqe* _sqEntries;
+
+    std::atomic_ref<unsigned> _cqHead;
+    std::atomic_ref<unsigned> _cqTail;
+    const unsigned _cqMask;
+    io_uring_cqe* _cqEntries;
+
+    // The receive buffers, the kernel picks one of the provided ones for each received chunk.
+    Mapping _recvBuffers;
+
+    // Node-based, the operations keep a stable address while in flight.
+    std::unordered_map<OperationID, Operation> _operations {};
+    OperationID _nextOperationID {untrackedOperation + 1};
+
+    std::deque<PendingSubmission> _pendingSubmissions {};
+
+    std::optional<scaler::wrapper::uv::Poll> _poll {};
+    std::optional<scaler::wrapper::uv::Prepare> _prepare {};
+
+    State(int fd, const io_uring_params& params, Mapping rings, Mapping entries) noexcept
+        : _fd(fd)
+        , _rings(std::move(rings))
+        , _entries(std::move(entries))
+        , _sqHead(*_rings.at<unsigned>(params.sq_off.head))
+        , _sqTail(*_rings.at<unsigned>(params.sq_off.tail))
+        , _sqMask(*_rings.at<unsigned>(params.sq_off.ring_mask))
+        , _sqSize(*_rings.at<unsigned>(params.sq_off.ring_entries))
+        , _sqArray(_rings.at<unsigned>(params.sq_off.array))
+        , _sqFlags(*_rings.at<unsigned>(params.sq_off.flags))
+        , _sqEntries(_entries.at<io_uring_sqe>(0))
+        , _cqHead(*_rings.at<unsigned>(params.cq_off.head))
+        , _cqTail(*_rings.at<unsigned>(params.cq_off.tail))
+        , _cqMask(*_rings.at<unsigned>(params.cq_off.ring_mask))
+        , _cqEntries(_rings.at<io_uring_cqe>(params.cq_off.cqes))
+    {
+    }
+
+    ~State() noexcept
+    {
+        // The handles must stop polling the file descriptor before it's closed. Closing the ring cancels the pending
+        // operations.
+        _poll.reset();
+        _prepare.reset();
+
+        ::close(_fd);
+    }
+
+    State(const State&)            = delete;
+    State& operator=(const State&) = delete;
+
+    std::expected<void, scaler::wrapper::uv::Error> allocateRecvBuffers() noexcept;
+
+    OperationID addOperation(Operation operation) noexcept;
+
+    void prepareRecv(OperationID id, uv_os_fd_t socket) noexcept;
+
+    // Hands receive buffers to the kernel.
+    void provideRecvBuffers(uint16_t firstBufferID, uint16_t count) noexcept;
+
+    // Copies the pending submissions to the submission ring, and submits them.
+    void submit() noexcept;
+
+    void processCompletions() noexcept;
+
+    void processCompletion(const io_uring_cqe& completion) noexcept;
+
+    void processRecvCompletion(OperationID id, RecvOperation& operation, const io_uring_cqe& completion) noexcept;
+};
+
+std::expected<void, scaler::wrapper::uv::Error> IOUring::State::allocateRecvBuffers() noexcept
+{
+    auto buffers = Mapping::map(ioUringRecvBufferCount * ioUringRecvBufferSize, -1, 0);
+    if (!buffers.has_value()) {
+        return std::unexpected {buffers.error()};
+    }
+    _recvBuffers = std::move(buffers.value());
+
+    // Submitted before any receive operation.
+    provideRecvBuffers(0, ioUringRecvBufferCount);
+
+    return {};
+}
+
+IOUring::OperationID IOUring::State::addOperation(Operation operation) noexcept
+{
+    const OperationID id = _nextOperationID++;
+    _operations.emplace(id, std::move(operation));
+    return id;
+}
+
+void IOUring::State::prepareRecv(OperationID id, uv_os_fd_t socket) noexcept
+{
+    io_uring_sqe entry {};
+    entry.opcode    = IORING_OP_RECV;
+    entry.fd        = socket;
+    entry.ioprio    = IORING_RECV_MULTISHOT;
+    entry.flags     = IOSQE_BUFFER_SELECT;
+    entry.buf_group = recvBufferGroup;
+    entry.user_data = id;
+
+    _pendingSubmissions.push_back(PendingSubmission {entry, true});
+}
+
+void IOUring::State::provideRecvBuffers(uint16_t firstBufferID, uint16_t count) noexcept
+{
+    // The buffers are consecutive in memory, a single entry provides all of them.
+    io_uring_sqe entry {};
+    entry.opcode    = IORING_OP_PROVIDE_BUFFERS;
+    entry.fd        = count;
+    entry.addr      = reinterpret_cast<uint64_t>(_recvBuffers.at<uint8_t>(firstBufferID * ioUringRecvBufferSize));
+    entry.len       = ioUringRecvBufferSize;
+    entry.off       = firstBufferID;
+    entry.buf_group = recvBufferGroup;
+    entry.user_data = untrackedOperation;
+
+    _pendingSubmissions.push_back(PendingSubmission {entry, true});
+}
+
+void IOUring::State::submit() noexcept
+{
+    while (!_pendingSubmissions.empty()) {
+        // Copy as many complete chains as fit in the ring. The kernel ends a chain at the end of a submission.
+        unsigned tail            = _sqTail.load(std::memory_order_relaxed);
+        const unsigned available = _sqSize - (tail - _sqHead.load(std::memory_order_acquire));
+
+        size_t copied = 0;
+        for (size_t chainStart = 0; chainStart < _pendingSubmissions.size();) {
+            size_t chainEnd = chainStart;
+            while (!_pendingSubmissions[chainEnd]._endsChain) {
+                ++chainEnd;
+            }
+
+            if (chainEnd + 1 > available) {
+                break;
+            }
+
+            for (size_t i = chainStart; i <= chainEnd; ++i) {
+                const unsigned index = tail & _sqMask;
+                _sqEntries[index]    = _pendingSubmissions[i]._entry;
+                _sqArray[index]      = index;
+                ++tail;
+            }
+
+            copied     = chainEnd + 1;
+            chainStart = copied;
+        }
+
+        _pendingSubmissions.erase(_pendingSubmissions.begin(), _pendingSubmissions.begin() + copied);
+        _sqTail.store(tail, std::memory_order_release);
+
+        const unsigned toSubmit = tail - _sqHead.load(std::memory_order_acquire);
+        if (toSubmit == 0) {
+            return;
+        }
+
+        const int submitted = ioUringEnter(_fd, toSubmit, 0, 0);
+        if (submitted < 0) {
+            // Likely EAGAIN or EBUSY, the kernel is out of resources or the completion queue is full. The entries stay
+            // in the ring and are submitted on the next loop iteration, once the completions have been processed.
+            return;
+        }
+    }
+}
+
+void IOUring::State::processCompletions() noexcept
+{
+    for (;;) {
+        unsigned head       = _cqHead.load(std::memory_order_relaxed);
+        const unsigned tail = _cqTail.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            // Completions that didn't fit in the ring are only moved to it when entering the kernel.
+            if ((_sqFlags.load(std::memory_order_relaxed) & IORING_SQ_CQ_OVERFLOW) == 0) {
+                return;
+            }
+
+            if (ioUringEnter(_fd, 0, 0, IORING_ENTER_GETEVENTS) < 0) {
+                return;
+            }
+
+            continue;
+        }
+
+        while (head != tail) {
+            // Free the entry before processing it, as the callbacks might submit new operations.
+            const io_uring_cqe completion = _cqEntries[head & _cqMask];
+            _cqHead.store(++head, std::memory_order_release);
+
+            processCompletion(completion);
+        }
+    }
+}
+
+void IOUring::State::processCompletion(const io_uring_cqe& completion) noexcept
+{
+    const OperationID id = completion.user_data;
+    if (id == untrackedOperation) {
+        return;
+    }
+
+    auto it = _operations.find(id);
+    assert(it != _operations.end());
+
+    if (auto* recv = std::get_if<RecvOperation>(&it->second)) {
+        processRecvCompletion(id, *recv, completion);
+        return;
+    }
+
+    SendCallback callback = std::move(std::get<SendOperation>(it->second)._callback);
+    _operations.erase(it);
+
+    if (completion.res < 0) {
+        callback(std::unexpected {completionError(completion.res)});
+    } else {
+        callback(static_cast<size_t>(completion.res));
+    }
+}
+
+void IOUring::State::processRecvCompletion(
+    OperationID id, RecvOperation& operation, const io_uring_cqe& completion) noexcept
+{
+    const bool hasMore = (completion.flags & IORING_CQE_F_MORE) != 0;
+
+    if (completion.res > 0) {
+        assert(completion.flags & IORING_CQE_F_BUFFER);
+        const uint16_t bufferID = static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+
+        const std::span<const uint8_t> data {
+            _recvBuffers.at<uint8_t>(bufferID * ioUringRecvBufferSize), static_cast<size_t>(completion.res)};
+        operation._callback(data);
+
+        provideRecvBuffers(bufferID, 1);
+    } else if (completion.res != -ENOBUFS) {
+        // The peer shut its sending side down (0), the receive failed or got cancelled.
+        assert(!hasMore);
+
+        auto callback = std::move(operation._callback);
+        _operations.erase(id);
+
+        callback(std::unexpected {
+            completion.res == 0 ? scaler::wrapper::uv::Error {UV_EOF} : completionError(completion.res)});
+        return;
+    }
+
+    if (hasMore) {
+        return;
+    }
+
+    // The kernel stops a multishot receive when it runs out of buffers (ENOBUFS), or can't post completions anymore.
+    // The buffers handed back since are provided before the receive is submitted again.
+    if (operation._cancelled) {
+        auto callback = std::move(operation._callback);
+        _operations.erase(id);
+
+        callback(std::unexpected {scaler::wrapper::uv::Error {UV_ECANCELED}});
+        return;
+    }
+
+    prepareRecv(id, operation._socket);
+}
+
+std::expected<IOUring, scaler::wrapper::uv::Error> IOUring::init(scaler::wrapper::uv::Loop& loop) noexcept
+{
+    if (!kernelSupportsMultishotRecv()) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+    }
+
+    io_uring_params params {};
+    params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL;
+    params.cq_entries = ioUringQueueDepth * 8;  // multishot receives post many completions per submission
+
+    const int fd = ioUringSetup(ioUringQueueDepth, &params);
+    if (fd < 0) {
+        return std::unexpected {lastError()};
+    }
+
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_NODROP) == 0) {
+        ::close(fd);
+        return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+    }
+
+    const size_t ringsSize = std::max(
+        params.sq_off.array + params.sq_entries * sizeof(unsigned),
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+
+    auto rings = Mapping::map(ringsSize, fd, IORING_OFF_SQ_RING);
+    if (!rings.has_value()) {
+        ::close(fd);
+        return std::unexpected {rings.error()};
+    }
+
+    auto entries = Mapping::map(params.sq_entries * sizeof(io_uring_sqe), fd, IORING_OFF_SQES);
+    if (!entries.has_value()) {
+        ::close(fd);
+        return std::unexpected {entries.error()};
+    }
+
+    // Closes the ring on failure from now on.
+    auto state = std::make_unique<State>(fd, params, std::move(rings.value()), std::move(entries.value()));
+
+    if (auto result = state->allocateRecvBuffers(); !result.has_value()) {
+        return std::unexpected {result.error()};
+    }
+
+    auto poll = scaler::wrapper::uv::Poll::init(loop, fd);
+    if (!poll.has_value()) {
+        return std::unexpected {poll.error()};
+    }
+    state->_poll.emplace(std::move(poll.value()));
+
+    auto prepare = scaler::wrapper::uv::Prepare::init(loop);
+    if (!prepare.has_value()) {
+        return std::unexpected {prepare.error()};
+    }
+    state->_prepare.emplace(std::move(prepare.value()));
+
+    State* statePtr = state.get();
+
+    auto pollResult = state->_poll->start(UV_READABLE, [statePtr](std::expected<int, scaler::wrapper::uv::Error>) {
+        statePtr->processCompletions();
+    });
+    if (!pollResult.has_value()) {
+        return std::unexpected {pollResult.error()};
+    }
+
+    auto prepareResult = state->_prepare->start([statePtr]() { statePtr->submit(); });
+    if (!prepareResult.has_value()) {
+        return std::unexpected {prepareResult.error()};
+    }
+
+    return IOUring {std::move(state)};
+}
+
+IOUring::IOUring(std::unique_ptr<State> state) noexcept: _state(std::move(state))
+{
+}
+
+IOUring::~IOUring() noexcept = default;
+
+IOUring::IOUring(IOUring&&) noexcept = default;
+
+IOUring& IOUring::operator=(IOUring&&) noexcept = default;
+
+IOUring::OperationID IOUring::recv(uv_os_fd_t socket, scaler::wrapper::uv::ReadCallback callback) noexcept
+{
+    const OperationID id = _state->addOperation(State::RecvOperation {socket, std::move(callback)});
+    _state->prepareRecv(id, socket);
+    return id;
+}
+
+void IOUring::sendLinked(uv_os_fd_t socket, std::vector<Send> sends) noexcept
+{
+    assert(!sends.empty() && sends.size() <= ioUringMaxLinkedWrites);
+
+    for (size_t i = 0; i < sends.size(); ++i) {
+        State::SendOperation operation {};
+
+        operation._iovecs.reserve(sends[i]._buffers.size());
+        for (const auto& buffer: sends[i]._buffers) {
+            operation._iovecs.push_back(iovec {const_cast<uint8_t*>(buffer.data()), buffer.size()});
+        }
+        operation._callback = std::move(sends[i]._callback);
+
+        const OperationID id = _state->addOperation(std::move(operation));
+
+        // The message header must be at its final address, as the kernel reads it when the send starts.
+        auto& sendOperation               = std::get<State::SendOperation>(_state->_operations.at(id));
+        sendOperation._message.msg_iov    = sendOperation._iovecs.data();
+        sendOperation._message.msg_iovlen = sendOperation._iovecs.size();
+
+        const bool isLast = i + 1 == sends.size();
+
+        io_uring_sqe entry {};
+        entry.opcode = IORING_OP_SENDMSG;
+        entry.fd     = socket;
+        entry.addr   = reinterpret_cast<uint64_t>(&sendOperation._message);
+        entry.len    = 1;
+
+        // Makes the kernel retry short sends, so that these don't break the chain.
+        entry.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        entry.flags     = isLast ? 0 : IOSQE_IO_LINK;
+        entry.user_data = id;
+
+        _state->_pendingSubmissions.push_back(State::PendingSubmission {entry, isLast});
+    }
+}
+
+void IOUring::cancel(OperationID operation) noexcept
+{
+    auto it = _state->_operations.find(operation);
+    if (it == _state->_operations.end()) {
+        return;
+    }
+
+    if (auto* recv = std::get_if<State::RecvOperation>(&it->second)) {
+        recv->_cancelled = true;
+    }
+
+    io_uring_sqe entry {};
+    entry.opcode    = IORING_OP_ASYNC_CANCEL;
+    entry.addr      = operation;
+    entry.user_data = untrackedOperation;
+
+    _state->_pendingSubmissions.push_back(State::PendingSubmission {entry, true});
+}
+
+void IOUring::cancelAll(uv_os_fd_t socket) noexcept
+{
+    for (auto& [id, operation]: _state->_operations) {
+        if (auto* recv = std::get_if<State::RecvOperation>(&operation); recv != nullptr && recv->_socket == socket) {
+            recv->_cancelled = true;
+        }
+    }
+
+    io_uring_sqe entry {};
+    entry.opcode       = IORING_OP_ASYNC_CANCEL;
+    entry.fd           = socket;
+    entry.cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    entry.user_data    = untrackedOperation;
+
+    _state->_pendingSubmissions.push_back(State::PendingSubmission {entry, true});
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,296 @@
+#include "scaler/ymq/internal/io_uring_stream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+#include "scaler/ymq/configuration.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+IOUringStream::State::State(IOUring& ring, scaler::wrapper::uv::TCPSocket socket) noexcept
+    : _ring(ring), _socket(std::move(socket)), _fd(UV_EXIT_ON_ERROR(_socket.fileno()))
+{
+}
+
+IOUringStream::IOUringStream(IOUring& ring, scaler::wrapper::uv::TCPSocket socket) noexcept
+    : _state(std::make_shared<State>(ring, std::move(socket)))
+{
+}
+
+IOUringStream::~IOUringStream() noexcept
+{
+    if (_state != nullptr) {
+        close(_state);
+    }
+}
+
+std::expected<void, scaler::wrapper::uv::Error> IOUringStream::write(
+    std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept
+{
+    if (_state->_closed || _state->_shutdown) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EPIPE}};
+    }
+
+    if (_state->_writeError.has_value()) {
+        callback(std::unexpected {_state->_writeError.value()});
+        return {};
+    }
+
+    size_t size = 0;
+    for (const auto& buffer: buffers) {
+        size += buffer.size();
+    }
+
+    _state->_writes.push_back(PendingWrite {{buffers.begin(), buffers.end()}, size, std::move(callback)});
+
+    if (_state->_inFlight == 0) {
+        submitWrites(_state);
+    }
+
+    return {};
+}
+
+std::expected<void, scaler::wrapper::uv::Error> IOUringStream::readStart(
+    scaler::wrapper::uv::ReadCallback callback) noexcept
+{
+    if (_state->_closed) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EBADF}};
+    }
+
+    _state->_readCallback = std::make_shared<scaler::wrapper::uv::ReadCallback>(std::move(callback));
+
+    if (!_state->_recvOperation.has_value()) {
+        ++_state->_pendingRecvs;
+        _state->_recvOperation = _state->_ring.recv(
+            _state->_fd, std::bind_front(&IOUringStream::onRecv, _state, ++_state->_recvGeneration));
+    }
+
+    return {};
+}
+
+void IOUringStream::readStop() noexcept
+{
+    _state->_readCallback.reset();
+
+    if (_state->_recvOperation.has_value()) {
+        _state->_ring.cancel(_state->_recvOperation.value());
+        _state->_recvOperation.reset();
+        ++_state->_recvGeneration;
+    }
+}
+
+std::expected<void, scaler::wrapper::uv::Error> IOUringStream::shutdown(
+    scaler::wrapper::uv::ShutdownCallback callback) noexcept
+{
+    if (_state->_closed || _state->_shutdown) {
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EPIPE}};
+    }
+
+    _state->_shutdown         = true;
+    _state->_shutdownCallback = std::move(callback);
+
+    if (_state->_inFlight == 0) {
+        startShutdown(_state);
+    }
+
+    return {};
+}
+
+std::expected<void, scaler::wrapper::uv::Error> IOUringStream::closeReset() noexcept
+{
+    _state->_closeReset = true;
+    close(_state);
+    onOperationCompleted(_state);
+
+    return {};
+}
+
+std::expected<void, scaler::wrapper::uv::Error> IOUringStream::nodelay(bool enable) noexcept
+{
+    return _state->_socket.nodelay(enable);
+}
+
+void IOUringStream::submitWrites(std::shared_ptr<State> state) noexcept
+{
+    assert(state->_inFlight == 0 && !state->_writes.empty());
+
+    const size_t count = std::min(state->_writes.size(), ioUringMaxLinkedWrites);
+
+    std::vector<IOUring::Send> sends {};
+    sends.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        sends.push_back(IOUring::Send {
+            state->_writes[i]._buffers,
+            std::bind_front(&IOUringStream::onSendCompleted, state),
+        });
+    }
+
+    state->_inFlight = count;
+    state->_ring.sendLinked(state->_fd, std::move(sends));
+}
+
+void IOUringStream::onSendCompleted(
+    std::shared_ptr<State> state, std::expected<size_t, scaler::wrapper::uv::Error> result) noexcept
+{
+    assert(state->_inFlight > 0);
+
+    PendingWrite& write = state->_writes[state->_chainPosition];
+
+    --state->_inFlight;
+
+    if (result.has_value() && result.value() == write._size && !state->_chainBroken) {
+        // The previous sends of the chain all completed, the write is the first one.
+        assert(state->_chainPosition == 0);
+
+        scaler::wrapper::uv::WriteCallback callback = std::move(write._callback);
+        state->_writes.pop_front();
+
+        callback({});
+    } else if (result.has_value()) {
+        // Short send, the rest of the write is sent with the next chain.
+        size_t sent = result.value();
+        write._size -= sent;
+
+        auto& buffers = write._buffers;
+        while (sent > 0) {
+            const size_t consumed = std::min(sent, buffers.front().size());
+            buffers.front()       = buffers.front().subspan(consumed);
+            sent -= consumed;
+
+            if (buffers.front().empty()) {
+                buffers.erase(buffers.begin());
+            }
+        }
+
+        state->_chainBroken = true;
+        ++state->_chainPosition;
+    } else {
+        // After a broken chain, the following sends are cancelled by the kernel and will be sent again.
+        if (!state->_chainBroken || result.error() != scaler::wrapper::uv::Error {UV_ECANCELED}) {
+            if (!state->_writeError.has_value()) {
+                state->_writeError = result.error();
+            }
+        }
+
+        state->_chainBroken = true;
+        ++state->_chainPosition;
+    }
+
+    if (state->_inFlight == 0) {
+        onChainCompleted(state);
+        onOperationCompleted(std::move(state));
+    }
+}
+
+void IOUringStream::onChainCompleted(std::shared_ptr<State> state) noexcept
+{
+    // A write callback might already have submitted the next chain.
+    if (state->_inFlight > 0) {
+        return;
+    }
+
+    state->_chainPosition = 0;
+    state->_chainBroken   = false;
+
+    if (state->_closed && !state->_writeError.has_value()) {
+        state->_writeError = scaler::wrapper::uv::Error {UV_ECANCELED};
+    }
+
+    if (state->_writeError.has_value()) {
+        std::deque<PendingWrite> writes = std::exchange(state->_writes, {});
+        for (PendingWrite& write: writes) {
+            write._callback(std::unexpected {state->_writeError.value()});
+        }
+    }
+
+    if (!state->_writes.empty()) {
+        submitWrites(std::move(state));
+    } else if (state->_shutdownCallback.has_value()) {
+        startShutdown(std::move(state));
+    }
+}
+
+void IOUringStream::onRecv(
+    std::shared_ptr<State> state,
+    uint64_t generation,
+    std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) noexcept
+{
+    if (!result.has_value()) {
+        --state->_pendingRecvs;
+        onOperationCompleted(state);
+    }
+
+    if (generation != state->_recvGeneration) {
+        return;  // stopped reading
+    }
+
+    if (!result.has_value()) {
+        state->_recvOperation.reset();
+    }
+
+    if (state->_readCallback == nullptr) {
+        return;
+    }
+
+    std::shared_ptr<scaler::wrapper::uv::ReadCallback> callback = state->_readCallback;
+    (*callback)(std::move(result));
+}
+
+void IOUringStream::startShutdown(std::shared_ptr<State> state) noexcept
+{
+    assert(state->_inFlight == 0 && state->_writes.empty());
+
+    auto callback =
+        std::make_shared<scaler::wrapper::uv::ShutdownCallback>(std::move(state->_shutdownCallback.value()));
+    state->_shutdownCallback.reset();
+
+    if (state->_closed) {
+        (*callback)(std::unexpected {scaler::wrapper::uv::Error {UV_ECANCELED}});
+        return;
+    }
+
+    if (state->_writeError.has_value()) {
+        (*callback)(std::unexpected {state->_writeError.value()});
+        return;
+    }
+
+    // libuv's write queue is empty, the socket can directly be shut down.
+    auto result = state->_socket.shutdown(
+        [callback](std::expected<void, scaler::wrapper::uv::Error> result) mutable { (*callback)(std::move(result)); });
+    if (!result.has_value()) {
+        (*callback)(std::unexpected {result.error()});
+    }
+}
+
+void IOUringStream::close(std::shared_ptr<State> state) noexcept
+{
+    if (state->_closed) {
+        return;
+    }
+
+    state->_closed = true;
+
+    state->_readCallback.reset();
+    state->_recvOperation.reset();
+    ++state->_recvGeneration;
+
+    state->_ring.cancelAll(state->_fd);
+}
+
+void IOUringStream::onOperationCompleted(std::shared_ptr<State> state) noexcept
+{
+    if (!state->_closeReset || state->_pendingRecvs > 0 || state->_inFlight > 0) {
+        return;
+    }
+
+    state->_closeReset = false;
+    (void)state->_socket.closeReset();
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/tcp.h"
+#include "scaler/ymq/internal/io_uring.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// A connected TCP socket whose reads and writes go through an io_uring instance instead of libuv (see
+// IOBackend::IOUring).
+//
+// libuv keeps owning the socket, but no longer polls it.
+class IOUringStream {
+public:
+    // Takes over the IOs of a connected socket. The ring must outlive the stream.
+    IOUringStream(IOUring& ring, scaler::wrapper::uv::TCPSocket socket) noexcept;
+
+    // Cancels the pending operations. The socket is closed once these completed.
+    ~IOUringStream() noexcept;
+
+    IOUringStream(const IOUringStream&)            = delete;
+    IOUringStream& operator=(const IOUringStream&) = delete;
+
+    IOUringStream(IOUringStream&&) noexcept            = default;
+    IOUringStream& operator=(IOUringStream&&) noexcept = default;
+
+    // The buffers' content must remain valid until the callback is called.
+    //
+    // The writes issued while the previous ones are in flight are submitted together once these complete, as a chain
+    // of linked sends.
+    std::expected<void, scaler::wrapper::uv::Error> write(
+        std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept;
+
+    std::expected<void, scaler::wrapper::uv::Error> readStart(scaler::wrapper::uv::ReadCallback callback) noexcept;
+
+    // The data received after this call is discarded.
+    void readStop() noexcept;
+
+    // Shut the sending side down once the pending writes completed.
+    std::expected<void, scaler::wrapper::uv::Error> shutdown(scaler::wrapper::uv::ShutdownCallback callback) noexcept;
+
+    // Send a RST packet to the remote once the pending operations are cancelled.
+    std::expected<void, scaler::wrapper::uv::Error> closeReset() noexcept;
+
+    // See uv_tcp_nodelay
+    std::expected<void, scaler::wrapper::uv::Error> nodelay(bool enable) noexcept;
+
+private:
+    struct PendingWrite {
+        // The part of the buffers that is still to be sent.
+        std::vector<std::span<const uint8_t>> _buffers;
+        size_t _size;
+
+        scaler::wrapper::uv::WriteCallback _callback;
+    };
+
+    // State is heap-allocated to provide a stable memory for callbacks if the stream is std::move'd, and is kept alive
+    // by the pending operations.
+
+    struct State {
+        IOUring& _ring;
+        scaler::wrapper::uv::TCPSocket _socket;
+        uv_os_fd_t _fd;
+
+        // The first _inFlight writes are being sent as a chain of linked sends.
+        std::deque<PendingWrite> _writes {};
+        size_t _inFlight {0};
+
+        // The write of the next completion of the chain.
+        size_t _chainPosition {0};
+
+        // Set once a send of the chain failed or was short, the following ones are then cancelled by the kernel.
+        bool _chainBroken {false};
+
+        std::optional<scaler::wrapper::uv::Error> _writeError {};
+
+        // Shared so that it outlives a readStop() done from the callback itself.
+        std::shared_ptr<scaler::wrapper::uv::ReadCallback> _readCallback {};
+        std::optional<IOUring::OperationID> _recvOperation {};
+
+        // Incremented when the receive operation is replaced, to ignore the completions of the previous one.
+        uint64_t _recvGeneration {0};
+
+        // The receive operations that didn't complete yet, including the replaced ones.
+        size_t _pendingRecvs {0};
+
+        // Set once shutdown() is called, the callback is kept until the pending writes completed.
+        bool _shutdown {false};
+        std::optional<scaler::wrapper::uv::ShutdownCallback> _shutdownCallback {};
+
+        bool _closed {false};
+
+        // Set by closeReset() until the RST is sent.
+        bool _closeReset {false};
+
+        State(IOUring& ring, scaler::wrapper::uv::TCPSocket socket) noexcept;
+    };
+
+    static void submitWrites(std::shared_ptr<State> state) noexcept;
+
+    static void onSendCompleted(
+        std::shared_ptr<State> state, std::expected<size_t, scaler::wrapper::uv::Error> result) noexcept;
+
+    // Called once all the sends of the chain completed.
+    static void onChainCompleted(std::shared_ptr<State> state) noexcept;
+
+    static void onRecv(
+        std::shared_ptr<State> state,
+        uint64_t generation,
+        std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) noexcept;
+
+    static void startShutdown(std::shared_ptr<State> state) noexcept;
+
+    // Cancel the pending operations.
+    static void close(std::shared_ptr<State> state) noexcept;
+
+    // Reset the connection if requested, once the kernel no longer references the socket.
+    static void onOperationCompleted(std::shared_ptr<State> state) noexcept;
+
+    std::shared_ptr<State> _state;
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
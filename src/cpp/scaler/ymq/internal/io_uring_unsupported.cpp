@@ -0,0 +1,48 @@
+#include "scaler/ymq/internal/io_uring.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// io_uring is only available on Linux.
+
+struct IOUring::State {};
+
+std::expected<IOUring, scaler::wrapper::uv::Error> IOUring::init(scaler::wrapper::uv::Loop&) noexcept
+{
+    return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+}
+
+IOUring::IOUring(std::unique_ptr<State> state) noexcept: _state(std::move(state))
+{
+}
+
+IOUring::~IOUring() noexcept = default;
+
+IOUring::IOUring(IOUring&&) noexcept = default;
+
+IOUring& IOUring::operator=(IOUring&&) noexcept = default;
+
+IOUring::OperationID IOUring::recv(uv_os_fd_t, scaler::wrapper::uv::ReadCallback) noexcept
+{
+    std::unreachable();
+}
+
+void IOUring::sendLinked(uv_os_fd_t, std::vector<Send>) noexcept
+{
+    std::unreachable();
+}
+
+void IOUring::cancel(OperationID) noexcept
+{
+    std::unreachable();
+}
+
+void IOUring::cancelAll(uv_os_fd_t) noexcept
+{
+    std::unreachable();
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
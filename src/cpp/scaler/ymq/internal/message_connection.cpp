@@ -1,5 +1,7 @@
 #include "scaler/ymq/internal/message_connection.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -9,6 +11,7 @@
 
 #include "scaler/ymq/buffered_bytes.h"
 #include "scaler/ymq/configuration.h"
+#include "scaler/ymq/internal/attachment.h"
 
 namespace scaler {
 namespace ymq {
@@ -35,12 +38,24 @@ MessageConnection::~MessageConnection() noexcept
         shutdownClient();
     }
 
+    _writeQueue->_connection = nullptr;
+
     // Fail all pending send operations
-    while (!_sendPending.empty()) {
-        auto& callback = _sendPending.front()._onSendDone;
-        callback(std::unexpected(Error {Error::ErrorCode::SocketStopRequested}));
-        _sendPending.pop();
+    for (auto* sendPending: {&_sendPendingHighPriority, &_sendPending}) {
+        while (!sendPending->empty()) {
+            auto& callback = sendPending->front()._onSendDone;
+            callback(std::unexpected(Error {Error::ErrorCode::SocketStopRequested}));
+            sendPending->pop_front();
+        }
     }
+
+    // Fails the fragmented message, unless its last fragment is still being written.
+    _sendFragmenting.reset();
+}
+
+MessageConnection::FragmentedSendOperation::~FragmentedSendOperation() noexcept
+{
+    _operation._onSendDone(_result.value_or(std::unexpected(Error {Error::ErrorCode::SocketStopRequested})));
 }
 
 MessageConnection::State MessageConnection::state() const noexcept
@@ -103,23 +118,37 @@ const std::optional<Identity>& MessageConnection::remoteIdentity() const noexcep
     return _remoteIdentity;
 }
 
-void MessageConnection::sendMessage(std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept
+void MessageConnection::sendMessage(
+    std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent, MessagePriority priority) noexcept
 {
-    // Heap allocate the header buffer until the send completes.
-    std::unique_ptr<Header> header = std::make_unique<Header>(messagePayload->size());
+    const size_t messageSize = messagePayload->size();
 
-    const std::vector<std::span<const uint8_t>> buffers {
-        std::span<const uint8_t> {reinterpret_cast<const uint8_t*>(header.get()), sizeof(Header)},  // header
-        std::span<const uint8_t> {messagePayload->data(), messagePayload->size()}                   // payload
-    };
+    if (!reserveSendQueue(messageSize)) {
+        onMessageSent(std::unexpected(Error {Error::ErrorCode::SendQueueFull}), std::move(messagePayload));
+        return;
+    }
 
-    send(
-        std::move(buffers),
-        [header         = std::move(header),
-         messagePayload = std::move(messagePayload),
-         onMessageSent  = std::move(onMessageSent)](std::expected<void, Error> result) mutable {
-            onMessageSent(std::move(result), std::move(messagePayload));
-        });
+    _sendQueueCounter->add(messageSize);
+
+    sendFrame(
+        std::move(messagePayload),
+        [counter = _sendQueueCounter, messageSize, onMessageSent = std::move(onMessageSent)](
+            std::expected<void, Error> result, std::unique_ptr<Bytes> payload) mutable {
+            counter->remove(messageSize);
+            onMessageSent(std::move(result), std::move(payload));
+        },
+        messageSize,
+        priority);
+}
+
+void MessageConnection::setSendQueueLimits(SendQueueLimits limits) noexcept
+{
+    _sendQueueLimits = limits;
+}
+
+SendQueueDepth MessageConnection::sendQueueDepth() const noexcept
+{
+    return _sendQueueCounter->depth();
 }
 
 void MessageConnection::shutdownClient() noexcept
@@ -157,61 +186,148 @@ void MessageConnection::initialize() noexcept
     _state       = State::Disconnected;
     _recvCurrent = RecvOperation {};
 
+    _recvFragmented = RecvOperation {};
+
+    // Write callbacks of the previous connection must not resume the send queue processing.
+    if (_writeQueue != nullptr) {
+        _writeQueue->_connection = nullptr;
+    }
+    _writeQueue = std::make_shared<WriteQueue>(this);
+
+    // The remote discards partially received messages, restart the fragmented message on reconnect.
+    if (_sendFragmenting != nullptr) {
+        _sendFragmenting->_offset = 0;
+    }
+
     sendHandshake();
     recvMagicNumber();
 }
 
-void MessageConnection::send(std::vector<std::span<const uint8_t>> buffers, SendCallback callback) noexcept
+void MessageConnection::send(SendOperation operation, MessagePriority priority) noexcept
 {
-    SendOperation operation;
-    operation._buffers    = std::move(buffers);
-    operation._onSendDone = std::move(callback);
-
-    _sendPending.push(std::move(operation));
+    if (priority == MessagePriority::High) {
+        _sendPendingHighPriority.push_back(std::move(operation));
+    } else {
+        _sendPending.push_back(std::move(operation));
+    }
 
     if (connected()) {
         processSendQueue();
     }
 }
 
-void MessageConnection::recv(size_t size, RecvCallback callback) noexcept
+void MessageConnection::sendFrame(
+    std::unique_ptr<Bytes> payload,
+    SendMessageCallback onSent,
+    std::optional<size_t> messageSize,
+    MessagePriority priority) noexcept
 {
-    assert(
-        (!_recvCurrent._buffer || _recvCurrent._cursor == _recvCurrent._buffer->size()) &&
-        "previous recv() call not yet completed");
+    // Large normal priority messages are sent in fragments, with their own headers (see sendNextFragment()).
+    const bool fragmented = priority == MessagePriority::Normal && payload->size() > messageFragmentSize;
+
+    // Heap allocate the header buffer until the send completes.
+    std::unique_ptr<Header> header = std::make_unique<Header>(headerMessage | payload->size());
+
+    SendOperation operation;
+
+    if (!fragmented) {
+        operation._buffers.emplace_back(reinterpret_cast<const uint8_t*>(header.get()), sizeof(Header));
+    }
+    operation._buffers.emplace_back(payload->data(), payload->size());
+
+    operation._onSendDone = [header = std::move(header), payload = std::move(payload), onSent = std::move(onSent)](
+                                std::expected<void, Error> result) mutable {
+        onSent(std::move(result), std::move(payload));
+    };
+    operation._messageSize = messageSize;
+    operation._fragmented  = fragmented;
+
+    send(std::move(operation), priority);
+}
+
+bool MessageConnection::reserveSendQueue(size_t messageSize) noexcept
+{
+    while (_sendQueueLimits.exceeded(_sendQueueCounter->depth(), messageSize)) {
+        if (_sendQueueLimits.policy != SendQueueFullPolicy::DropOldest) {
+            return false;
+        }
 
-    _recvCurrent._cursor = 0;
+        // Only the messages still in the pending queues haven't been handed to the network yet.
+        auto isMessage = [](const SendOperation& operation) { return operation._messageSize.has_value(); };
+
+        std::deque<SendOperation>* sendPending = &_sendPending;
+        auto oldest                            = std::ranges::find_if(*sendPending, isMessage);
+
+        if (oldest == sendPending->end()) {
+            sendPending = &_sendPendingHighPriority;
+            oldest      = std::ranges::find_if(*sendPending, isMessage);
+        }
+
+        if (oldest == sendPending->end()) {
+            return false;
+        }
+
+        SendOperation dropped = std::move(*oldest);
+        sendPending->erase(oldest);
+
+        dropped._onSendDone(std::unexpected(Error {Error::ErrorCode::SendQueueFull}));
+    }
+
+    return true;
+}
+
+void MessageConnection::recv(size_t size, RecvCallback callback) noexcept
+{
+    std::unique_ptr<Bytes> buffer;
 
     try {
-        _recvCurrent._buffer = std::make_unique<BufferedBytes>(size);
+        buffer = std::make_unique<BufferedBytes>(size);
     } catch (const std::bad_alloc& e) {
         _logger.log(Logger::LoggingLevel::error, "Failed to allocate ", size, " bytes.");
         onRemoteDisconnect(DisconnectReason::Aborted);
         return;
     }
 
-    if (size == 0) {
-        // Empty read, complete immediately with an empty buffer.
-        callback(std::move(_recvCurrent._buffer));
+    recvInto(std::move(buffer), 0, size, std::move(callback));
+}
+
+void MessageConnection::recvInto(
+    std::unique_ptr<Bytes> buffer, size_t begin, size_t end, RecvCallback callback) noexcept
+{
+    assert(
+        (!_recvCurrent._buffer || _recvCurrent._cursor == _recvCurrent._end) &&
+        "previous recv() call not yet completed");
+    assert(begin <= end && end <= buffer->size());
+
+    if (begin == end) {
+        // Empty read, complete immediately.
+        callback(std::move(buffer));
         return;
     }
 
+    _recvCurrent._buffer     = std::move(buffer);
+    _recvCurrent._cursor     = begin;
+    _recvCurrent._end        = end;
     _recvCurrent._onRecvDone = std::move(callback);
 }
 
 void MessageConnection::sendHandshake() noexcept
 {
-    assert(_sendPending.empty() && "handshake should be sent first");
+    // Heap allocate the identity and its header until the send completes.
+    auto identityBytes = std::make_unique<BufferedBytes>(_localIdentity.data(), _localIdentity.size());
+    auto header        = std::make_unique<Header>(headerMessage | identityBytes->size());
 
-    // Magic string
-    const std::vector<std::span<const uint8_t>> magicStringBuffer {std::span<const uint8_t> {magicString}};
-    send(std::move(magicStringBuffer), []([[maybe_unused]] std::expected<void, Error> result) {});
+    SendOperation operation;
+    operation._buffers = {
+        std::span<const uint8_t> {magicString},                                                     // magic string
+        std::span<const uint8_t> {reinterpret_cast<const uint8_t*>(header.get()), sizeof(Header)},  // identity header
+        std::span<const uint8_t> {identityBytes->data(), identityBytes->size()},                    // identity
+    };
+    operation._onSendDone = [header = std::move(header), identityBytes = std::move(identityBytes)](
+                                [[maybe_unused]] std::expected<void, Error> result) {};
 
-    // Identity
-    auto identityBytes = std::make_unique<BufferedBytes>(_localIdentity.data(), _localIdentity.size());
-    sendMessage(
-        std::move(identityBytes),
-        []([[maybe_unused]] std::expected<void, Error> result, [[maybe_unused]] std::unique_ptr<Bytes>) {});
+    // The handshake must precede the messages queued while disconnected, whatever their priority.
+    _sendPendingHighPriority.push_front(std::move(operation));
 }
 
 void MessageConnection::recvMagicNumber() noexcept
@@ -240,21 +356,115 @@ void MessageConnection::recvMessage() noexcept
         Header header;
         std::memcpy(&header, headerPayload->data(), sizeof(Header));
 
-        recv(header, [this](std::unique_ptr<Bytes> messagePayload) {
-            assert(connected());
+        const Header frameType = header & headerTypeMask;
+        const size_t frameSize = header & ~headerTypeMask;
+
+        if (frameType == headerMessage) {
+            recv(frameSize, [this](std::unique_ptr<Bytes> messagePayload) {
+                assert(connected());
+
+                onMessage(std::move(messagePayload));
+            });
+        } else if (frameType == headerFragmentedMessage) {
+            recvFragmentedMessage(frameSize);
+        } else if (frameType == headerFragment) {
+            recvFragment(frameSize);
+        } else if (frameType == headerAttachment) {
+            recvAttachment(frameSize);
+        } else {
+            _logger.log(Logger::LoggingLevel::error, "Invalid YMQ frame header received");
+            onRemoteDisconnect(DisconnectReason::Aborted);
+        }
+    });
+}
 
-            if (!established()) {
-                // First message received is the remote identity
-                onRemoteIdentity(std::move(messagePayload));
-            } else {
-                _onRecvMessageCallback(std::move(messagePayload));
-            }
+void MessageConnection::recvFragmentedMessage(size_t messageSize) noexcept
+{
+    if (_recvFragmented._buffer != nullptr) {
+        _logger.log(Logger::LoggingLevel::error, "Fragmented message received before the previous one completed");
+        onRemoteDisconnect(DisconnectReason::Aborted);
+        return;
+    }
+
+    try {
+        _recvFragmented._buffer = std::make_unique<BufferedBytes>(messageSize);
+    } catch (const std::bad_alloc& e) {
+        _logger.log(Logger::LoggingLevel::error, "Failed to allocate ", messageSize, " bytes.");
+        onRemoteDisconnect(DisconnectReason::Aborted);
+        return;
+    }
+
+    _recvFragmented._cursor = 0;
+    _recvFragmented._end    = messageSize;
 
-            recvMessage();  // next message
-        });
+    if (messageSize == 0) {
+        onMessage(std::move(_recvFragmented._buffer));
+        return;
+    }
+
+    recvMessage();  // next, expect the fragments, possibly interleaved with whole messages.
+}
+
+void MessageConnection::recvFragment(size_t fragmentSize) noexcept
+{
+    if (_recvFragmented._buffer == nullptr || fragmentSize > _recvFragmented._end - _recvFragmented._cursor) {
+        _logger.log(Logger::LoggingLevel::error, "Unexpected message fragment received");
+        onRemoteDisconnect(DisconnectReason::Aborted);
+        return;
+    }
+
+    const size_t begin = _recvFragmented._cursor;
+    const size_t end   = begin + fragmentSize;
+
+    recvInto(std::move(_recvFragmented._buffer), begin, end, [this, end](std::unique_ptr<Bytes> messagePayload) {
+        assert(connected());
+
+        _recvFragmented._cursor = end;
+
+        if (end == _recvFragmented._end) {
+            onMessage(std::move(messagePayload));
+        } else {
+            _recvFragmented._buffer = std::move(messagePayload);
+            recvMessage();  // next fragment
+        }
     });
 }
 
+void MessageConnection::recvAttachment(size_t messageSize) noexcept
+{
+    // The attachment is received along with the header's first bytes, it's already pending.
+    auto attachment = _client->acceptAttachment();
+    if (!attachment.has_value()) {
+        _logger.log(Logger::LoggingLevel::error, "Attachment frame received without attachment");
+        onRemoteDisconnect(DisconnectReason::Aborted);
+        return;
+    }
+
+    auto fd      = UV_EXIT_ON_ERROR(attachment->fileno());
+    auto payload = mapAttachment(fd, messageSize);
+    if (!payload.has_value()) {
+        _logger.log(Logger::LoggingLevel::error, "Invalid attachment received: ", payload.error().message());
+        onRemoteDisconnect(DisconnectReason::Aborted);
+        return;
+    }
+
+    onMessage(std::move(payload.value()));
+}
+
+void MessageConnection::onMessage(std::unique_ptr<Bytes> payload) noexcept
+{
+    if (!established()) {
+        // First message received is the remote identity
+        onRemoteIdentity(std::move(payload));
+    } else {
+        _onRecvMessageCallback(std::move(payload));
+    }
+
+    if (connected()) {
+        recvMessage();  // next message
+    }
+}
+
 void MessageConnection::onWriteDone(
     SendCallback callback, std::expected<void, scaler::wrapper::uv::Error> result) noexcept
 {
@@ -310,10 +520,9 @@ void MessageConnection::onRead(std::expected<std::span<const uint8_t>, scaler::w
     while (offset < data.size() && connected()) {
         // Read into the current receive buffer
         assert(
-            _recvCurrent._buffer && _recvCurrent._cursor < _recvCurrent._buffer->size() &&
-            "no receive operation in progress");
+            _recvCurrent._buffer && _recvCurrent._cursor < _recvCurrent._end && "no receive operation in progress");
 
-        const size_t readCount = std::min(_recvCurrent._buffer->size() - _recvCurrent._cursor, data.size() - offset);
+        const size_t readCount = std::min(_recvCurrent._end - _recvCurrent._cursor, data.size() - offset);
         uint8_t* readDest      = _recvCurrent._buffer->data() + _recvCurrent._cursor;
 
         std::memcpy(readDest, data.subspan(offset).data(), readCount);
@@ -322,7 +531,7 @@ void MessageConnection::onRead(std::expected<std::span<const uint8_t>, scaler::w
         offset += readCount;
 
         // If the receive buffer is full, invoke the callback
-        if (_recvCurrent._cursor == _recvCurrent._buffer->size()) {
+        if (_recvCurrent._cursor == _recvCurrent._end) {
             _recvCurrent._onRecvDone(std::move(_recvCurrent._buffer));
         }
     }
@@ -369,15 +578,43 @@ void MessageConnection::processSendQueue() noexcept
 {
     assert(connected());
 
-    while (!_sendPending.empty()) {
-        SendOperation operation = std::move(_sendPending.front());
-        _sendPending.pop();
-
-        processSendOperation(std::move(operation));
+    // Write callbacks might be called synchronously (e.g. TLS), and call processSendQueue() again.
+    const std::shared_ptr<WriteQueue> writeQueue = _writeQueue;
+    if (writeQueue->_processing) {
+        return;
+    }
+    writeQueue->_processing = true;
+
+    // Stop submitting writes once maxWriteQueueSize bytes are in flight, so that the messages sent meanwhile can still
+    // be prioritized. The completing writes resume the processing.
+    while (writeQueue == _writeQueue && connected() && writeQueue->_size < maxWriteQueueSize) {
+        if (!_sendPendingHighPriority.empty()) {
+            SendOperation operation = std::move(_sendPendingHighPriority.front());
+            _sendPendingHighPriority.pop_front();
+
+            processSendOperation(std::move(operation));
+        } else if (_sendFragmenting != nullptr) {
+            sendNextFragment();
+        } else if (!_sendPending.empty()) {
+            SendOperation operation = std::move(_sendPending.front());
+            _sendPending.pop_front();
+
+            if (!operation._fragmented) {
+                processSendOperation(std::move(operation));
+            } else if (_client->supportsAttachments() && operation._buffers.front().size() >= minAttachmentSize) {
+                sendAttachment(std::move(operation));
+            } else {
+                _sendFragmenting = std::make_shared<FragmentedSendOperation>(std::move(operation));
+            }
+        } else {
+            break;
+        }
     }
+
+    writeQueue->_processing = false;
 }
 
-void MessageConnection::processSendOperation(SendOperation operation) noexcept
+void MessageConnection::processSendOperation(SendOperation operation, std::optional<uv_file> attachment) noexcept
 {
     // Calculate total size of all buffers
     size_t totalSize = 0;
@@ -385,10 +622,19 @@ void MessageConnection::processSendOperation(SendOperation operation) noexcept
         totalSize += buffer.size();
     }
 
+    _writeQueue->_size += totalSize;
+
     // Make the callback own the operation's callback
-    auto callback = [onSendDone = std::move(operation._onSendDone)](
+    auto callback = [writeQueue = _writeQueue, totalSize, onSendDone = std::move(operation._onSendDone)](
                         std::expected<void, scaler::wrapper::uv::Error> result) mutable {
+        writeQueue->_size -= totalSize;
+
         onWriteDone(std::move(onSendDone), std::move(result));
+
+        MessageConnection* connection = writeQueue->_connection;
+        if (connection != nullptr && connection->connected()) {
+            connection->processSendQueue();
+        }
     };
 
     // uv_write() normally delivers errors asynchronously via the callback, but returns UV_ENOTCONN synchronously
@@ -399,11 +645,15 @@ void MessageConnection::processSendOperation(SendOperation operation) noexcept
 
     if (totalSize <= maxWriteBufferSize) {
         // Small message: all buffers in one syscall
-        auto result = _client->write(
-            std::span<const std::span<const uint8_t>> {operation._buffers.data(), operation._buffers.size()},
-            std::move(callback));
-        if (!result.has_value() && result.error().code() != UV_ENOTCONN)
-            UV_EXIT_ON_ERROR(result);
+        const std::span<const std::span<const uint8_t>> buffers {operation._buffers.data(), operation._buffers.size()};
+
+        auto result = attachment.has_value() ? _client->write(buffers, attachment.value(), std::move(callback))
+                                             : _client->write(buffers, std::move(callback));
+        if (!result.has_value()) {
+            if (result.error().code() != UV_ENOTCONN)
+                UV_EXIT_ON_ERROR(result);
+            _writeQueue->_size -= totalSize;
+        }
     } else {
         // Large message: chunk the buffers in write() calls of up to maxWriteBufferSize.
         //
@@ -421,13 +671,17 @@ void MessageConnection::processSendOperation(SendOperation operation) noexcept
                     if (!result.has_value()) {
                         if (result.error().code() != UV_ENOTCONN)
                             UV_EXIT_ON_ERROR(result);
+                        _writeQueue->_size -= totalSize;
                         return;
                     }
                 } else {
                     // Attach the callback to the last write() call.
                     auto result = _client->write(std::span(&chunk, 1), std::move(callback));
-                    if (!result.has_value() && result.error().code() != UV_ENOTCONN)
-                        UV_EXIT_ON_ERROR(result);
+                    if (!result.has_value()) {
+                        if (result.error().code() != UV_ENOTCONN)
+                            UV_EXIT_ON_ERROR(result);
+                        _writeQueue->_size -= totalSize;
+                    }
                 }
             }
             offset += buffer.size();
@@ -435,6 +689,73 @@ void MessageConnection::processSendOperation(SendOperation operation) noexcept
     }
 }
 
+void MessageConnection::sendNextFragment() noexcept
+{
+    std::shared_ptr<FragmentedSendOperation> fragmenting = _sendFragmenting;
+
+    const std::span<const uint8_t> payload = fragmenting->_operation._buffers.front();
+
+    const size_t begin = fragmenting->_offset;
+    const size_t end   = std::min(begin + messageFragmentSize, payload.size());
+
+    // Heap allocate the headers until the send completes.
+    auto headers = std::make_unique<std::array<Header, 2>>(std::array<Header, 2> {
+        headerFragmentedMessage | payload.size(),
+        headerFragment | (end - begin),
+    });
+
+    SendOperation operation;
+
+    if (begin == 0) {
+        // The first fragment starts the message.
+        operation._buffers.emplace_back(reinterpret_cast<const uint8_t*>(headers->data()), sizeof(Header) * 2);
+    } else {
+        operation._buffers.emplace_back(reinterpret_cast<const uint8_t*>(&(*headers)[1]), sizeof(Header));
+    }
+    operation._buffers.push_back(payload.subspan(begin, end - begin));
+
+    // Update the state before writing, as the write callback might be called synchronously.
+    const bool isLastFragment = end == payload.size();
+
+    fragmenting->_offset = end;
+    if (isLastFragment) {
+        _sendFragmenting.reset();
+    }
+
+    operation._onSendDone = [headers = std::move(headers), fragmenting = std::move(fragmenting), isLastFragment](
+                                std::expected<void, Error> result) {
+        if (isLastFragment) {
+            fragmenting->_result = std::move(result);
+        }
+    };
+
+    processSendOperation(std::move(operation));
+}
+
+void MessageConnection::sendAttachment(SendOperation operation) noexcept
+{
+    const std::span<const uint8_t> payload = operation._buffers.front();
+
+    auto attachment = createAttachment(payload);
+    if (!attachment.has_value()) {
+        _logger.log(
+            Logger::LoggingLevel::warning,
+            "Failed to create attachment, sending the message in fragments: ",
+            attachment.error().message());
+        _sendFragmenting = std::make_shared<FragmentedSendOperation>(std::move(operation));
+        return;
+    }
+
+    // The attachment holds a copy of the payload, only the header is written to the socket.
+    auto header = std::make_unique<Header>(headerAttachment | payload.size());
+
+    operation._buffers    = {std::span<const uint8_t> {reinterpret_cast<const uint8_t*>(header.get()), sizeof(Header)}};
+    operation._onSendDone = [header = std::move(header), onSendDone = std::move(operation._onSendDone)](
+                                std::expected<void, Error> result) mutable { onSendDone(std::move(result)); };
+
+    processSendOperation(std::move(operation), attachment.value());
+}
+
 bool MessageConnection::isConnectionError(const scaler::wrapper::uv::Error& error)
 {
     switch (error.code()) {
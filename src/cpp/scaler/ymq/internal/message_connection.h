@@ -1,10 +1,12 @@
 #pragma once
 
+#include <uv.h>
+
 #include <cstdint>
+#include <deque>
 #include <expected>
 #include <memory>
 #include <optional>
-#include <queue>
 #include <span>
 #include <vector>
 
@@ -13,6 +15,9 @@
 #include "scaler/wrapper/uv/error.h"
 #include "scaler/ymq/bytes.h"
 #include "scaler/ymq/internal/client.h"
+#include "scaler/ymq/internal/send_queue_counter.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/typedefs.h"
 
 namespace scaler {
@@ -91,11 +96,38 @@ public:
     // If the connection is not established yet, the message is queued and sent once the connection is established.
     //
     // If the connection disconnects, the message will be queued again until the connection is re-established.
-    void sendMessage(std::unique_ptr<Bytes> messagePayload, SendMessageCallback onMessageSent) noexcept;
+    //
+    // Fails with SendQueueFull if the message would exceed the send queue limits.
+    //
+    // High priority messages are sent before the queued normal priority ones, in between the fragments of these.
+    void sendMessage(
+        std::unique_ptr<Bytes> messagePayload,
+        SendMessageCallback onMessageSent,
+        MessagePriority priority = MessagePriority::Normal) noexcept;
+
+    // Bounds the messages queued by sendMessage() and not yet written to the network. Unlimited by default.
+    void setSendQueueLimits(SendQueueLimits limits) noexcept;
+
+    SendQueueDepth sendQueueDepth() const noexcept;
 
 private:
     using Header = uint64_t;
 
+    // The 2 most significant bits of a frame header are the frame type, the remaining bits the frame size.
+    static constexpr Header headerTypeMask = Header {0b11} << 62;
+
+    // A whole message, followed by its payload.
+    static constexpr Header headerMessage = Header {0b00} << 62;
+
+    // Starts a fragmented message, with the total message size and no payload.
+    static constexpr Header headerFragmentedMessage = Header {0b10} << 62;
+
+    // A fragment of the current fragmented message, followed by the fragment's bytes.
+    static constexpr Header headerFragment = Header {0b11} << 62;
+
+    // A whole message, passed as an attachment received along with the header (see attachment.h).
+    static constexpr Header headerAttachment = Header {0b01} << 62;
+
     using SendCallback = scaler::utility::MoveOnlyFunction<void(std::expected<void, Error>)>;
 
     using RecvCallback = scaler::utility::MoveOnlyFunction<void(std::unique_ptr<Bytes>)>;
@@ -104,11 +136,47 @@ private:
         std::vector<std::span<const uint8_t>> _buffers;
 
         SendCallback _onSendDone;
+
+        // The payload size of the messages queued by sendMessage(), which can be dropped by the DropOldest policy.
+        std::optional<size_t> _messageSize {};
+
+        // If true, _buffers only contains the message payload, sent in fragments by sendNextFragment(), or as an
+        // attachment by sendAttachment().
+        bool _fragmented {false};
+    };
+
+    // A message being sent in fragments.
+    //
+    // Shared with the fragments' write callbacks: the message's callback is called once the last fragment is written,
+    // or once the connection got destroyed.
+    struct FragmentedSendOperation {
+        SendOperation _operation;
+
+        // The number of payload bytes already submitted for writing.
+        size_t _offset {0};
+
+        // Set by the write callback of the last fragment.
+        std::optional<std::expected<void, Error>> _result {};
+
+        ~FragmentedSendOperation() noexcept;
+    };
+
+    // The writes submitted to the client and not yet completed.
+    //
+    // Shared with the write callbacks, as these might be called after the connection got disconnected or destroyed.
+    struct WriteQueue {
+        // nullptr once the connection disconnected or got destroyed.
+        MessageConnection* _connection;
+
+        size_t _size {0};
+
+        bool _processing {false};
     };
 
     struct RecvOperation {
         std::unique_ptr<Bytes> _buffer {};
         size_t _cursor {0};
+        size_t _end {0};
 
         RecvCallback _onRecvDone {};
     };
@@ -126,30 +194,67 @@ private:
 
     std::optional<Client> _client {};
 
-    // Sent buffers not yet submitted to the remote.
-    std::queue<SendOperation> _sendPending {};
+    // Sent buffers not yet submitted to the remote, by priority.
+    std::deque<SendOperation> _sendPending {};
+    std::deque<SendOperation> _sendPendingHighPriority {};
+
+    // The normal priority message currently being sent in fragments, if any.
+    std::shared_ptr<FragmentedSendOperation> _sendFragmenting {};
+
+    std::shared_ptr<WriteQueue> _writeQueue {};
+
+    SendQueueLimits _sendQueueLimits {};
+
+    // Shared with the write callbacks, as these might be called after the connection got destroyed.
+    std::shared_ptr<SendQueueCounter> _sendQueueCounter {std::make_shared<SendQueueCounter>()};
 
     // The current partially received receive buffer being assembled.
     RecvOperation _recvCurrent {};
 
+    // The fragmented message being received, if any.
+    RecvOperation _recvFragmented {};
+
     void shutdownClient() noexcept;
 
     void initialize() noexcept;
 
-    // Sends the buffers.
+    // Queues the send operation, and processes it if connected.
     //
     // Buffers' memory must remain valid until the callback is called.
-    void send(std::vector<std::span<const uint8_t>> buffers, SendCallback callback) noexcept;
+    void send(SendOperation operation, MessagePriority priority) noexcept;
+
+    // Sends a length-prefixed frame, without checking the send queue limits.
+    void sendFrame(
+        std::unique_ptr<Bytes> payload,
+        SendMessageCallback onSent,
+        std::optional<size_t> messageSize,
+        MessagePriority priority) noexcept;
+
+    // Returns false if a message of `messageSize` bytes doesn't fit in the send queue, after dropping the oldest
+    // queued messages if the policy allows it.
+    bool reserveSendQueue(size_t messageSize) noexcept;
 
     // Receives a buffer of exactly the given size.
     void recv(size_t size, RecvCallback result) noexcept;
 
+    // Receives the [begin, end) bytes of an existing buffer.
+    void recvInto(std::unique_ptr<Bytes> buffer, size_t begin, size_t end, RecvCallback callback) noexcept;
+
     void sendHandshake() noexcept;
 
     void recvMagicNumber() noexcept;
 
     void recvMessage() noexcept;
 
+    void recvFragmentedMessage(size_t messageSize) noexcept;
+
+    void recvFragment(size_t fragmentSize) noexcept;
+
+    void recvAttachment(size_t messageSize) noexcept;
+
+    // Delivers a whole received message.
+    void onMessage(std::unique_ptr<Bytes> payload) noexcept;
+
     static void onWriteDone(SendCallback callback, std::expected<void, scaler::wrapper::uv::Error> result) noexcept;
 
     void onRead(std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) noexcept;
@@ -160,7 +265,14 @@ private:
 
     void processSendQueue() noexcept;
 
-    void processSendOperation(SendOperation operation) noexcept;
+    // Writes the operation's buffers, along with the attachment's file descriptor if any.
+    void processSendOperation(SendOperation operation, std::optional<uv_file> attachment = std::nullopt) noexcept;
+
+    // Submits the next fragment of _sendFragmenting.
+    void sendNextFragment() noexcept;
+
+    // Sends a message's payload as an attachment, or starts sending it in fragments if the attachment can't be created.
+    void sendAttachment(SendOperation operation) noexcept;
 
     static bool isConnectionError(const scaler::wrapper::uv::Error& error);
 };
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// Base class for the elements of an MPSCQueue.
+//
+// The queue links its elements through this intrusive pointer, and does not allocate.
+class MPSCQueueNode {
+private:
+    std::atomic<MPSCQueueNode*> _next {nullptr};
+
+    template <typename T>
+        requires std::derived_from<T, MPSCQueueNode>
+    friend class MPSCQueue;
+};
+
+// A lock-free, intrusive, multiple-producer single-consumer queue (Dmitry Vyukov's algorithm).
+//
+// Producers only do a single atomic exchange to push a node, and never wait on the consumer or on each other.
+template <typename T>
+    requires std::derived_from<T, MPSCQueueNode>
+class MPSCQueue {
+public:
+    MPSCQueue() noexcept: _head(&_stub), _tail(&_stub) {}
+
+    ~MPSCQueue() noexcept
+    {
+        while (pop() != nullptr) {}
+    }
+
+    MPSCQueue(const MPSCQueue&)            = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    MPSCQueue(MPSCQueue&&)            = delete;
+    MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+    // Add a node at the end of the queue.
+    //
+    // Thread-safe.
+    void push(std::unique_ptr<T> node) noexcept
+    {
+        pushNode(node.release());
+    }
+
+    // Returns true if there is no node to pop.
+    //
+    // Must only be called from the consumer thread.
+    bool empty() const noexcept
+    {
+        return _tail == &_stub && _stub._next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // Remove the node at the front of the queue.
+    //
+    // Returns nullptr if the queue is empty, or if the next node is still being pushed by a producer.
+    //
+    // Must only be called from a single thread at a time.
+    std::unique_ptr<T> pop() noexcept
+    {
+        MPSCQueueNode* tail = _tail;
+        MPSCQueueNode* next = tail->_next.load(std::memory_order_acquire);
+
+        if (tail == &_stub) {
+            if (next == nullptr) {
+                return nullptr;  // empty
+            }
+
+            _tail = next;
+            tail  = next;
+            next  = next->_next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr) {
+            _tail = next;
+            return std::unique_ptr<T>(static_cast<T*>(tail));
+        }
+
+        if (tail != _head.load(std::memory_order_acquire)) {
+            return nullptr;  // a producer exchanged _head, but did not link its node yet
+        }
+
+        // `tail` is the last node. Push the stub behind it, so that it can be removed without racing with producers.
+        pushNode(&_stub);
+
+        next = tail->_next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            _tail = next;
+            return std::unique_ptr<T>(static_cast<T*>(tail));
+        }
+
+        return nullptr;
+    }
+
+    // Pop all the nodes pushed before this call, and call `consumer` with each of them, in FIFO order.
+    //
+    // Nodes pushed while the consumer runs are kept for the next call. Might stop early if a producer is in the middle
+    // of a push. Returns the number of consumed nodes.
+    //
+    // Must only be called from a single thread at a time.
+    template <typename Consumer>
+    size_t consumeAll(Consumer&& consumer) noexcept
+    {
+        const MPSCQueueNode* last = _head.load(std::memory_order_acquire);
+        if (last == &_stub) {
+            return 0;
+        }
+
+        size_t count = 0;
+        while (std::unique_ptr<T> node = pop()) {
+            const bool isLast = node.get() == last;
+
+            consumer(std::move(node));
+            ++count;
+
+            if (isLast) {
+                break;
+            }
+        }
+
+        return count;
+    }
+
+private:
+    // Producers push at the head, the consumer pops at the tail.
+    std::atomic<MPSCQueueNode*> _head;
+    MPSCQueueNode* _tail;
+
+    // Keeps the list non-empty, so that producers and the consumer never update the same pointer.
+    MPSCQueueNode _stub {};
+
+    void pushNode(MPSCQueueNode* node) noexcept
+    {
+        node->_next.store(nullptr, std::memory_order_relaxed);
+
+        MPSCQueueNode* previous = _head.exchange(node, std::memory_order_acq_rel);
+        previous->_next.store(node, std::memory_order_release);
+    }
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,88 @@
+#include "scaler/ymq/internal/recv_queue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+bool RecvQueue::hasPendingMessages() const noexcept
+{
+    return !_pendingMessages.empty();
+}
+
+void RecvQueue::recvMessage(RecvMessageCallback onRecvMessage) noexcept
+{
+    if (_pendingMessages.empty()) {
+        // No messages are pending, queue the callback until a message arrives
+        _pendingRecvs.push(std::move(onRecvMessage));
+        return;
+    }
+
+    // There is a message ready, call the callback immediately
+    Message message = std::move(_pendingMessages.front());
+    _pendingMessages.pop();
+    onRecvMessage(std::move(message));
+}
+
+void RecvQueue::recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept
+{
+    assert(maxCount > 0);
+
+    if (_pendingMessages.empty()) {
+        _pendingRecvs.push(std::move(onRecvMessages));
+        return;
+    }
+
+    std::vector<Message> messages {};
+    messages.reserve(std::min(maxCount, _pendingMessages.size()));
+
+    while (messages.size() < maxCount && !_pendingMessages.empty()) {
+        messages.push_back(std::move(_pendingMessages.front()));
+        _pendingMessages.pop();
+    }
+
+    onRecvMessages(std::move(messages));
+}
+
+void RecvQueue::onMessage(Message message) noexcept
+{
+    if (_pendingRecvs.empty()) {
+        // No callback waiting, buffer the message until the user calls recvMessage()
+        _pendingMessages.push(std::move(message));
+        return;
+    }
+
+    PendingRecv pendingRecv = std::move(_pendingRecvs.front());
+    _pendingRecvs.pop();
+
+    if (auto* onRecvMessage = std::get_if<RecvMessageCallback>(&pendingRecv)) {
+        (*onRecvMessage)(std::move(message));
+        return;
+    }
+
+    std::vector<Message> messages {};
+    messages.push_back(std::move(message));
+    std::get<RecvMessagesCallback>(pendingRecv)(std::move(messages));
+}
+
+void RecvQueue::failPendingRecvs(Error error) noexcept
+{
+    while (!_pendingRecvs.empty()) {
+        PendingRecv pendingRecv = std::move(_pendingRecvs.front());
+        _pendingRecvs.pop();
+
+        std::visit([&](auto& callback) { callback(std::unexpected {error}); }, pendingRecv);
+    }
+}
+
+void RecvQueue::clearPendingMessages() noexcept
+{
+    _pendingMessages = {};
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <queue>
+#include <variant>
+#include <vector>
+
+#include "scaler/error/error.h"
+#include "scaler/utility/move_only_function.h"
+#include "scaler/ymq/message.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// Matches the socket's received messages with the user's receive requests.
+//
+// Messages received while no request is waiting are buffered, and requests made while no message is buffered are
+// queued until a message arrives. Requests are served in order, whether they are for one message or for a batch.
+//
+// Not thread-safe: must only be used from the socket's event loop thread.
+class RecvQueue {
+public:
+    using RecvMessageCallback = scaler::utility::MoveOnlyFunction<void(std::expected<Message, Error>)>;
+
+    using RecvMessagesCallback = scaler::utility::MoveOnlyFunction<void(std::expected<std::vector<Message>, Error>)>;
+
+    bool hasPendingMessages() const noexcept;
+
+    // Call the callback with the oldest buffered message, or queue it until a message arrives.
+    void recvMessage(RecvMessageCallback onRecvMessage) noexcept;
+
+    // Call the callback with up to `maxCount` buffered messages, or queue it until a message arrives.
+    //
+    // A queued batch request is completed as soon as a single message arrives.
+    void recvMessages(size_t maxCount, RecvMessagesCallback onRecvMessages) noexcept;
+
+    // Complete the oldest waiting request with the message, or buffer it if no request is waiting.
+    void onMessage(Message message) noexcept;
+
+    // Fail all the waiting requests with the error.
+    void failPendingRecvs(Error error) noexcept;
+
+    // Drop all the buffered messages.
+    void clearPendingMessages() noexcept;
+
+private:
+    using PendingRecv = std::variant<RecvMessageCallback, RecvMessagesCallback>;
+
+    std::queue<PendingRecv> _pendingRecvs {};
+    std::queue<Message> _pendingMessages {};
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
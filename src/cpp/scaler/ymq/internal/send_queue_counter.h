@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "scaler/ymq/send_queue_limits.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// Counts the messages queued for sending.
+//
+// Thread-safe: messages are usually added from the socket's thread, and removed from the thread of the connection that
+// wrote them, while users read the depth from their own threads.
+class SendQueueCounter {
+public:
+    void add(size_t messageSize) noexcept
+    {
+        _messages.fetch_add(1, std::memory_order_relaxed);
+        _bytes.fetch_add(messageSize, std::memory_order_relaxed);
+    }
+
+    void remove(size_t messageSize) noexcept
+    {
+        _messages.fetch_sub(1, std::memory_order_relaxed);
+        _bytes.fetch_sub(messageSize, std::memory_order_relaxed);
+    }
+
+    SendQueueDepth depth() const noexcept
+    {
+        return SendQueueDepth {
+            .messages = _messages.load(std::memory_order_relaxed),
+            .bytes    = _bytes.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    std::atomic<size_t> _messages {0};
+    std::atomic<size_t> _bytes {0};
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
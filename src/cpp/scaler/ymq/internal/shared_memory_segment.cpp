@@ -0,0 +1,51 @@
+#include "scaler/ymq/internal/shared_memory_segment.h"
+
+#include <utility>
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+SharedMemorySegment::SharedMemorySegment(std::string name, uint8_t* data, size_t size) noexcept
+    : _name(std::move(name)), _data(data), _size(size)
+{
+}
+
+SharedMemorySegment::SharedMemorySegment(SharedMemorySegment&& other) noexcept
+    : _name(std::move(other._name))
+    , _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+{
+}
+
+SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment&& other) noexcept
+{
+    if (this != &other) {
+        SharedMemorySegment moved {std::move(*this)};  // unmaps the current segment
+
+        _name = std::move(other._name);
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+
+    return *this;
+}
+
+const std::string& SharedMemorySegment::name() const noexcept
+{
+    return _name;
+}
+
+uint8_t* SharedMemorySegment::data() const noexcept
+{
+    return _data;
+}
+
+size_t SharedMemorySegment::size() const noexcept
+{
+    return _size;
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+
+#include "scaler/wrapper/uv/error.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// A named memory mapping shared between processes, see shm_open() and mmap().
+//
+// Only supported on POSIX systems, other platforms fail with UV_ENOTSUP.
+class SharedMemorySegment {
+public:
+    // Creates and maps a zero-filled segment of size bytes, under a new unique name.
+    //
+    // The segment can only be opened by processes of the same user.
+    static std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> create(size_t size) noexcept;
+
+    // Maps an existing segment, which must be at least size bytes large.
+    static std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> open(
+        const std::string& name, size_t size) noexcept;
+
+    ~SharedMemorySegment() noexcept;
+
+    SharedMemorySegment(const SharedMemorySegment&)            = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    SharedMemorySegment(SharedMemorySegment&& other) noexcept;
+    SharedMemorySegment& operator=(SharedMemorySegment&& other) noexcept;
+
+    const std::string& name() const noexcept;
+
+    uint8_t* data() const noexcept;
+
+    size_t size() const noexcept;
+
+    // Removes the segment's name, so that it can no longer be opened. The memory is released once all the processes
+    // unmapped it.
+    void unlink() noexcept;
+
+private:
+    SharedMemorySegment(std::string name, uint8_t* data, size_t size) noexcept;
+
+    std::string _name;
+    uint8_t* _data;
+    size_t _size;
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
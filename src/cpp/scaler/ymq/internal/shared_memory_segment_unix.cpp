@@ -0,0 +1,110 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <uv.h>
+
+#include <atomic>
+#include <cerrno>
+#include <format>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "scaler/ymq/internal/shared_memory_segment.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+namespace {
+
+std::string generateSegmentName() noexcept
+{
+    static std::atomic<uint64_t> counter {0};
+
+    // The random part prevents other processes from guessing the name before we open it.
+    std::random_device randomDevice {};
+    const uint64_t random = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+
+    return std::format("/ymq-{}-{}-{:016x}", ::getpid(), counter.fetch_add(1, std::memory_order_relaxed), random);
+}
+
+std::expected<uint8_t*, scaler::wrapper::uv::Error> mapSegment(int fd, size_t size) noexcept
+{
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        return std::unexpected {scaler::wrapper::uv::Error {uv_translate_sys_error(errno)}};
+    }
+
+    return static_cast<uint8_t*>(data);
+}
+
+}  // namespace
+
+std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> SharedMemorySegment::create(size_t size) noexcept
+{
+    std::string name = generateSegmentName();
+
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return std::unexpected {scaler::wrapper::uv::Error {uv_translate_sys_error(errno)}};
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return std::unexpected {scaler::wrapper::uv::Error {uv_translate_sys_error(error)}};
+    }
+
+    auto data = mapSegment(fd, size);
+    ::close(fd);  // the mapping keeps the segment alive
+
+    if (!data.has_value()) {
+        ::shm_unlink(name.c_str());
+        return std::unexpected {data.error()};
+    }
+
+    return SharedMemorySegment {std::move(name), data.value(), size};
+}
+
+std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> SharedMemorySegment::open(
+    const std::string& name, size_t size) noexcept
+{
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return std::unexpected {scaler::wrapper::uv::Error {uv_translate_sys_error(errno)}};
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(size)) {
+        ::close(fd);
+        return std::unexpected {scaler::wrapper::uv::Error {UV_EPROTO}};
+    }
+
+    auto data = mapSegment(fd, size);
+    ::close(fd);
+
+    if (!data.has_value()) {
+        return std::unexpected {data.error()};
+    }
+
+    return SharedMemorySegment {name, data.value(), size};
+}
+
+SharedMemorySegment::~SharedMemorySegment() noexcept
+{
+    if (_data != nullptr) {
+        ::munmap(_data, _size);
+    }
+}
+
+void SharedMemorySegment::unlink() noexcept
+{
+    ::shm_unlink(_name.c_str());
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
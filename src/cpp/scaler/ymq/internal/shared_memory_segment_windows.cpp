@@ -0,0 +1,28 @@
+#include "scaler/ymq/internal/shared_memory_segment.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> SharedMemorySegment::create(size_t) noexcept
+{
+    return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+}
+
+std::expected<SharedMemorySegment, scaler::wrapper::uv::Error> SharedMemorySegment::open(
+    const std::string&, size_t) noexcept
+{
+    return std::unexpected {scaler::wrapper::uv::Error {UV_ENOTSUP}};
+}
+
+SharedMemorySegment::~SharedMemorySegment() noexcept
+{
+}
+
+void SharedMemorySegment::unlink() noexcept
+{
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
@@ -0,0 +1,548 @@
+#include "scaler/ymq/internal/shared_memory_stream.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+namespace {
+
+// Starts the client's handshake message. The last byte is the protocol version.
+static constexpr std::array<uint8_t, 4> HANDSHAKE_MAGIC {'Y', 'M', 'S', 1};
+
+// The handshake message: the magic, the ring capacity (8 bytes, host byte order) and the length-prefixed segment name.
+static constexpr size_t HANDSHAKE_HEADER_SIZE = HANDSHAKE_MAGIC.size() + sizeof(uint64_t) + sizeof(uint8_t);
+
+static constexpr size_t MAX_RING_CAPACITY = 1024ULL * 1024ULL * 1024ULL;  // 1 GB
+
+// Sent by the server once it mapped the segment, then by both sides to wake their peer up.
+static constexpr uint8_t NOTIFICATION = 0;
+
+std::vector<uint8_t> buildHandshakeMessage(const std::string& segmentName, uint64_t ringCapacity) noexcept
+{
+    std::vector<uint8_t> message(HANDSHAKE_HEADER_SIZE + segmentName.size());
+
+    std::memcpy(message.data(), HANDSHAKE_MAGIC.data(), HANDSHAKE_MAGIC.size());
+    std::memcpy(message.data() + HANDSHAKE_MAGIC.size(), &ringCapacity, sizeof(ringCapacity));
+    message[HANDSHAKE_HEADER_SIZE - 1] = static_cast<uint8_t>(segmentName.size());
+    std::memcpy(message.data() + HANDSHAKE_HEADER_SIZE, segmentName.data(), segmentName.size());
+
+    return message;
+}
+
+bool isValidRingCapacity(uint64_t ringCapacity) noexcept
+{
+    return std::has_single_bit(ringCapacity) && ringCapacity <= MAX_RING_CAPACITY;
+}
+
+}  // namespace
+
+// Shared state used during the handshake on the client side.
+struct SharedMemoryClientUpgradeContext {
+    std::optional<scaler::wrapper::uv::Pipe> pipe {};
+    std::optional<SharedMemorySegment> segment {};
+    size_t ringCapacity {};
+    SharedMemoryStream::UpgradeCallback callback {};
+
+    // Removes the segment's name if the server never got to map it.
+    ~SharedMemoryClientUpgradeContext() noexcept
+    {
+        if (segment.has_value()) {
+            segment->unlink();
+        }
+    }
+};
+
+// Shared state used during the handshake on the server side.
+struct SharedMemoryServerUpgradeContext {
+    std::optional<scaler::wrapper::uv::Pipe> pipe {};
+    std::vector<uint8_t> recvBuffer {};
+    SharedMemoryStream::UpgradeCallback callback {};
+};
+
+SharedMemoryStream::State::State(
+    scaler::wrapper::uv::Pipe pipe, SharedMemorySegment segment, bool isServer, size_t ringCapacity) noexcept
+    : _pipe(std::move(pipe)), _segment(std::move(segment))
+{
+    // Segment layout: the client-to-server ring's control block, the server-to-client one, then their data.
+    uint8_t* base = _segment.data();
+
+    const Ring clientToServer {
+        reinterpret_cast<RingControl*>(base),
+        base + 2 * sizeof(RingControl),
+        ringCapacity,
+    };
+    const Ring serverToClient {
+        reinterpret_cast<RingControl*>(base + sizeof(RingControl)),
+        base + 2 * sizeof(RingControl) + ringCapacity,
+        ringCapacity,
+    };
+
+    _sendRing = isServer ? serverToClient : clientToServer;
+    _recvRing = isServer ? clientToServer : serverToClient;
+}
+
+SharedMemoryStream::SharedMemoryStream(std::shared_ptr<State> state) noexcept: _state(std::move(state))
+{
+}
+
+size_t SharedMemoryStream::segmentSize(size_t ringCapacity) noexcept
+{
+    return 2 * sizeof(RingControl) + 2 * ringCapacity;
+}
+
+SharedMemoryStream SharedMemoryStream::fromSegment(
+    scaler::wrapper::uv::Pipe pipe, SharedMemorySegment segment, bool isServer, size_t ringCapacity) noexcept
+{
+    auto state = std::make_shared<State>(std::move(pipe), std::move(segment), isServer, ringCapacity);
+
+    // The pipe is read for as long as the stream lives, as it carries the notifications for both directions.
+    auto readStartResult = state->_pipe.readStart(
+        [state](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) mutable {
+            onPipeRead(state, std::move(result));
+        });
+    if (!readStartResult.has_value()) {
+        state->_peerError = readStartResult.error();
+    }
+
+    return SharedMemoryStream(std::move(state));
+}
+
+void SharedMemoryStream::upgradeAsClient(
+    scaler::wrapper::uv::Pipe pipe, UpgradeCallback callback, size_t ringCapacity) noexcept
+{
+    assert(isValidRingCapacity(ringCapacity));
+
+    auto segment = SharedMemorySegment::create(segmentSize(ringCapacity));
+    if (!segment.has_value()) {
+        callback(std::unexpected(segment.error()));
+        return;
+    }
+
+    // The segment is zero-filled, but the control blocks' lifetime still has to be started.
+    new (segment->data()) RingControl {};
+    new (segment->data() + sizeof(RingControl)) RingControl {};
+
+    auto ctx          = std::make_shared<SharedMemoryClientUpgradeContext>();
+    ctx->pipe         = std::move(pipe);
+    ctx->segment      = std::move(segment.value());
+    ctx->ringCapacity = ringCapacity;
+    ctx->callback     = std::move(callback);
+
+    auto message = std::make_shared<std::vector<uint8_t>>(buildHandshakeMessage(ctx->segment->name(), ringCapacity));
+
+    auto writeResult = ctx->pipe->write(
+        std::span<const uint8_t>(*message),
+        [ctx, message](std::expected<void, scaler::wrapper::uv::Error> result) mutable {
+            if (!result.has_value()) {
+                ctx->callback(std::unexpected(result.error()));
+                return;
+            }
+
+            auto readStartResult = ctx->pipe->readStart(
+                [ctx](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> readResult) mutable {
+                    // Copy ctx to the stack before readStop() - readStop() destroys this lambda (and the captured ctx).
+                    auto safeCtx = ctx;
+                    safeCtx->pipe->readStop();
+
+                    if (!readResult.has_value()) {
+                        safeCtx->callback(std::unexpected(readResult.error()));
+                        return;
+                    }
+
+                    // The server acknowledged, it mapped the segment and removed its name.
+                    SharedMemorySegment segment = std::move(safeCtx->segment.value());
+                    safeCtx->segment.reset();
+
+                    safeCtx->callback(fromSegment(
+                        std::move(safeCtx->pipe.value()), std::move(segment), false, safeCtx->ringCapacity));
+                });
+
+            if (!readStartResult.has_value()) {
+                ctx->callback(std::unexpected(readStartResult.error()));
+            }
+        });
+
+    if (!writeResult.has_value()) {
+        auto cb = std::move(ctx->callback);
+        cb(std::unexpected(writeResult.error()));
+    }
+}
+
+void SharedMemoryStream::upgradeAsServer(scaler::wrapper::uv::Pipe pipe, UpgradeCallback callback) noexcept
+{
+    auto ctx      = std::make_shared<SharedMemoryServerUpgradeContext>();
+    ctx->pipe     = std::move(pipe);
+    ctx->callback = std::move(callback);
+
+    auto readStartResult = ctx->pipe->readStart(
+        [ctx](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> readResult) mutable {
+            if (!readResult.has_value()) {
+                auto safeCtx = ctx;
+                ctx->pipe->readStop();
+                safeCtx->callback(std::unexpected(readResult.error()));
+                return;
+            }
+
+            const auto& data = readResult.value();
+            ctx->recvBuffer.insert(ctx->recvBuffer.end(), data.begin(), data.end());
+
+            const std::span<const uint8_t> received(ctx->recvBuffer);
+
+            const size_t magicSize = std::min(received.size(), HANDSHAKE_MAGIC.size());
+            if (!std::equal(received.begin(), received.begin() + magicSize, HANDSHAKE_MAGIC.begin())) {
+                auto safeCtx = ctx;
+                ctx->pipe->readStop();
+                safeCtx->callback(std::unexpected(scaler::wrapper::uv::Error {UV_EPROTO}));
+                return;
+            }
+
+            if (received.size() < HANDSHAKE_HEADER_SIZE ||
+                received.size() < HANDSHAKE_HEADER_SIZE + received[HANDSHAKE_HEADER_SIZE - 1]) {
+                return;  // need more data
+            }
+
+            auto safeCtx = ctx;
+            ctx->pipe->readStop();
+
+            uint64_t ringCapacity = 0;
+            std::memcpy(&ringCapacity, received.data() + HANDSHAKE_MAGIC.size(), sizeof(ringCapacity));
+
+            const std::string segmentName(
+                reinterpret_cast<const char*>(received.data() + HANDSHAKE_HEADER_SIZE),
+                received[HANDSHAKE_HEADER_SIZE - 1]);
+
+            // The client waits for the acknowledgement before sending anything else.
+            if (received.size() != HANDSHAKE_HEADER_SIZE + segmentName.size() || !isValidRingCapacity(ringCapacity)) {
+                safeCtx->callback(std::unexpected(scaler::wrapper::uv::Error {UV_EPROTO}));
+                return;
+            }
+
+            auto segment = SharedMemorySegment::open(segmentName, segmentSize(ringCapacity));
+            if (!segment.has_value()) {
+                safeCtx->callback(std::unexpected(segment.error()));
+                return;
+            }
+
+            // No other process should map the segment.
+            segment->unlink();
+
+            auto segmentPtr = std::make_shared<SharedMemorySegment>(std::move(segment.value()));
+
+            auto writeResult = safeCtx->pipe->write(
+                std::span<const uint8_t>(&NOTIFICATION, 1),
+                [safeCtx, segmentPtr, ringCapacity](std::expected<void, scaler::wrapper::uv::Error> result) mutable {
+                    if (!result.has_value()) {
+                        safeCtx->callback(std::unexpected(result.error()));
+                        return;
+                    }
+
+                    safeCtx->callback(
+                        fromSegment(std::move(safeCtx->pipe.value()), std::move(*segmentPtr), true, ringCapacity));
+                });
+
+            if (!writeResult.has_value()) {
+                safeCtx->callback(std::unexpected(writeResult.error()));
+            }
+        });
+
+    if (!readStartResult.has_value()) {
+        auto cb = std::move(ctx->callback);
+        cb(std::unexpected(readStartResult.error()));
+    }
+}
+
+SharedMemoryStream::~SharedMemoryStream() noexcept
+{
+    if (_state == nullptr) {
+        return;  // instance moved
+    }
+
+    _state->_readCallback.reset();
+
+    // Releases the pipe's read callback, which holds a reference to the state.
+    _state->_pipe.readStop();
+
+    failPendingWrites(_state, scaler::wrapper::uv::Error {UV_ECANCELED});
+}
+
+std::expected<void, scaler::wrapper::uv::Error> SharedMemoryStream::write(
+    std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept
+{
+    if (_state->_sendClosed) {
+        return std::unexpected(scaler::wrapper::uv::Error {UV_EPIPE});
+    }
+
+    if (_state->_peerError.has_value()) {
+        // The disconnect is reported by the read side.
+        return std::unexpected(scaler::wrapper::uv::Error {UV_ENOTCONN});
+    }
+
+    auto state = _state;
+
+    PendingWrite pendingWrite {{buffers.begin(), buffers.end()}, std::move(callback)};
+    std::erase_if(pendingWrite._buffers, [](std::span<const uint8_t> buffer) { return buffer.empty(); });
+
+    state->_pendingWrites.push_back(std::move(pendingWrite));
+    processPendingWrites(state);
+
+    return {};
+}
+
+std::expected<void, scaler::wrapper::uv::Error> SharedMemoryStream::readStart(
+    scaler::wrapper::uv::ReadCallback callback) noexcept
+{
+    auto state           = _state;
+    state->_readCallback = std::make_shared<scaler::wrapper::uv::ReadCallback>(std::move(callback));
+
+    // Deliver the bytes received while not reading.
+    processRecvRing(state);
+
+    return {};
+}
+
+void SharedMemoryStream::readStop() noexcept
+{
+    _state->_readCallback.reset();
+}
+
+std::expected<void, scaler::wrapper::uv::Error> SharedMemoryStream::shutdown(
+    scaler::wrapper::uv::ShutdownCallback callback) noexcept
+{
+    if (_state->_sendClosed) {
+        return std::unexpected(scaler::wrapper::uv::Error {UV_EALREADY});
+    }
+
+    auto state               = _state;
+    state->_sendClosed       = true;
+    state->_shutdownCallback = std::move(callback);
+
+    processPendingWrites(state);
+
+    return {};
+}
+
+std::expected<void, scaler::wrapper::uv::Error> SharedMemoryStream::closeReset() noexcept
+{
+    return std::unexpected(scaler::wrapper::uv::Error {UV_ENOTSUP});
+}
+
+void SharedMemoryStream::onPipeRead(
+    std::shared_ptr<State> state, std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) noexcept
+{
+    if (!result.has_value()) {
+        if (state->_peerError.has_value()) {
+            return;
+        }
+
+        // The peer closed its end of the pipe, it won't read or write the rings anymore. Unless it shut its sending
+        // side down first, the stream was aborted.
+        state->_peerError = result.error() == scaler::wrapper::uv::Error {UV_EOF}
+                                ? scaler::wrapper::uv::Error {UV_ECONNRESET}
+                                : result.error();
+
+        failPendingWrites(state, scaler::wrapper::uv::Error {UV_EPIPE});
+        if (state->_shutdownCallback.has_value()) {
+            finishShutdown(state);
+        }
+
+        processRecvRing(state);
+        return;
+    }
+
+    // The notifications carry no data, they only tell that the peer wrote to, or read from the rings.
+    processRecvRing(state);
+    processPendingWrites(state);
+}
+
+void SharedMemoryStream::processRecvRing(std::shared_ptr<State> state) noexcept
+{
+    RingControl& control = *state->_recvRing._control;
+    const size_t mask    = state->_recvRing._capacity - 1;
+
+    while (state->_readCallback != nullptr && !state->_recvClosed) {
+        // Keep the callback alive if it calls readStop().
+        const std::shared_ptr<scaler::wrapper::uv::ReadCallback> callback = state->_readCallback;
+
+        const uint64_t tail = control._tail.load(std::memory_order_relaxed);
+        uint64_t head       = control._head.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            // The producer sets _producerClosed after publishing its last bytes.
+            if (control._producerClosed.load(std::memory_order_seq_cst) != 0) {
+                if (control._head.load(std::memory_order_acquire) != tail) {
+                    continue;
+                }
+
+                state->_recvClosed = true;
+                (*callback)(std::unexpected(scaler::wrapper::uv::Error {UV_EOF}));
+                return;
+            }
+
+            if (state->_peerError.has_value()) {
+                state->_recvClosed = true;
+                (*callback)(std::unexpected(state->_peerError.value()));
+                return;
+            }
+
+            // Ask for a notification, then check again in case the producer published bytes before it could see the
+            // request.
+            control._consumerWaiting.store(1, std::memory_order_seq_cst);
+            if (control._head.load(std::memory_order_seq_cst) == tail) {
+                return;
+            }
+            control._consumerWaiting.store(0, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (head - tail > state->_recvRing._capacity) {
+            // The peer corrupted the ring.
+            state->_recvClosed = true;
+            (*callback)(std::unexpected(scaler::wrapper::uv::Error {UV_ECONNABORTED}));
+            return;
+        }
+
+        // Deliver the bytes up to the end of the ring, the rest is delivered by the next iteration.
+        const size_t offset = tail & mask;
+        const size_t size   = std::min<uint64_t>(head - tail, state->_recvRing._capacity - offset);
+
+        (*callback)(std::span<const uint8_t>(state->_recvRing._data + offset, size));
+
+        control._tail.store(tail + size, std::memory_order_seq_cst);
+
+        if (control._producerWaiting.load(std::memory_order_seq_cst) != 0 &&
+            control._producerWaiting.exchange(0, std::memory_order_seq_cst) != 0) {
+            notifyPeer(state);
+        }
+    }
+}
+
+void SharedMemoryStream::processPendingWrites(std::shared_ptr<State> state) noexcept
+{
+    // Write callbacks might call write() again, the outer call copies these new writes.
+    if (state->_processingWrites) {
+        return;
+    }
+    state->_processingWrites = true;
+
+    RingControl& control = *state->_sendRing._control;
+    const size_t mask    = state->_sendRing._capacity - 1;
+
+    while (!state->_pendingWrites.empty() && !state->_peerError.has_value()) {
+        PendingWrite& pendingWrite = state->_pendingWrites.front();
+
+        const uint64_t head = control._head.load(std::memory_order_relaxed);
+        const uint64_t tail = control._tail.load(std::memory_order_acquire);
+
+        const uint64_t used = head - tail;
+        size_t available    = used < state->_sendRing._capacity ? state->_sendRing._capacity - used : 0;
+
+        uint64_t written = 0;
+        while (available > 0 && !pendingWrite._buffers.empty()) {
+            std::span<const uint8_t>& buffer = pendingWrite._buffers.front();
+
+            const size_t size   = std::min(buffer.size(), available);
+            const size_t offset = (head + written) & mask;
+            const size_t first  = std::min(size, state->_sendRing._capacity - offset);
+
+            std::memcpy(state->_sendRing._data + offset, buffer.data(), first);
+            std::memcpy(state->_sendRing._data, buffer.data() + first, size - first);
+
+            written += size;
+            available -= size;
+
+            buffer = buffer.subspan(size);
+            if (buffer.empty()) {
+                pendingWrite._buffers.erase(pendingWrite._buffers.begin());
+            }
+        }
+
+        if (written > 0) {
+            control._head.store(head + written, std::memory_order_seq_cst);
+
+            if (control._consumerWaiting.load(std::memory_order_seq_cst) != 0 &&
+                control._consumerWaiting.exchange(0, std::memory_order_seq_cst) != 0) {
+                notifyPeer(state);
+            }
+        }
+
+        if (pendingWrite._buffers.empty()) {
+            scaler::wrapper::uv::WriteCallback callback = std::move(pendingWrite._callback);
+            state->_pendingWrites.pop_front();
+            callback({});
+            continue;
+        }
+
+        // The ring is full. Ask for a notification, then check again in case the consumer freed some space before it
+        // could see the request.
+        control._producerWaiting.store(1, std::memory_order_seq_cst);
+        if (control._tail.load(std::memory_order_seq_cst) == tail) {
+            break;
+        }
+        control._producerWaiting.store(0, std::memory_order_relaxed);
+    }
+
+    state->_processingWrites = false;
+
+    if (state->_pendingWrites.empty() && state->_shutdownCallback.has_value()) {
+        finishShutdown(state);
+    }
+}
+
+void SharedMemoryStream::finishShutdown(std::shared_ptr<State> state) noexcept
+{
+    // Share ownership so both the synchronous error path and the async write callback can invoke it.
+    auto callbackPtr = std::make_shared<scaler::wrapper::uv::ShutdownCallback>(std::move(*state->_shutdownCallback));
+    state->_shutdownCallback.reset();
+
+    if (state->_peerError.has_value()) {
+        (*callbackPtr)(std::unexpected(scaler::wrapper::uv::Error {UV_EPIPE}));
+        return;
+    }
+
+    state->_sendRing._control->_producerClosed.store(1, std::memory_order_seq_cst);
+
+    // Always notify, the consumer might be waiting for data.
+    auto writeResult = state->_pipe.write(
+        std::span<const uint8_t>(&NOTIFICATION, 1),
+        [callbackPtr](std::expected<void, scaler::wrapper::uv::Error> result) { (*callbackPtr)(result); });
+
+    if (!writeResult.has_value()) {
+        (*callbackPtr)(std::unexpected(writeResult.error()));
+    }
+}
+
+void SharedMemoryStream::notifyPeer(std::shared_ptr<State> state) noexcept
+{
+    if (state->_peerError.has_value()) {
+        return;
+    }
+
+    // Best-effort: a failed notification means the peer is gone, which the pipe's read side reports.
+    [[maybe_unused]] auto result = state->_pipe.write(
+        std::span<const uint8_t>(&NOTIFICATION, 1), [](std::expected<void, scaler::wrapper::uv::Error>) {});
+}
+
+void SharedMemoryStream::failPendingWrites(std::shared_ptr<State> state, scaler::wrapper::uv::Error error) noexcept
+{
+    std::deque<PendingWrite> pendingWrites = std::move(state->_pendingWrites);
+    state->_pendingWrites.clear();
+
+    for (PendingWrite& pendingWrite: pendingWrites) {
+        pendingWrite._callback(std::unexpected {error});
+    }
+}
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
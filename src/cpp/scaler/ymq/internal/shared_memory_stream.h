@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "scaler/utility/move_only_function.h"
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/pipe.h"
+#include "scaler/ymq/configuration.h"
+#include "scaler/ymq/internal/shared_memory_segment.h"
+
+namespace scaler {
+namespace ymq {
+namespace internal {
+
+// A byte stream between two processes of the same host, through a pair of lock-free single-producer single-consumer
+// ring buffers in a shared memory segment.
+//
+// The segment is set up over an already connected IPC pipe, which afterwards only carries wake-up notifications: a
+// peer is only notified when it's waiting for data or free space, so that busy streams exchange data without any
+// syscall. The pipe also detects the termination of the peer.
+class SharedMemoryStream {
+public:
+    using UpgradeCallback =
+        scaler::utility::MoveOnlyFunction<void(std::expected<SharedMemoryStream, scaler::wrapper::uv::Error>)>;
+
+    // Create the shared memory segment and send its name over the connected pipe, then call callback with a
+    // ready-to-use SharedMemoryStream once the server mapped it.
+    //
+    // ringCapacity must be a power of two.
+    static void upgradeAsClient(
+        scaler::wrapper::uv::Pipe pipe,
+        UpgradeCallback callback,
+        size_t ringCapacity = sharedMemoryRingCapacity) noexcept;
+
+    // Map the shared memory segment announced by the client over an accepted pipe, then call callback with a
+    // ready-to-use SharedMemoryStream.
+    static void upgradeAsServer(scaler::wrapper::uv::Pipe pipe, UpgradeCallback callback) noexcept;
+
+    ~SharedMemoryStream() noexcept;
+
+    SharedMemoryStream(const SharedMemoryStream&)            = delete;
+    SharedMemoryStream& operator=(const SharedMemoryStream&) = delete;
+
+    SharedMemoryStream(SharedMemoryStream&&) noexcept            = default;
+    SharedMemoryStream& operator=(SharedMemoryStream&&) noexcept = default;
+
+    // The buffers' content must remain valid until the callback is called.
+    //
+    // The callback might be called before write() returns, if the buffers fit in the ring buffer.
+    std::expected<void, scaler::wrapper::uv::Error> write(
+        std::span<const std::span<const uint8_t>> buffers, scaler::wrapper::uv::WriteCallback callback) noexcept;
+
+    // The buffers passed to the callback point into the shared memory segment.
+    std::expected<void, scaler::wrapper::uv::Error> readStart(scaler::wrapper::uv::ReadCallback callback) noexcept;
+
+    void readStop() noexcept;
+
+    // Close the sending side once the pending writes have been copied to the ring buffer. The peer reads UV_EOF once
+    // it consumed them.
+    //
+    // A stream destroyed without being shut down is reported to the peer as UV_ECONNRESET.
+    std::expected<void, scaler::wrapper::uv::Error> shutdown(scaler::wrapper::uv::ShutdownCallback callback) noexcept;
+
+    // Not supported, returns UV_ENOTSUP.
+    std::expected<void, scaler::wrapper::uv::Error> closeReset() noexcept;
+
+    // The number of bytes of the segment shared by the peers, for a given ring capacity.
+    static size_t segmentSize(size_t ringCapacity) noexcept;
+
+private:
+    static constexpr size_t cacheLineSize = 64;
+
+    // The control block of a ring buffer, shared by both processes.
+    //
+    // head and tail are the total number of bytes written and read, and are only updated by the producer and consumer
+    // respectively. Each lives on its own cache line, so that both sides don't invalidate each other's cache on every
+    // update.
+    struct RingControl {
+        alignas(cacheLineSize) std::atomic<uint64_t> _head;
+        alignas(cacheLineSize) std::atomic<uint64_t> _tail;
+
+        // Set by a side before waiting for a notification over the pipe, cleared by the side that sends it.
+        alignas(cacheLineSize) std::atomic<uint32_t> _consumerWaiting;
+        std::atomic<uint32_t> _producerWaiting;
+
+        // Set once the producer shut its sending side down.
+        std::atomic<uint32_t> _producerClosed;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+
+    struct Ring {
+        RingControl* _control;
+        uint8_t* _data;
+        size_t _capacity;
+    };
+
+    struct PendingWrite {
+        // The part of the buffers that is still to be copied to the ring buffer.
+        std::vector<std::span<const uint8_t>> _buffers;
+        scaler::wrapper::uv::WriteCallback _callback;
+    };
+
+    // State is heap-allocated to provide a stable memory for callbacks if the stream is std::move'd.
+
+    struct State {
+        scaler::wrapper::uv::Pipe _pipe;
+        SharedMemorySegment _segment;
+
+        Ring _sendRing;
+        Ring _recvRing;
+
+        std::deque<PendingWrite> _pendingWrites {};
+        bool _processingWrites {false};
+
+        // Shared so that it outlives a readStop() done from the callback itself.
+        std::shared_ptr<scaler::wrapper::uv::ReadCallback> _readCallback {};
+        bool _recvClosed {false};
+
+        std::optional<scaler::wrapper::uv::ShutdownCallback> _shutdownCallback {};
+        bool _sendClosed {false};
+
+        // Set once the pipe has been closed by the peer, or failed.
+        std::optional<scaler::wrapper::uv::Error> _peerError {};
+
+        State(scaler::wrapper::uv::Pipe pipe, SharedMemorySegment segment, bool isServer, size_t ringCapacity) noexcept;
+    };
+
+    explicit SharedMemoryStream(std::shared_ptr<State> state) noexcept;
+
+    static SharedMemoryStream fromSegment(
+        scaler::wrapper::uv::Pipe pipe, SharedMemorySegment segment, bool isServer, size_t ringCapacity) noexcept;
+
+    static void onPipeRead(
+        std::shared_ptr<State> state,
+        std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) noexcept;
+
+    // Delivers the received bytes to the read callback, then UV_EOF once the peer closed its sending side.
+    static void processRecvRing(std::shared_ptr<State> state) noexcept;
+
+    // Copies the pending writes to the ring buffer, and completes the shutdown once they're all copied.
+    static void processPendingWrites(std::shared_ptr<State> state) noexcept;
+
+    static void finishShutdown(std::shared_ptr<State> state) noexcept;
+
+    static void notifyPeer(std::shared_ptr<State> state) noexcept;
+
+    static void failPendingWrites(std::shared_ptr<State> state, scaler::wrapper::uv::Error error) noexcept;
+
+    std::shared_ptr<State> _state;
+};
+
+}  // namespace internal
+}  // namespace ymq
+}  // namespace scaler
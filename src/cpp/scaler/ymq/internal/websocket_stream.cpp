@@ -1,11 +1,12 @@
 #include "scaler/ymq/internal/websocket_stream.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <expected>
 #include <memory>
 #include <optional>
-#include <random>
 #include <span>
 #include <string>
 #include <string_view>
@@ -42,6 +43,9 @@ static constexpr uint8_t PAYLOAD_LEN_64BIT         = 127;
 static constexpr size_t PAYLOAD_LEN_16BIT_MAX      = 65536;
 static constexpr uint8_t MAX_CONTROL_FRAME_PAYLOAD = 125;
 
+// The largest possible frame header: 2 bytes, an 8-byte extended payload length and a 4-byte masking key.
+static constexpr size_t MAX_FRAME_HEADER_SIZE = 14;
+
 std::string buildClientUpgradeRequest(
     const std::string& host, uint16_t port, const std::string& path, const std::string& key) noexcept
 {
@@ -70,58 +74,43 @@ std::string buildServerUpgradeResponse(const std::string& key) noexcept
            "\r\n";
 }
 
-// Returns the frame header bytes for a server-side frame (unmasked).
-std::vector<uint8_t> buildServerFrameHeader(size_t payloadSize) noexcept
+struct FrameHeader {
+    std::array<uint8_t, MAX_FRAME_HEADER_SIZE> bytes;
+    size_t size;
+
+    std::span<const uint8_t> span() const noexcept
+    {
+        return {bytes.data(), size};
+    }
+};
+
+// Encodes a frame header (RFC 6455 section 5.2). Frames sent by clients must carry a masking key, frames sent by
+// servers must not.
+FrameHeader encodeFrameHeader(
+    uint8_t opcode, size_t payloadSize, const std::optional<WebSocketMaskKey>& maskKey) noexcept
 {
-    std::vector<uint8_t> header;
-    header.push_back(FLAG_FIN | OPCODE_BINARY);
+    FrameHeader header {};
+    const uint8_t maskFlag = maskKey.has_value() ? FLAG_MASKED : 0;
+
+    header.bytes[header.size++] = FLAG_FIN | opcode;
     if (payloadSize < PAYLOAD_LEN_16BIT) {
-        header.push_back(static_cast<uint8_t>(payloadSize));
+        header.bytes[header.size++] = maskFlag | static_cast<uint8_t>(payloadSize);
     } else if (payloadSize < PAYLOAD_LEN_16BIT_MAX) {
-        header.push_back(PAYLOAD_LEN_16BIT);
-        header.push_back(static_cast<uint8_t>((payloadSize >> 8) & 0xFF));
-        header.push_back(static_cast<uint8_t>(payloadSize & 0xFF));
+        header.bytes[header.size++] = maskFlag | PAYLOAD_LEN_16BIT;
+        header.bytes[header.size++] = static_cast<uint8_t>((payloadSize >> 8) & 0xFF);
+        header.bytes[header.size++] = static_cast<uint8_t>(payloadSize & 0xFF);
     } else {
-        header.push_back(PAYLOAD_LEN_64BIT);
+        header.bytes[header.size++] = maskFlag | PAYLOAD_LEN_64BIT;
         for (int i = 7; i >= 0; --i)
-            header.push_back(static_cast<uint8_t>((payloadSize >> (i * 8)) & 0xFF));
+            header.bytes[header.size++] = static_cast<uint8_t>((payloadSize >> (i * 8)) & 0xFF);
     }
-    return header;
-}
 
-// Returns {header+mask, masked-payload-copy} for a client-side frame (masked, RFC 6455 section 5.3).
-std::pair<std::vector<uint8_t>, std::vector<uint8_t>> buildClientFrame(
-    std::span<const std::span<const uint8_t>> buffers, size_t totalSize) noexcept
-{
-    static thread_local std::mt19937 rng(std::random_device {}());
-    std::uniform_int_distribution<uint32_t> dist;
-    std::array<uint8_t, 4> maskKey;
-    const uint32_t maskInt = dist(rng);
-    std::memcpy(maskKey.data(), &maskInt, 4);
-
-    std::vector<uint8_t> header;
-    header.push_back(FLAG_FIN | OPCODE_BINARY);
-    if (totalSize < PAYLOAD_LEN_16BIT) {
-        header.push_back(FLAG_MASKED | static_cast<uint8_t>(totalSize));
-    } else if (totalSize < PAYLOAD_LEN_16BIT_MAX) {
-        header.push_back(FLAG_MASKED | PAYLOAD_LEN_16BIT);
-        header.push_back(static_cast<uint8_t>((totalSize >> 8) & 0xFF));
-        header.push_back(static_cast<uint8_t>(totalSize & 0xFF));
-    } else {
-        header.push_back(FLAG_MASKED | PAYLOAD_LEN_64BIT);
-        for (int i = 7; i >= 0; --i)
-            header.push_back(static_cast<uint8_t>((totalSize >> (i * 8)) & 0xFF));
+    if (maskKey.has_value()) {
+        std::memcpy(header.bytes.data() + header.size, maskKey->data(), maskKey->size());
+        header.size += maskKey->size();
     }
-    header.insert(header.end(), maskKey.begin(), maskKey.end());
 
-    std::vector<uint8_t> masked;
-    masked.reserve(totalSize);
-    size_t pos = 0;
-    for (const auto& buf: buffers) {
-        for (uint8_t byte: buf)
-            masked.push_back(byte ^ maskKey[pos++ % 4]);
-    }
-    return {std::move(header), std::move(masked)};
+    return header;
 }
 
 // Builds a control frame (CLOSE, PING, PONG). RFC 6455 section 5.5:
@@ -129,43 +118,46 @@ std::pair<std::vector<uint8_t>, std::vector<uint8_t>> buildClientFrame(
 // Client frames must be masked; server frames must not.
 std::vector<uint8_t> buildControlFrame(uint8_t opcode, bool isClient, std::span<const uint8_t> payload) noexcept
 {
-    static thread_local std::mt19937 rng(std::random_device {}());
-    std::uniform_int_distribution<uint32_t> dist;
-
-    const uint8_t len = static_cast<uint8_t>(payload.size());  // caller ensures <= 125
-
-    std::vector<uint8_t> frame;
-    frame.push_back(FLAG_FIN | opcode);
-    if (isClient) {
-        frame.push_back(FLAG_MASKED | len);
-        std::array<uint8_t, 4> maskKey;
-        const uint32_t maskInt = dist(rng);
-        std::memcpy(maskKey.data(), &maskInt, 4);
-        frame.insert(frame.end(), maskKey.begin(), maskKey.end());
-        for (size_t i = 0; i < payload.size(); ++i)
-            frame.push_back(payload[i] ^ maskKey[i % 4]);
-    } else {
-        frame.push_back(len);
-        frame.insert(frame.end(), payload.begin(), payload.end());
-    }
+    const std::optional<WebSocketMaskKey> maskKey =
+        isClient ? std::optional {generateWebSocketMaskKey()} : std::nullopt;
+
+    // caller ensures payload.size() <= 125
+    const FrameHeader header = encodeFrameHeader(opcode, payload.size(), maskKey);
+
+    std::vector<uint8_t> frame(header.size + payload.size());
+    std::memcpy(frame.data(), header.bytes.data(), header.size);
+
+    const std::span<uint8_t> framePayload(frame.data() + header.size, payload.size());
+    if (maskKey.has_value())
+        applyWebSocketMask(payload, framePayload, *maskKey);
+    else
+        std::ranges::copy(payload, framePayload.begin());
+
     return frame;
 }
 
-struct DecodedFrame {
+struct DecodedFrameHeader {
     uint8_t opcode;
     bool fin;
-    std::vector<uint8_t> payload;
+    std::optional<WebSocketMaskKey> maskKey;
+    size_t headerSize;
+    size_t payloadSize;
+
+    size_t frameSize() const noexcept
+    {
+        return headerSize + payloadSize;
+    }
 };
 
-// Tries to parse one complete WebSocket frame from buffer, consuming it in-place.
-//   unexpected(error) - protocol error
-//   {nullopt}         - buffer does not yet contain a full frame
-//   {DecodedFrame}    - one frame decoded and consumed
-std::expected<std::optional<DecodedFrame>, scaler::wrapper::uv::Error> tryDecodeFrame(
-    std::vector<uint8_t>& buffer) noexcept
+// Tries to parse the header of the WebSocket frame at the start of buffer, without consuming it.
+//   unexpected(error)    - protocol error
+//   {nullopt}            - buffer does not yet contain the full header
+//   {DecodedFrameHeader} - header decoded, the payload might not be fully received yet
+std::expected<std::optional<DecodedFrameHeader>, scaler::wrapper::uv::Error> tryDecodeFrameHeader(
+    std::span<const uint8_t> buffer) noexcept
 {
     if (buffer.size() < 2)
-        return std::optional<DecodedFrame> {std::nullopt};
+        return std::optional<DecodedFrameHeader> {std::nullopt};
 
     const uint8_t byte0  = buffer[0];
     const uint8_t byte1  = buffer[1];
@@ -177,39 +169,33 @@ std::expected<std::optional<DecodedFrame>, scaler::wrapper::uv::Error> tryDecode
 
     if (payloadLen == PAYLOAD_LEN_16BIT) {
         if (buffer.size() < 4)
-            return std::optional<DecodedFrame> {std::nullopt};
+            return std::optional<DecodedFrameHeader> {std::nullopt};
         payloadLen = (uint64_t(buffer[2]) << 8) | buffer[3];
         headerSize = 4;
     } else if (payloadLen == PAYLOAD_LEN_64BIT) {
         if (buffer.size() < 10)
-            return std::optional<DecodedFrame> {std::nullopt};
+            return std::optional<DecodedFrameHeader> {std::nullopt};
         payloadLen = 0;
         for (int i = 0; i < 8; ++i)
             payloadLen = (payloadLen << 8) | buffer[2 + i];
         headerSize = 10;
-    }
-
-    if (masked)
-        headerSize += 4;
 
-    if (buffer.size() < headerSize + static_cast<size_t>(payloadLen))
-        return std::optional<DecodedFrame> {std::nullopt};
+        // The most significant bit of a 64-bit length must be 0 (RFC 6455 section 5.2).
+        if (payloadLen >> 63)
+            return std::unexpected(scaler::wrapper::uv::Error {UV_EPROTO});
+    }
 
-    std::vector<uint8_t> payload(static_cast<size_t>(payloadLen));
+    std::optional<WebSocketMaskKey> maskKey {};
     if (masked) {
-        const uint8_t* maskKey = buffer.data() + headerSize - 4;
-        for (size_t i = 0; i < static_cast<size_t>(payloadLen); ++i)
-            payload[i] = buffer[headerSize + i] ^ maskKey[i % 4];
-    } else {
-        std::copy(
-            buffer.begin() + static_cast<std::ptrdiff_t>(headerSize),
-            buffer.begin() + static_cast<std::ptrdiff_t>(headerSize + static_cast<size_t>(payloadLen)),
-            payload.begin());
+        if (buffer.size() < headerSize + 4)
+            return std::optional<DecodedFrameHeader> {std::nullopt};
+        maskKey.emplace();
+        std::memcpy(maskKey->data(), buffer.data() + headerSize, 4);
+        headerSize += 4;
     }
 
-    buffer.erase(
-        buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(headerSize + static_cast<size_t>(payloadLen)));
-    return std::optional<DecodedFrame> {DecodedFrame {opcode, fin, std::move(payload)}};
+    return std::optional<DecodedFrameHeader> {
+        DecodedFrameHeader {opcode, fin, maskKey, headerSize, static_cast<size_t>(payloadLen)}};
 }
 
 }  // anonymous namespace
@@ -470,12 +456,11 @@ std::expected<void, scaler::wrapper::uv::Error> WebSocketStream::write(
         totalSize += buf.size();
 
     if (_state->_isServer) {
-        auto header     = std::make_shared<std::vector<uint8_t>>(buildServerFrameHeader(totalSize));
-        auto headerSpan = std::span<const uint8_t>(*header);
+        auto header = std::make_shared<FrameHeader>(encodeFrameHeader(OPCODE_BINARY, totalSize, std::nullopt));
 
         std::vector<std::span<const uint8_t>> writeBuffers;
         writeBuffers.reserve(buffers.size() + 1);
-        writeBuffers.push_back(headerSpan);
+        writeBuffers.push_back(header->span());
         for (const auto& buf: buffers)
             writeBuffers.push_back(buf);
 
@@ -489,17 +474,26 @@ std::expected<void, scaler::wrapper::uv::Error> WebSocketStream::write(
         return {};
     }
 
-    auto [header, masked] = buildClientFrame(buffers, totalSize);
-    auto headerData       = std::make_shared<std::vector<uint8_t>>(std::move(header));
-    auto maskedData       = std::make_shared<std::vector<uint8_t>>(std::move(masked));
+    // Client frames must be masked (RFC 6455 section 5.3). The caller's buffers can't be masked in place (they might
+    // be shared with other connections), so the frame is assembled in a single allocation, masked while being copied.
+    const WebSocketMaskKey maskKey = generateWebSocketMaskKey();
+    const FrameHeader header       = encodeFrameHeader(OPCODE_BINARY, totalSize, maskKey);
+
+    const size_t frameSize = header.size + totalSize;
+    auto frame             = std::make_shared_for_overwrite<uint8_t[]>(frameSize);
+    std::memcpy(frame.get(), header.bytes.data(), header.size);
+
+    size_t offset = 0;
+    for (const auto& buf: buffers) {
+        applyWebSocketMask(buf, std::span<uint8_t>(frame.get() + header.size + offset, buf.size()), maskKey, offset);
+        offset += buf.size();
+    }
 
-    const std::span<const uint8_t> headerSpan(*headerData);
-    const std::span<const uint8_t> maskedSpan(*maskedData);
-    const std::array<std::span<const uint8_t>, 2> writeBuffers {headerSpan, maskedSpan};
+    const std::span<const uint8_t> frameSpan(frame.get(), frameSize);
 
     auto result = _state->_socket.write(
-        std::span<const std::span<const uint8_t>>(writeBuffers),
-        [headerData = std::move(headerData), maskedData = std::move(maskedData), callback = std::move(callback)](
+        frameSpan,
+        [frame = std::move(frame), callback = std::move(callback)](
             std::expected<void, scaler::wrapper::uv::Error> err) mutable { callback(err); });
 
     if (!result.has_value())
@@ -518,6 +512,25 @@ void WebSocketStream::onRead(
     }
 
     const auto& data = result.value();
+
+    if (state->_recvOffset == state->_recvBuffer.size()) {
+        // Nothing buffered: decode the complete frames straight from the read buffer, and only buffer what's left.
+        state->_recvBuffer.clear();
+        state->_recvOffset = 0;
+
+        const size_t consumed = processFrames(state, data, false);
+        state->_recvBuffer.insert(state->_recvBuffer.end(), data.begin() + consumed, data.end());
+        return;
+    }
+
+    // Drop the already processed frames before appending, so that the buffer only moves the partial frame once per
+    // read, rather than once per decoded frame.
+    if (state->_recvOffset > 0) {
+        state->_recvBuffer.erase(
+            state->_recvBuffer.begin(), state->_recvBuffer.begin() + static_cast<std::ptrdiff_t>(state->_recvOffset));
+        state->_recvOffset = 0;
+    }
+
     state->_recvBuffer.insert(state->_recvBuffer.end(), data.begin(), data.end());
 
     processRecvBuffer(state);
@@ -525,75 +538,117 @@ void WebSocketStream::onRead(
 
 void WebSocketStream::processRecvBuffer(std::shared_ptr<State> state) noexcept
 {
-    while (state->_readActive && !state->_recvBuffer.empty()) {
-        auto frameResult = tryDecodeFrame(state->_recvBuffer);
-        if (!frameResult.has_value()) {
-            state->_readCallback(std::unexpected(frameResult.error()));
-            return;
+    const std::span<const uint8_t> buffered(state->_recvBuffer);
+    processFrames(state, buffered.subspan(state->_recvOffset), true);
+}
+
+size_t WebSocketStream::processFrames(
+    std::shared_ptr<State> state, std::span<const uint8_t> frames, bool inRecvBuffer) noexcept
+{
+    size_t consumed = 0;
+
+    while (state->_readActive && consumed < frames.size()) {
+        const auto remaining = frames.subspan(consumed);
+
+        auto headerResult = tryDecodeFrameHeader(remaining);
+        if (!headerResult.has_value()) {
+            state->_readCallback(std::unexpected(headerResult.error()));
+            return consumed;
         }
-        if (!frameResult->has_value())
+        if (!headerResult->has_value() || remaining.size() < headerResult->value().frameSize())
             break;  // need more data
 
-        auto& frame = frameResult->value();
-
-        if (frame.opcode == OPCODE_CLOSE) {
-            // CLOSE: echo a CLOSE frame then signal clean disconnect.
-            auto closeFrame = buildControlFrame(OPCODE_CLOSE, !state->_isServer, {});
-            auto frameData  = std::make_shared<std::vector<uint8_t>>(std::move(closeFrame));
-            const std::span<const uint8_t> frameSpan(*frameData);
-            // Best-effort CLOSE echo - connection is shutting down regardless.
-            if (auto r = state->_socket.write(
-                    std::span<const std::span<const uint8_t>>(&frameSpan, 1),
-                    [frameData = std::move(frameData)](std::expected<void, scaler::wrapper::uv::Error>) {});
-                !r.has_value()) {
+        const DecodedFrameHeader& header = headerResult->value();
+        std::span<const uint8_t> payload = remaining.subspan(header.headerSize, header.payloadSize);
+
+        if (header.maskKey.has_value()) {
+            if (inRecvBuffer) {
+                // The payload lies in our own receive buffer, unmask it in place.
+                const auto payloadOffset = static_cast<size_t>(payload.data() - state->_recvBuffer.data());
+                const std::span<uint8_t> unmasked(state->_recvBuffer.data() + payloadOffset, payload.size());
+                applyWebSocketMask(payload, unmasked, *header.maskKey);
+            } else {
+                if (state->_unmaskBuffer.size() < payload.size())
+                    state->_unmaskBuffer.resize(payload.size());
+                applyWebSocketMask(payload, state->_unmaskBuffer, *header.maskKey);
+                payload = std::span<const uint8_t>(state->_unmaskBuffer.data(), payload.size());
             }
-            if (state->_readActive && state->_readCallback)
-                state->_readCallback(std::unexpected(scaler::wrapper::uv::Error {UV_EOF}));
-            return;
         }
 
-        if (frame.opcode == OPCODE_PING) {
-            // PING: respond with PONG carrying the same payload (RFC 6455 section 5.5.3).
-            auto pongPayload = frame.payload;
-            if (pongPayload.size() > MAX_CONTROL_FRAME_PAYLOAD)
-                pongPayload.resize(MAX_CONTROL_FRAME_PAYLOAD);
-            auto pongFrame = buildControlFrame(OPCODE_PONG, !state->_isServer, pongPayload);
-            auto frameData = std::make_shared<std::vector<uint8_t>>(std::move(pongFrame));
-            const std::span<const uint8_t> frameSpan(*frameData);
-            // Best-effort PONG - if this write fails the next read will catch the error.
-            if (auto r = state->_socket.write(
-                    std::span<const std::span<const uint8_t>>(&frameSpan, 1),
-                    [frameData = std::move(frameData)](std::expected<void, scaler::wrapper::uv::Error>) {});
-                !r.has_value()) {
-            }
-            continue;
+        consumed += header.frameSize();
+
+        // Advance the cursor before running the callbacks, which might re-enter processRecvBuffer() through
+        // readStart().
+        if (inRecvBuffer)
+            state->_recvOffset += header.frameSize();
+
+        if (!processFrame(state, header.opcode, header.fin, payload))
+            break;
+    }
+
+    return consumed;
+}
+
+bool WebSocketStream::processFrame(
+    std::shared_ptr<State> state, uint8_t opcode, bool fin, std::span<const uint8_t> payload) noexcept
+{
+    if (opcode == OPCODE_CLOSE) {
+        // CLOSE: echo a CLOSE frame then signal clean disconnect.
+        auto closeFrame = buildControlFrame(OPCODE_CLOSE, !state->_isServer, {});
+        auto frameData  = std::make_shared<std::vector<uint8_t>>(std::move(closeFrame));
+        const std::span<const uint8_t> frameSpan(*frameData);
+        // Best-effort CLOSE echo - connection is shutting down regardless.
+        if (auto r = state->_socket.write(
+                std::span<const std::span<const uint8_t>>(&frameSpan, 1),
+                [frameData = std::move(frameData)](std::expected<void, scaler::wrapper::uv::Error>) {});
+            !r.has_value()) {
         }
+        if (state->_readActive && state->_readCallback)
+            state->_readCallback(std::unexpected(scaler::wrapper::uv::Error {UV_EOF}));
+        return false;
+    }
 
-        if (frame.opcode == OPCODE_PONG) {
-            // PONG: unsolicited or in response to our PING - ignore.
-            continue;
+    if (opcode == OPCODE_PING) {
+        // PING: respond with PONG carrying the same payload (RFC 6455 section 5.5.3).
+        auto pongPayload = payload.first(std::min<size_t>(payload.size(), MAX_CONTROL_FRAME_PAYLOAD));
+        auto pongFrame   = buildControlFrame(OPCODE_PONG, !state->_isServer, pongPayload);
+        auto frameData   = std::make_shared<std::vector<uint8_t>>(std::move(pongFrame));
+        const std::span<const uint8_t> frameSpan(*frameData);
+        // Best-effort PONG - if this write fails the next read will catch the error.
+        if (auto r = state->_socket.write(
+                std::span<const std::span<const uint8_t>>(&frameSpan, 1),
+                [frameData = std::move(frameData)](std::expected<void, scaler::wrapper::uv::Error>) {});
+            !r.has_value()) {
         }
+        return true;
+    }
 
-        // Data frames: handle fragmentation per RFC 6455 section 5.4.
-        if (frame.opcode == OPCODE_TEXT || frame.opcode == OPCODE_BINARY) {
-            if (frame.fin) {
-                // Complete single-frame message.
-                state->_readCallback(std::span<const uint8_t>(frame.payload));
-            } else {
-                // First fragment - start accumulating.
-                state->_fragmentBuffer = std::move(frame.payload);
-            }
-        } else if (frame.opcode == OPCODE_CONTINUATION) {
-            // Continuation frame.
-            state->_fragmentBuffer.insert(state->_fragmentBuffer.end(), frame.payload.begin(), frame.payload.end());
-            if (frame.fin) {
-                // Final fragment - deliver assembled message.
-                state->_readCallback(std::span<const uint8_t>(state->_fragmentBuffer));
-                state->_fragmentBuffer.clear();
-            }
+    if (opcode == OPCODE_PONG) {
+        // PONG: unsolicited or in response to our PING - ignore.
+        return true;
+    }
+
+    // Data frames: handle fragmentation per RFC 6455 section 5.4.
+    if (opcode == OPCODE_TEXT || opcode == OPCODE_BINARY) {
+        if (fin) {
+            // Complete single-frame message.
+            state->_readCallback(payload);
+        } else {
+            // First fragment - start accumulating.
+            state->_fragmentBuffer.assign(payload.begin(), payload.end());
+        }
+    } else if (opcode == OPCODE_CONTINUATION) {
+        // Continuation frame.
+        state->_fragmentBuffer.insert(state->_fragmentBuffer.end(), payload.begin(), payload.end());
+        if (fin) {
+            // Final fragment - deliver assembled message.
+            state->_readCallback(std::span<const uint8_t>(state->_fragmentBuffer));
+            state->_fragmentBuffer.clear();
         }
-        // Reserved opcodes are silently ignored.
     }
+    // Reserved opcodes are silently ignored.
+
+    return true;
 }
 
 std::expected<void, scaler::wrapper::uv::Error> WebSocketStream::readStart(
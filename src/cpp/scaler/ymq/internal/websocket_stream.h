@@ -71,7 +71,11 @@ private:
     struct State {
         scaler::wrapper::uv::TCPSocket _socket;
         bool _isServer;
+        // Received bytes, of which the first _recvOffset have already been decoded.
         std::vector<uint8_t> _recvBuffer {};
+        size_t _recvOffset {0};
+        // Holds the unmasked payload of frames decoded straight from a read buffer.
+        std::vector<uint8_t> _unmaskBuffer {};
         std::vector<uint8_t> _fragmentBuffer {};
         bool _readActive {false};
         scaler::wrapper::uv::ReadCallback _readCallback {};
@@ -87,6 +91,17 @@ private:
 
     static void processRecvBuffer(std::shared_ptr<State> state) noexcept;
 
+    // Decodes and processes the complete frames at the start of frames, returns the number of bytes consumed.
+    //
+    // When inRecvBuffer, frames points into _recvBuffer: masked payloads are unmasked in place and _recvOffset is
+    // advanced as frames are consumed.
+    static size_t processFrames(
+        std::shared_ptr<State> state, std::span<const uint8_t> frames, bool inRecvBuffer) noexcept;
+
+    // Returns false if the frame closed the connection.
+    static bool processFrame(
+        std::shared_ptr<State> state, uint8_t opcode, bool fin, std::span<const uint8_t> payload) noexcept;
+
     std::shared_ptr<State> _state;
 };
 
@@ -10,6 +10,16 @@
 #include <string_view>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace scaler {
 namespace ymq {
 namespace internal {
@@ -116,6 +126,68 @@ std::string generateWebSocketKey() noexcept
     return base64Encode(std::span<const uint8_t>(keyBytes));
 }
 
+WebSocketMaskKey generateWebSocketMaskKey() noexcept
+{
+    static thread_local std::mt19937 rng(std::random_device {}());
+    std::uniform_int_distribution<uint32_t> dist;
+    WebSocketMaskKey maskKey;
+    const uint32_t v = dist(rng);
+    std::memcpy(maskKey.data(), &v, 4);
+    return maskKey;
+}
+
+void applyWebSocketMask(
+    std::span<const uint8_t> source,
+    std::span<uint8_t> destination,
+    const WebSocketMaskKey& maskKey,
+    size_t keyOffset) noexcept
+{
+    // Rotate the key so that its first byte applies to source[0]. All the wide loops below process multiples of 4
+    // bytes, so the key stays aligned with the payload from one loop to the next.
+    WebSocketMaskKey key;
+    for (size_t i = 0; i < key.size(); ++i)
+        key[i] = maskKey[(keyOffset + i) % key.size()];
+
+    uint32_t key32;
+    std::memcpy(&key32, key.data(), sizeof(key32));
+
+    const uint8_t* src = source.data();
+    uint8_t* dst       = destination.data();
+    const size_t size  = source.size();
+    size_t i           = 0;
+
+#if defined(__AVX2__)
+    const __m256i key256 = _mm256_set1_epi32(static_cast<int>(key32));
+    for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(block, key256));
+    }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i key128 = _mm_set1_epi32(static_cast<int>(key32));
+    for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(block, key128));
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t key128 = vreinterpretq_u8_u32(vdupq_n_u32(key32));
+    for (; i + sizeof(uint8x16_t) <= size; i += sizeof(uint8x16_t))
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), key128));
+#endif
+
+    const uint64_t key64 = (uint64_t(key32) << 32) | key32;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t block;
+        std::memcpy(&block, src + i, sizeof(block));
+        block ^= key64;
+        std::memcpy(dst + i, &block, sizeof(block));
+    }
+
+    for (; i < size; ++i)
+        dst[i] = src[i] ^ key[i % key.size()];
+}
+
 std::string computeWebSocketAccept(const std::string& key) noexcept
 {
     const std::string_view magic = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
@@ -17,6 +17,22 @@ std::string toLower(std::string_view s) noexcept;
 std::string generateWebSocketKey() noexcept;
 std::string computeWebSocketAccept(const std::string& key) noexcept;
 
+// The 4-byte key that client frames are XOR-masked with (RFC 6455 section 5.3).
+using WebSocketMaskKey = std::array<uint8_t, 4>;
+
+WebSocketMaskKey generateWebSocketMaskKey() noexcept;
+
+// Writes source XOR-ed with the masking key into destination, which must be at least as large as source and may be
+// source itself. keyOffset is the position of source's first byte within the masked payload, so that a payload spread
+// over several buffers can be masked one buffer at a time.
+//
+// Uses SIMD instructions (AVX2, SSE2 or NEON) when the target supports them.
+void applyWebSocketMask(
+    std::span<const uint8_t> source,
+    std::span<uint8_t> destination,
+    const WebSocketMaskKey& maskKey,
+    size_t keyOffset = 0) noexcept;
+
 // Parses all headers from an HTTP request/response block (including the first request/status line)
 // in a single pass. Returns a map with lowercase header names and original-case values.
 // Handles both "Name: value" and "Name:value" (RFC 7230 optional whitespace).
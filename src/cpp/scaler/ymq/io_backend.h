@@ -0,0 +1,20 @@
+#pragma once
+
+namespace scaler {
+namespace ymq {
+
+// The implementation of the IO threads of an IOContext.
+enum class IOBackend {
+    // libuv's readiness-based event loop (epoll, kqueue, IOCP), doing one syscall per read and write.
+    LibUV,
+
+    // Linux only. The TCP connections (tcp://) of each thread are served by an io_uring instance: reads are multishot
+    // receives into provided buffers, and the writes issued during a loop iteration are submitted at once as a chain
+    // of linked sends. The other transports still run on libuv.
+    //
+    // Falls back to LibUV if io_uring is not available (e.g. older kernels, or disabled by a seccomp policy).
+    IOUring,
+};
+
+}  // namespace ymq
+}  // namespace scaler
@@ -5,10 +5,25 @@
 namespace scaler {
 namespace ymq {
 
-IOContext::IOContext(size_t threadCount) noexcept
-    : _threads(threadCount), _threadsRoundRobin {std::make_unique<std::atomic<size_t>>(0)}
+IOContext::IOContext(size_t threadCount, IOBackend backend) noexcept
+    : _threadsRoundRobin {std::make_unique<std::atomic<size_t>>(0)}
 {
     assert(threadCount > 0);
+
+    // The threads are never moved once started.
+    _threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        _threads.emplace_back(backend);
+    }
+}
+
+IOContext::~IOContext() noexcept
+{
+    // std::vector does not specify the destruction order of its elements. A multi-threaded BinderSocket relies on it
+    // to shut down its threads.
+    while (!_threads.empty()) {
+        _threads.pop_back();
+    }
 }
 
 internal::EventLoopThread& IOContext::nextThread() noexcept
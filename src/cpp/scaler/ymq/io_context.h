@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "scaler/ymq/internal/event_loop_thread.h"
+#include "scaler/ymq/io_backend.h"
 
 namespace scaler {
 namespace ymq {
@@ -12,9 +13,10 @@ namespace ymq {
 // Manages a pool of IO event threads.
 class IOContext {
 public:
-    IOContext(size_t threadCount = 1) noexcept;
+    IOContext(size_t threadCount = 1, IOBackend backend = IOBackend::LibUV) noexcept;
 
-    ~IOContext() noexcept = default;
+    // Stop and destroy the threads in the reverse order of their creation.
+    ~IOContext() noexcept;
 
     IOContext(const IOContext&)            = delete;
     IOContext& operator=(const IOContext&) = delete;
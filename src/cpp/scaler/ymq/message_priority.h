@@ -0,0 +1,20 @@
+#pragma once
+
+namespace scaler {
+namespace ymq {
+
+// The sending priority of a message, relative to the other messages sent to the same peer.
+enum class MessagePriority {
+    // Sent in order with the other normal priority messages.
+    //
+    // Large messages are sent in fragments, so that they don't delay the high priority messages sent after them.
+    Normal,
+
+    // Sent before any queued normal priority message, possibly in between the fragments of a large one.
+    //
+    // Meant for small control messages (e.g. heartbeats), these are never fragmented.
+    High,
+};
+
+}  // namespace ymq
+}  // namespace scaler
@@ -31,6 +31,8 @@ int PyAddressType_createEnum(PyObject* pyModule, YMQState* state)
         {
             {"IPC", (int)scaler::ymq::Address::Type::IPC},
             {"TCP", (int)scaler::ymq::Address::Type::TCP},
+            {"WebSocket", (int)scaler::ymq::Address::Type::WebSocket},
+            {"SharedMemory", (int)scaler::ymq::Address::Type::SharedMemory},
         });
 }
 
@@ -7,6 +7,7 @@
 #include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 // First-party
 #include "scaler/error/error.h"
@@ -40,26 +41,40 @@ static int PyBinderSocket_init(PyBinderSocket* self, PyObject* args, PyObject* k
     if (!state)
         return -1;
 
-    PyIOContext* pyIOContext = nullptr;
-    const char* identity     = nullptr;
-    Py_ssize_t identityLen   = 0;
-    const char* kwlist[]     = {"context", "identity", nullptr};
+    PyIOContext* pyIOContext        = nullptr;
+    const char* identity            = nullptr;
+    Py_ssize_t identityLen          = 0;
+    Py_ssize_t numThreads           = 1;
+    unsigned long maxQueuedMessages = 0;
+    unsigned long maxQueuedBytes    = 0;
+    const char* kwlist[] = {"context", "identity", "num_threads", "max_queued_messages", "max_queued_bytes", nullptr};
 
     if (!PyArg_ParseTupleAndKeywords(
             args,
             kwds,
-            "O!s#",
+            "O!s#|nkk",
             (char**)kwlist,
             (PyTypeObject*)state->PyIOContextType.get(),
             &pyIOContext,
             &identity,
-            &identityLen))
+            &identityLen,
+            &numThreads,
+            &maxQueuedMessages,
+            &maxQueuedBytes))
         return -1;
 
+    if (numThreads < 1) {
+        PyErr_SetString(PyExc_ValueError, "num_threads must be at least 1");
+        return -1;
+    }
+
     try {
         self->ioContext = pyIOContext->ioContext;
-        self->socket =
-            std::make_unique<BinderSocket>(*self->ioContext, Identity {identity, static_cast<size_t>(identityLen)});
+        self->socket    = std::make_unique<BinderSocket>(
+            *self->ioContext,
+            Identity {identity, static_cast<size_t>(identityLen)},
+            static_cast<size_t>(numThreads),
+            SendQueueLimits {.maxMessages = maxQueuedMessages, .maxBytes = maxQueuedBytes});
     } catch (...) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to create BinderSocket");
         return -1;
@@ -162,18 +177,24 @@ static PyObject* PyBinderSocket_send_message(PyBinderSocket* self, PyObject* arg
     const char* remoteIdentity   = nullptr;
     Py_ssize_t remoteIdentityLen = 0;
     PyBytes* messagePayload      = nullptr;
-    const char* kwlist[]         = {"on_message_send", "remote_identity", "message_payload", nullptr};
+    int priorityValue            = (int)scaler::ymq::MessagePriority::Normal;
+    const char* kwlist[]         = {"on_message_send", "remote_identity", "message_payload", "priority", nullptr};
 
     if (!PyArg_ParseTupleAndKeywords(
             args,
             kwargs,
-            "Os#O!",
+            "Os#O!|i",
             (char**)kwlist,
             &callback,
             &remoteIdentity,
             &remoteIdentityLen,
             (PyTypeObject*)state->PyBytesType.get(),
-            &messagePayload))
+            &messagePayload,
+            &priorityValue))
+        return nullptr;
+
+    scaler::ymq::MessagePriority priority {};
+    if (!PyMessagePriority_fromInt(priorityValue, &priority))
         return nullptr;
 
     try {
@@ -194,7 +215,8 @@ static PyObject* PyBinderSocket_send_message(PyBinderSocket* self, PyObject* arg
                 }
 
                 completeCallback(callback, OwnedPyObject<>::none());
-            });
+            },
+            priority);
     } catch (...) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to send message");
         return nullptr;
@@ -265,26 +287,7 @@ static PyObject* PyBinderSocket_recv_message(PyBinderSocket* self, PyObject* arg
                 return;
             }
 
-            scaler::ymq::Message& message = result.value();
-
-            OwnedPyObject<PyBytes> address = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
-            if (!address) {
-                completeCallbackWithRaisedException(callback);
-                return;
-            }
-
-            address->bytes = std::move(message.address);
-
-            OwnedPyObject<PyBytes> payload = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
-            if (!payload) {
-                completeCallbackWithRaisedException(callback);
-                return;
-            }
-
-            payload->bytes = std::move(message.payload);
-
-            OwnedPyObject pyMessage =
-                PyObject_CallFunction(state->PyMessageType.get(), "OO", address.get(), payload.get());
+            OwnedPyObject pyMessage = PyMessage_fromMessage(state, std::move(result.value()));
             if (!pyMessage) {
                 completeCallbackWithRaisedException(callback);
                 return;
@@ -300,6 +303,69 @@ static PyObject* PyBinderSocket_recv_message(PyBinderSocket* self, PyObject* arg
     Py_RETURN_NONE;
 }
 
+static PyObject* PyBinderSocket_recv_messages(PyBinderSocket* self, PyObject* args, PyObject* kwargs)
+{
+    auto state = YMQStateFromSelf((PyObject*)self);
+    if (!state)
+        return nullptr;
+
+    PyObject* callback   = nullptr;
+    Py_ssize_t maxCount  = 0;
+    const char* kwlist[] = {"callback", "max_count", nullptr};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "On", (char**)kwlist, &callback, &maxCount))
+        return nullptr;
+
+    if (maxCount < 1) {
+        PyErr_SetString(PyExc_ValueError, "max_count must be at least 1");
+        return nullptr;
+    }
+
+    try {
+        self->socket->recvMessages(
+            static_cast<size_t>(maxCount),
+            [callback_ = OwnedPyObject<>::fromBorrowed(callback),
+             state](std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error> result) {
+                // The whole batch is converted under a single GIL acquisition.
+                AcquireGIL _;
+
+                // Redefine the callback to ensure it is destroyed before the GIL is released.
+                OwnedPyObject callback = std::move(callback_);
+
+                if (!result.has_value()) {
+                    completeCallbackWithCoreError(state, callback, result.error());
+                    return;
+                }
+
+                std::vector<scaler::ymq::Message>& messages = result.value();
+
+                OwnedPyObject pyMessages = PyList_New(static_cast<Py_ssize_t>(messages.size()));
+                if (!pyMessages) {
+                    completeCallbackWithRaisedException(callback);
+                    return;
+                }
+
+                for (size_t i = 0; i < messages.size(); ++i) {
+                    OwnedPyObject pyMessage = PyMessage_fromMessage(state, std::move(messages[i]));
+                    if (!pyMessage) {
+                        completeCallbackWithRaisedException(callback);
+                        return;
+                    }
+
+                    // Steals the reference
+                    PyList_SET_ITEM(pyMessages.get(), static_cast<Py_ssize_t>(i), pyMessage.take());
+                }
+
+                completeCallback(callback, pyMessages);
+            });
+    } catch (...) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to receive messages");
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject* PyBinderSocket_close_connection(PyBinderSocket* self, PyObject* args, PyObject* kwargs)
 {
     const char* remoteIdentity   = nullptr;
@@ -330,8 +396,30 @@ static PyObject* PyBinderSocket_identity_getter(PyBinderSocket* self, void* Py_U
     return PyUnicode_FromStringAndSize(identity.data(), identity.size());
 }
 
+static PyObject* PyBinderSocket_numThreads_getter(PyBinderSocket* self, void* Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(self->socket->numThreads());
+}
+
+static PyObject* PyBinderSocket_sendQueueDepth_getter(PyBinderSocket* self, void* Py_UNUSED(closure))
+{
+    const SendQueueDepth depth = self->socket->sendQueueDepth();
+
+    OwnedPyObject messages = PyLong_FromSize_t(depth.messages);
+    if (!messages)
+        return nullptr;
+
+    OwnedPyObject bytes = PyLong_FromSize_t(depth.bytes);
+    if (!bytes)
+        return nullptr;
+
+    return PyTuple_Pack(2, messages.get(), bytes.get());
+}
+
 static PyGetSetDef PyBinderSocket_properties[] = {
     {"identity", (getter)PyBinderSocket_identity_getter, nullptr, nullptr, nullptr},
+    {"num_threads", (getter)PyBinderSocket_numThreads_getter, nullptr, nullptr, nullptr},
+    {"send_queue_depth", (getter)PyBinderSocket_sendQueueDepth_getter, nullptr, nullptr, nullptr},
     {nullptr, nullptr, nullptr, nullptr, nullptr},
 };
 
@@ -343,6 +431,7 @@ static PyMethodDef PyBinderSocket_methods[] = {
      METH_VARARGS | METH_KEYWORDS,
      nullptr},
     {"recv_message", (PyCFunction)(void*)PyBinderSocket_recv_message, METH_VARARGS | METH_KEYWORDS, nullptr},
+    {"recv_messages", (PyCFunction)(void*)PyBinderSocket_recv_messages, METH_VARARGS | METH_KEYWORDS, nullptr},
     {"close_connection", (PyCFunction)(void*)PyBinderSocket_close_connection, METH_VARARGS | METH_KEYWORDS, nullptr},
     {"shutdown", (PyCFunction)(void*)PyBinderSocket_shutdown, METH_VARARGS | METH_KEYWORDS, nullptr},
     {nullptr, nullptr, 0, nullptr},
@@ -6,6 +6,7 @@
 // C++
 #include <future>
 #include <memory>
+#include <vector>
 
 // First-party
 #include "scaler/error/error.h"
@@ -64,21 +65,31 @@ static PyObject* PyConnectorSocket_connect(PyObject* cls, PyObject* args, PyObje
     if (!state)
         return nullptr;
 
-    PyObject* onConnectCallback  = nullptr;
-    PyIOContext* pyIOContext     = nullptr;
-    const char* identity         = nullptr;
-    Py_ssize_t identityLen       = 0;
-    const char* address          = nullptr;
-    Py_ssize_t addressLen        = 0;
-    unsigned long maxRetryTimes  = defaultClientMaxRetryTimes;
-    unsigned long initRetryDelay = defaultClientInitRetryDelay.count();
-    const char* kwlist[]         = {
-        "callback", "context", "identity", "address", "max_retry_times", "init_retry_delay", nullptr};
+    PyObject* onConnectCallback     = nullptr;
+    PyIOContext* pyIOContext        = nullptr;
+    const char* identity            = nullptr;
+    Py_ssize_t identityLen          = 0;
+    const char* address             = nullptr;
+    Py_ssize_t addressLen           = 0;
+    unsigned long maxRetryTimes     = defaultClientMaxRetryTimes;
+    unsigned long initRetryDelay    = defaultClientInitRetryDelay.count();
+    unsigned long maxQueuedMessages = 0;
+    unsigned long maxQueuedBytes    = 0;
+    const char* kwlist[]            = {
+        "callback",
+        "context",
+        "identity",
+        "address",
+        "max_retry_times",
+        "init_retry_delay",
+        "max_queued_messages",
+        "max_queued_bytes",
+        nullptr};
 
     if (!PyArg_ParseTupleAndKeywords(
             args,
             kwds,
-            "OO!s#s#|kk",
+            "OO!s#s#|kkkk",
             (char**)kwlist,
             &onConnectCallback,
             (PyTypeObject*)state->PyIOContextType.get(),
@@ -88,7 +99,9 @@ static PyObject* PyConnectorSocket_connect(PyObject* cls, PyObject* args, PyObje
             &address,
             &addressLen,
             &maxRetryTimes,
-            &initRetryDelay))
+            &initRetryDelay,
+            &maxQueuedMessages,
+            &maxQueuedBytes))
         return nullptr;
 
     OwnedPyObject<PyConnectorSocket> self = PyConnectorSocket_new(state);
@@ -119,7 +132,8 @@ static PyObject* PyConnectorSocket_connect(PyObject* cls, PyObject* args, PyObje
             },
             std::nullopt,
             maxRetryTimes,
-            std::chrono::milliseconds(initRetryDelay)));
+            std::chrono::milliseconds(initRetryDelay),
+            SendQueueLimits {.maxMessages = maxQueuedMessages, .maxBytes = maxQueuedBytes}));
     } catch (...) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to create ConnectorSocket");
         return nullptr;
@@ -134,18 +148,21 @@ static PyObject* PyConnectorSocket_bind(PyObject* cls, PyObject* args, PyObject*
     if (!state)
         return nullptr;
 
-    PyObject* onBindCallback = nullptr;
-    PyIOContext* pyIOContext = nullptr;
-    const char* identity     = nullptr;
-    Py_ssize_t identityLen   = 0;
-    const char* address      = nullptr;
-    Py_ssize_t addressLen    = 0;
-    const char* kwlist[]     = {"callback", "context", "identity", "address", nullptr};
+    PyObject* onBindCallback        = nullptr;
+    PyIOContext* pyIOContext        = nullptr;
+    const char* identity            = nullptr;
+    Py_ssize_t identityLen          = 0;
+    const char* address             = nullptr;
+    Py_ssize_t addressLen           = 0;
+    unsigned long maxQueuedMessages = 0;
+    unsigned long maxQueuedBytes    = 0;
+    const char* kwlist[] = {
+        "callback", "context", "identity", "address", "max_queued_messages", "max_queued_bytes", nullptr};
 
     if (!PyArg_ParseTupleAndKeywords(
             args,
             kwds,
-            "OO!s#s#",
+            "OO!s#s#|kk",
             (char**)kwlist,
             &onBindCallback,
             (PyTypeObject*)state->PyIOContextType.get(),
@@ -153,7 +170,9 @@ static PyObject* PyConnectorSocket_bind(PyObject* cls, PyObject* args, PyObject*
             &identity,
             &identityLen,
             &address,
-            &addressLen))
+            &addressLen,
+            &maxQueuedMessages,
+            &maxQueuedBytes))
         return nullptr;
 
     OwnedPyObject<PyConnectorSocket> self = PyConnectorSocket_new(state);
@@ -187,7 +206,9 @@ static PyObject* PyConnectorSocket_bind(PyObject* cls, PyObject* args, PyObject*
                 }
 
                 completeCallback(callback, pyAddress);
-            }));
+            },
+            std::nullopt,
+            SendQueueLimits {.maxMessages = maxQueuedMessages, .maxBytes = maxQueuedBytes}));
     } catch (...) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to create ConnectorSocket");
         return nullptr;
@@ -243,10 +264,22 @@ static PyObject* PyConnectorSocket_send_message(PyConnectorSocket* self, PyObjec
 
     PyObject* callback      = nullptr;
     PyBytes* messagePayload = nullptr;
-    const char* kwlist[]    = {"on_message_send", "message_payload", nullptr};
+    int priorityValue       = (int)scaler::ymq::MessagePriority::Normal;
+    const char* kwlist[]    = {"on_message_send", "message_payload", "priority", nullptr};
 
     if (!PyArg_ParseTupleAndKeywords(
-            args, kwargs, "OO!", (char**)kwlist, &callback, (PyTypeObject*)state->PyBytesType.get(), &messagePayload))
+            args,
+            kwargs,
+            "OO!|i",
+            (char**)kwlist,
+            &callback,
+            (PyTypeObject*)state->PyBytesType.get(),
+            &messagePayload,
+            &priorityValue))
+        return nullptr;
+
+    scaler::ymq::MessagePriority priority {};
+    if (!PyMessagePriority_fromInt(priorityValue, &priority))
         return nullptr;
 
     try {
@@ -266,7 +299,8 @@ static PyObject* PyConnectorSocket_send_message(PyConnectorSocket* self, PyObjec
                 }
 
                 completeCallback(callback, OwnedPyObject<>::none());
-            });
+            },
+            priority);
     } catch (...) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to send message");
         return nullptr;
@@ -300,26 +334,7 @@ static PyObject* PyConnectorSocket_recv_message(PyConnectorSocket* self, PyObjec
                 return;
             }
 
-            scaler::ymq::Message& message = result.value();
-
-            OwnedPyObject<PyBytes> address = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
-            if (!address) {
-                completeCallbackWithRaisedException(callback);
-                return;
-            }
-
-            address->bytes = std::move(message.address);
-
-            OwnedPyObject<PyBytes> payload = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
-            if (!payload) {
-                completeCallbackWithRaisedException(callback);
-                return;
-            }
-
-            payload->bytes = std::move(message.payload);
-
-            OwnedPyObject pyMessage =
-                PyObject_CallFunction(state->PyMessageType.get(), "OO", address.get(), payload.get());
+            OwnedPyObject pyMessage = PyMessage_fromMessage(state, std::move(result.value()));
             if (!pyMessage) {
                 completeCallbackWithRaisedException(callback);
                 return;
@@ -335,6 +350,69 @@ static PyObject* PyConnectorSocket_recv_message(PyConnectorSocket* self, PyObjec
     Py_RETURN_NONE;
 }
 
+static PyObject* PyConnectorSocket_recv_messages(PyConnectorSocket* self, PyObject* args, PyObject* kwargs)
+{
+    auto state = YMQStateFromSelf((PyObject*)self);
+    if (!state)
+        return nullptr;
+
+    PyObject* callback   = nullptr;
+    Py_ssize_t maxCount  = 0;
+    const char* kwlist[] = {"callback", "max_count", nullptr};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "On", (char**)kwlist, &callback, &maxCount))
+        return nullptr;
+
+    if (maxCount < 1) {
+        PyErr_SetString(PyExc_ValueError, "max_count must be at least 1");
+        return nullptr;
+    }
+
+    try {
+        self->socket->recvMessages(
+            static_cast<size_t>(maxCount),
+            [callback_ = OwnedPyObject<>::fromBorrowed(callback),
+             state](std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error> result) {
+                // The whole batch is converted under a single GIL acquisition.
+                AcquireGIL _;
+
+                // Redefine the callback to ensure it is destroyed before the GIL is released.
+                OwnedPyObject callback = std::move(callback_);
+
+                if (!result.has_value()) {
+                    completeCallbackWithCoreError(state, callback, result.error());
+                    return;
+                }
+
+                std::vector<scaler::ymq::Message>& messages = result.value();
+
+                OwnedPyObject pyMessages = PyList_New(static_cast<Py_ssize_t>(messages.size()));
+                if (!pyMessages) {
+                    completeCallbackWithRaisedException(callback);
+                    return;
+                }
+
+                for (size_t i = 0; i < messages.size(); ++i) {
+                    OwnedPyObject pyMessage = PyMessage_fromMessage(state, std::move(messages[i]));
+                    if (!pyMessage) {
+                        completeCallbackWithRaisedException(callback);
+                        return;
+                    }
+
+                    // Steals the reference
+                    PyList_SET_ITEM(pyMessages.get(), static_cast<Py_ssize_t>(i), pyMessage.take());
+                }
+
+                completeCallback(callback, pyMessages);
+            });
+    } catch (...) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to receive messages");
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject* PyConnectorSocket_repr(PyConnectorSocket* self)
 {
     return PyUnicode_FromFormat("<ConnectorSocket at %p>", (void*)self->socket.get());
@@ -346,8 +424,24 @@ static PyObject* PyConnectorSocket_identity_getter(PyConnectorSocket* self, void
     return PyUnicode_FromStringAndSize(identity.data(), identity.size());
 }
 
+static PyObject* PyConnectorSocket_sendQueueDepth_getter(PyConnectorSocket* self, void* Py_UNUSED(closure))
+{
+    const SendQueueDepth depth = self->socket->sendQueueDepth();
+
+    OwnedPyObject messages = PyLong_FromSize_t(depth.messages);
+    if (!messages)
+        return nullptr;
+
+    OwnedPyObject bytes = PyLong_FromSize_t(depth.bytes);
+    if (!bytes)
+        return nullptr;
+
+    return PyTuple_Pack(2, messages.get(), bytes.get());
+}
+
 static PyGetSetDef PyConnectorSocket_properties[] = {
     {"identity", (getter)PyConnectorSocket_identity_getter, nullptr, nullptr, nullptr},
+    {"send_queue_depth", (getter)PyConnectorSocket_sendQueueDepth_getter, nullptr, nullptr, nullptr},
     {nullptr, nullptr, nullptr, nullptr, nullptr},
 };
 
@@ -357,6 +451,7 @@ static PyMethodDef PyConnectorSocket_methods[] = {
     {"shutdown", (PyCFunction)(void*)PyConnectorSocket_shutdown, METH_VARARGS | METH_KEYWORDS, nullptr},
     {"send_message", (PyCFunction)(void*)PyConnectorSocket_send_message, METH_VARARGS | METH_KEYWORDS, nullptr},
     {"recv_message", (PyCFunction)(void*)PyConnectorSocket_recv_message, METH_VARARGS | METH_KEYWORDS, nullptr},
+    {"recv_messages", (PyCFunction)(void*)PyConnectorSocket_recv_messages, METH_VARARGS | METH_KEYWORDS, nullptr},
     {nullptr, nullptr, 0, nullptr},
 };
 
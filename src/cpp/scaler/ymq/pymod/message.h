@@ -3,7 +3,12 @@
 // Python
 #include "scaler/utility/pymod/compatibility.h"
 
+// C++
+#include <utility>
+
 // First-party
+#include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
 #include "scaler/ymq/pymod/bytes.h"
 #include "scaler/ymq/pymod/ymq.h"
 
@@ -19,6 +24,28 @@ struct PyMessage {
     OwnedPyObject<PyBytes> payload;  // Payload of the message
 };
 
+int PyMessagePriority_createEnum(PyObject* pyModule, YMQState* state)
+{
+    return YMQ_createIntEnum(
+        pyModule,
+        &state->PyMessagePriorityType,
+        "MessagePriority",
+        {
+            {"Normal", (int)scaler::ymq::MessagePriority::Normal},
+            {"High", (int)scaler::ymq::MessagePriority::High},
+        });
+}
+
+// Converts a MessagePriority enum value. Returns false with a raised exception on failure.
+static bool PyMessagePriority_fromInt(int value, scaler::ymq::MessagePriority* priority)
+{
+    switch (value) {
+        case (int)scaler::ymq::MessagePriority::Normal: *priority = scaler::ymq::MessagePriority::Normal; return true;
+        case (int)scaler::ymq::MessagePriority::High: *priority = scaler::ymq::MessagePriority::High; return true;
+        default: PyErr_Format(PyExc_ValueError, "invalid message priority: %d", value); return false;
+    }
+}
+
 static int PyMessage_init(PyMessage* self, PyObject* args, PyObject* kwds)
 {
     auto state = YMQStateFromSelf((PyObject*)self);
@@ -79,6 +106,24 @@ static PyObject* PyMessage_repr(PyMessage* self)
     return PyUnicode_FromFormat("<Message address=%R payload=%R>", self->address.get(), self->payload.get());
 }
 
+// Create a Python Message from a received message. Returns nullptr with a raised exception on failure.
+static OwnedPyObject<> PyMessage_fromMessage(YMQState* state, scaler::ymq::Message message)
+{
+    OwnedPyObject<PyBytes> address = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
+    if (!address)
+        return nullptr;
+
+    address->bytes = std::move(message.address);
+
+    OwnedPyObject<PyBytes> payload = (PyBytes*)PyObject_CallNoArgs(state->PyBytesType.get());
+    if (!payload)
+        return nullptr;
+
+    payload->bytes = std::move(message.payload);
+
+    return PyObject_CallFunction(state->PyMessageType.get(), "OO", address.get(), payload.get());
+}
+
 static PyMemberDef PyMessage_members[] = {
     {"address", T_OBJECT, offsetof(PyMessage, address), 0, PyDoc_STR("the address of the message")},
     {"payload", T_OBJECT, offsetof(PyMessage, payload), 0, PyDoc_STR("the payload of the message")},
@@ -115,6 +115,7 @@ int YMQ_createErrorCodeEnum(PyObject* pyModule, YMQState* state)
         {"ConnectorSocketClosedByRemoteEnd", (int)ErrorCode::ConnectorSocketClosedByRemoteEnd},
         {"SocketStopRequested", (int)ErrorCode::SocketStopRequested},
         {"SysCallError", (int)ErrorCode::SysCallError},
+        {"SendQueueFull", (int)ErrorCode::SendQueueFull},
     };
 
     if (YMQ_createIntEnum(pyModule, &state->PyErrorCodeType, "ErrorCode", errorCodeValues) < 0)
@@ -159,6 +160,7 @@ int YMQ_createExceptions(PyObject* pyModule, YMQState* state)
         {ErrorCode::ConnectorSocketClosedByRemoteEnd, "ConnectorSocketClosedByRemoteEndError"},
         {ErrorCode::SocketStopRequested, "SocketStopRequestedError"},
         {ErrorCode::SysCallError, "SysCallError"},
+        {ErrorCode::SendQueueFull, "SendQueueFullError"},
     };
 
     static PyType_Slot slots[] = {{0, nullptr}};
@@ -230,6 +232,9 @@ static int YMQ_exec(PyObject* pyModule)
     if (YMQ_createType(pyModule, &state->PyMessageType, &PyMessage_spec, "Message") < 0)
         return -1;
 
+    if (PyMessagePriority_createEnum(pyModule, state) < 0)
+        return -1;
+
     if (YMQ_createType(pyModule, &state->PyIOContextType, &PyIOContext_spec, "IOContext") < 0)
         return -1;
 
@@ -27,6 +27,7 @@ struct YMQState {
     OwnedPyObject<> PyErrorCodeType;        // Reference to the ErrorCode enum
     OwnedPyObject<> PyBytesType;            // Reference to Bytes type
     OwnedPyObject<> PyMessageType;          // Reference to Message type
+    OwnedPyObject<> PyMessagePriorityType;  // Reference to the MessagePriority enum
     OwnedPyObject<> PyExceptionType;        // Reference to YMQException type
 
     std::unordered_map<int, OwnedPyObject<>> PyExceptionSubtypes;  // Map of error code to exception subclass
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+namespace scaler {
+namespace ymq {
+
+// What to do with a message that would make a send queue exceed its high-water mark.
+enum class SendQueueFullPolicy {
+    // Fail the new message with a SendQueueFull error, letting the producer retry later or throttle.
+    Reject,
+
+    // Fail the oldest messages queued for the same peer with a SendQueueFull error, until the new message fits.
+    //
+    // Only messages not yet handed to the network (e.g. queued while the peer is disconnected) can be dropped. If
+    // dropping these is not enough, the new message is rejected instead.
+    DropOldest,
+};
+
+// The messages queued for sending, and not yet written to the network.
+struct SendQueueDepth {
+    size_t messages {0};
+    size_t bytes {0};
+};
+
+// High-water marks of a send queue.
+struct SendQueueLimits {
+    // Zero for no limit.
+    size_t maxMessages {0};
+    size_t maxBytes {0};
+
+    SendQueueFullPolicy policy {SendQueueFullPolicy::Reject};
+
+    // Returns true if queueing a message of `messageSize` bytes would exceed the limits.
+    //
+    // An empty queue always accepts a message, so that messages larger than `maxBytes` can still be sent.
+    bool exceeded(SendQueueDepth depth, size_t messageSize) const noexcept
+    {
+        if (depth.messages == 0) {
+            return false;
+        }
+
+        return (maxMessages > 0 && depth.messages + 1 > maxMessages) ||
+               (maxBytes > 0 && depth.bytes + messageSize > maxBytes);
+    }
+};
+
+}  // namespace ymq
+}  // namespace scaler
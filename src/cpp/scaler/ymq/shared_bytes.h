@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "scaler/ymq/bytes.h"
+
+namespace scaler {
+namespace ymq {
+
+// A reference to a reference-counted, immutable buffer.
+//
+// Allows sending the same payload on several connections without copying it. The buffer is released once the last
+// SharedBytes referencing it is destroyed.
+class SharedBytes final: public Bytes {
+public:
+    explicit SharedBytes(std::shared_ptr<const Bytes> bytes) noexcept: _bytes(std::move(bytes)) {}
+
+    const uint8_t* data() const noexcept override
+    {
+        return _bytes->data();
+    }
+
+    // The buffer is shared and must not be written to.
+    uint8_t* data() noexcept override
+    {
+        return const_cast<uint8_t*>(_bytes->data());
+    }
+
+    size_t size() const noexcept override
+    {
+        return _bytes->size();
+    }
+
+    std::optional<std::string> asString() const override
+    {
+        return _bytes->asString();
+    }
+
+private:
+    std::shared_ptr<const Bytes> _bytes;
+};
+
+}  // namespace ymq
+}  // namespace scaler
@@ -6,7 +6,13 @@ namespace scaler {
 namespace ymq {
 namespace sync {
 
-BinderSocket::BinderSocket(IOContext& context, Identity identity) noexcept: _socket(context, std::move(identity))
+BinderSocket::BinderSocket(
+    IOContext& context,
+    Identity identity,
+    size_t numThreads,
+    SendQueueLimits connectionSendQueueLimits,
+    SendQueueLimits socketSendQueueLimits) noexcept
+    : _socket(context, std::move(identity), numThreads, connectionSendQueueLimits, socketSendQueueLimits)
 {
 }
 
@@ -15,15 +21,25 @@ const Identity& BinderSocket::identity() const noexcept
     return _socket.identity();
 }
 
+size_t BinderSocket::numThreads() const noexcept
+{
+    return _socket.numThreads();
+}
+
+SendQueueDepth BinderSocket::sendQueueDepth() const noexcept
+{
+    return _socket.sendQueueDepth();
+}
+
 std::expected<Address, Error> BinderSocket::bindTo(std::string address, std::optional<TLSConfig> tlsConfig) noexcept
 {
     return _socket.bindTo(std::move(address), std::move(tlsConfig)).get();
 }
 
 std::expected<void, Error> BinderSocket::sendMessage(
-    Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload) noexcept
+    Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload, MessagePriority priority) noexcept
 {
-    return _socket.sendMessage(std::move(remoteIdentity), std::move(messagePayload)).get();
+    return _socket.sendMessage(std::move(remoteIdentity), std::move(messagePayload), priority).get();
 }
 
 void BinderSocket::sendMulticastMessage(
@@ -37,6 +53,11 @@ std::expected<Message, Error> BinderSocket::recvMessage() noexcept
     return _socket.recvMessage().get();
 }
 
+std::expected<std::vector<Message>, Error> BinderSocket::recvMessages(size_t maxCount) noexcept
+{
+    return _socket.recvMessages(maxCount).get();
+}
+
 void BinderSocket::closeConnection(Identity remoteIdentity) noexcept
 {
     _socket.closeConnection(std::move(remoteIdentity));
@@ -4,12 +4,15 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "scaler/error/error.h"
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/future/binder_socket.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/typedefs.h"
 
 namespace scaler {
@@ -19,7 +22,12 @@ namespace sync {
 // Synchronous wrapper for BinderSocket that blocks until operations complete.
 class BinderSocket {
 public:
-    BinderSocket(IOContext& context, Identity identity) noexcept;
+    BinderSocket(
+        IOContext& context,
+        Identity identity,
+        size_t numThreads = 1,
+        SendQueueLimits connectionSendQueueLimits = {},
+        SendQueueLimits socketSendQueueLimits = {}) noexcept;
 
     ~BinderSocket() noexcept = default;
 
@@ -31,16 +39,25 @@ public:
 
     const Identity& identity() const noexcept;
 
+    size_t numThreads() const noexcept;
+
+    SendQueueDepth sendQueueDepth() const noexcept;
+
     std::expected<Address, Error> bindTo(
         std::string address, std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
 
-    std::expected<void, Error> sendMessage(Identity remoteIdentity, std::unique_ptr<Bytes> messagePayload) noexcept;
+    std::expected<void, Error> sendMessage(
+        Identity remoteIdentity,
+        std::unique_ptr<Bytes> messagePayload,
+        MessagePriority priority = MessagePriority::Normal) noexcept;
 
     void sendMulticastMessage(
         std::unique_ptr<Bytes> messagePayload, std::optional<Identity> remotePrefix = std::nullopt) noexcept;
 
     std::expected<Message, Error> recvMessage() noexcept;
 
+    std::expected<std::vector<Message>, Error> recvMessages(size_t maxCount) noexcept;
+
     void closeConnection(Identity remoteIdentity) noexcept;
 
 private:
@@ -12,10 +12,17 @@ std::expected<ConnectorSocket, Error> ConnectorSocket::connect(
     std::string address,
     std::optional<TLSConfig> tlsConfig,
     size_t maxRetryTimes,
-    std::chrono::milliseconds initRetryDelay) noexcept
+    std::chrono::milliseconds initRetryDelay,
+    SendQueueLimits sendQueueLimits) noexcept
 {
     auto result = future::ConnectorSocket::connect(
-        context, std::move(identity), std::move(address), std::move(tlsConfig), maxRetryTimes, initRetryDelay);
+        context,
+        std::move(identity),
+        std::move(address),
+        std::move(tlsConfig),
+        maxRetryTimes,
+        initRetryDelay,
+        sendQueueLimits);
     if (!result.has_value()) {
         return std::unexpected(result.error());
     }
@@ -23,9 +30,14 @@ std::expected<ConnectorSocket, Error> ConnectorSocket::connect(
 }
 
 std::expected<std::pair<ConnectorSocket, Address>, Error> ConnectorSocket::bind(
-    IOContext& context, Identity identity, std::string address, std::optional<TLSConfig> tlsConfig) noexcept
+    IOContext& context,
+    Identity identity,
+    std::string address,
+    std::optional<TLSConfig> tlsConfig,
+    SendQueueLimits sendQueueLimits) noexcept
 {
-    auto result = future::ConnectorSocket::bind(context, std::move(identity), std::move(address), std::move(tlsConfig));
+    auto result = future::ConnectorSocket::bind(
+        context, std::move(identity), std::move(address), std::move(tlsConfig), sendQueueLimits);
     if (!result.has_value()) {
         return std::unexpected(result.error());
     }
@@ -42,9 +54,15 @@ const Identity& ConnectorSocket::identity() const noexcept
     return _socket.identity();
 }
 
-std::expected<void, Error> ConnectorSocket::sendMessage(std::unique_ptr<Bytes> messagePayload) noexcept
+SendQueueDepth ConnectorSocket::sendQueueDepth() const noexcept
+{
+    return _socket.sendQueueDepth();
+}
+
+std::expected<void, Error> ConnectorSocket::sendMessage(
+    std::unique_ptr<Bytes> messagePayload, MessagePriority priority) noexcept
 {
-    return _socket.sendMessage(std::move(messagePayload)).get();
+    return _socket.sendMessage(std::move(messagePayload), priority).get();
 }
 
 std::expected<Message, Error> ConnectorSocket::recvMessage() noexcept
@@ -52,6 +70,11 @@ std::expected<Message, Error> ConnectorSocket::recvMessage() noexcept
     return _socket.recvMessage().get();
 }
 
+std::expected<std::vector<Message>, Error> ConnectorSocket::recvMessages(size_t maxCount) noexcept
+{
+    return _socket.recvMessages(maxCount).get();
+}
+
 }  // namespace sync
 }  // namespace ymq
 }  // namespace scaler
@@ -5,12 +5,15 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "scaler/error/error.h"
 #include "scaler/ymq/configuration.h"
 #include "scaler/ymq/future/connector_socket.h"
 #include "scaler/ymq/io_context.h"
 #include "scaler/ymq/message.h"
+#include "scaler/ymq/message_priority.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "scaler/ymq/tls_config.h"
 #include "scaler/ymq/typedefs.h"
 
@@ -27,13 +30,15 @@ public:
         std::string address,
         std::optional<TLSConfig> tlsConfig       = std::nullopt,
         size_t maxRetryTimes                     = defaultClientMaxRetryTimes,
-        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay) noexcept;
+        std::chrono::milliseconds initRetryDelay = defaultClientInitRetryDelay,
+        SendQueueLimits sendQueueLimits          = {}) noexcept;
 
     static std::expected<std::pair<ConnectorSocket, Address>, Error> bind(
         IOContext& context,
         Identity identity,
         std::string address,
-        std::optional<TLSConfig> tlsConfig = std::nullopt) noexcept;
+        std::optional<TLSConfig> tlsConfig = std::nullopt,
+        SendQueueLimits sendQueueLimits    = {}) noexcept;
 
     ~ConnectorSocket() noexcept = default;
 
@@ -45,10 +50,15 @@ public:
 
     const Identity& identity() const noexcept;
 
-    std::expected<void, Error> sendMessage(std::unique_ptr<Bytes> messagePayload) noexcept;
+    SendQueueDepth sendQueueDepth() const noexcept;
+
+    std::expected<void, Error> sendMessage(
+        std::unique_ptr<Bytes> messagePayload, MessagePriority priority = MessagePriority::Normal) noexcept;
 
     std::expected<Message, Error> recvMessage() noexcept;
 
+    std::expected<std::vector<Message>, Error> recvMessages(size_t maxCount) noexcept;
+
 private:
     ConnectorSocket(future::ConnectorSocket socket) noexcept;
 
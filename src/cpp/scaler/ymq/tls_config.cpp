@@ -5,12 +5,32 @@
 namespace scaler {
 namespace ymq {
 
-TLSConfig::TLSConfig(std::string certChain, std::string privateKey) noexcept
-    : _certChain(std::move(certChain)), _privateKey(std::move(privateKey))
+TLSConfig::TLSConfig(std::string certChain, std::string privateKey, bool kernelTLS) noexcept
+    : _certChain(std::move(certChain))
+    , _privateKey(std::move(privateKey))
+    , _kernelTLS(kernelTLS)
+    , _cachedContext(std::make_shared<CachedContext>())
 {
 }
 
 std::expected<scaler::wrapper::openssl::SSLContext, Error> TLSConfig::getSSLContext() const noexcept
+{
+    std::lock_guard<std::mutex> lock(_cachedContext->_mutex);
+
+    if (!_cachedContext->_context.has_value()) {
+        // Errors aren't cached, the next call tries again.
+        auto context = createSSLContext();
+        if (!context.has_value()) {
+            return std::unexpected {std::move(context.error())};
+        }
+
+        _cachedContext->_context = std::move(context.value());
+    }
+
+    return *_cachedContext->_context;
+}
+
+std::expected<scaler::wrapper::openssl::SSLContext, Error> TLSConfig::createSSLContext() const noexcept
 {
     auto context = scaler::wrapper::openssl::SSLContext::init();
     if (!context.has_value()) {
@@ -33,6 +53,12 @@ std::expected<scaler::wrapper::openssl::SSLContext, Error> TLSConfig::getSSLCont
         return std::unexpected {Error {Error::ErrorCode::SysCallError, "Private key does not match certificate"}};
     }
 
+    if (_kernelTLS) {
+        context->enableKernelTLS();
+    }
+
+    context->enableSessionResumption();
+
     return std::move(*context);
 }
 
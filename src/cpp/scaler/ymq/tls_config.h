@@ -1,6 +1,9 @@
 #pragma once
 
 #include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
 #include "scaler/error/error.h"
@@ -12,14 +15,29 @@ namespace ymq {
 // TLS credentials for secure connections (tls://, wss://).
 class TLSConfig {
 public:
-    TLSConfig(std::string certChain, std::string privateKey) noexcept;
+    // If kernelTLS is set, the encryption of the sent data is offloaded to the kernel when supported (see
+    // SSLContext::enableKernelTLS()).
+    TLSConfig(std::string certChain, std::string privateKey, bool kernelTLS = false) noexcept;
 
     // Create a SSLContext from the stored credentials.
+    //
+    // The context is created on the first call, and then shared by this config and its copies. This avoids re-reading
+    // the credentials on every connection, and lets reconnecting clients resume their previous TLS session.
     std::expected<scaler::wrapper::openssl::SSLContext, Error> getSSLContext() const noexcept;
 
 private:
     std::string _certChain;   // PEM certificate chain file
     std::string _privateKey;  // PEM private key file
+    bool _kernelTLS;          // offload sent data encryption to the kernel (kTLS)
+
+    struct CachedContext {
+        std::mutex _mutex {};
+        std::optional<scaler::wrapper::openssl::SSLContext> _context {};
+    };
+
+    std::shared_ptr<CachedContext> _cachedContext;
+
+    std::expected<scaler::wrapper::openssl::SSLContext, Error> createSSLContext() const noexcept;
 };
 
 }  // namespace ymq
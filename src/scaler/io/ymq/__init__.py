@@ -9,12 +9,14 @@ __all__ = [
     "ErrorCode",
     "IOContext",
     "Message",
+    "MessagePriority",
     # Exception types
     "YMQException",
     "ConnectorSocketClosedByRemoteEndError",
     "InvalidAddressFormatError",
     "InvalidPortFormatError",
     "RemoteEndDisconnectedOnSocketWithoutGuaranteedDeliveryError",
+    "SendQueueFullError",
     "SocketStopRequestedError",
     "SysCallError",
 ]
@@ -36,7 +38,9 @@ if sys.platform == "emscripten":
         InvalidPortFormatError,
         IOContext,
         Message,
+        MessagePriority,
         RemoteEndDisconnectedOnSocketWithoutGuaranteedDeliveryError,
+        SendQueueFullError,
         SocketStopRequestedError,
         SysCallError,
         YMQException,
@@ -52,7 +56,9 @@ else:
         InvalidPortFormatError,
         IOContext,
         Message,
+        MessagePriority,
         RemoteEndDisconnectedOnSocketWithoutGuaranteedDeliveryError,
+        SendQueueFullError,
         SocketStopRequestedError,
         SysCallError,
         YMQException,
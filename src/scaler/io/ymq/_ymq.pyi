@@ -2,7 +2,7 @@
 # This file contains type stubs for the YMQ Python C Extension module
 
 from enum import IntEnum
-from typing import Callable, Optional, SupportsBytes, Union
+from typing import Callable, List, Optional, SupportsBytes, Tuple, Union
 
 try:
     from collections.abc import Buffer  # type: ignore[attr-defined]
@@ -36,24 +36,38 @@ class Message:
     ) -> None: ...
     def __repr__(self) -> str: ...
 
+class MessagePriority(IntEnum):
+    """Sending priority of a message, relative to the other messages sent to the same peer.
+
+    High priority messages are sent before the queued normal priority messages, in between the fragments of large
+    ones.
+    """
+
+    Normal = 0
+    High = 1
+
 class AddressType(IntEnum):
     """Address type enum"""
 
     IPC = 0
     TCP = 1
+    WebSocket = 2
+    SharedMemory = 3
 
 class Address:
     """
-    A socket address, can either be a TCP address (IPv4/6) or an IPC path.
+    A socket address, can either be a TCP address (IPv4/6), an IPC path, a WebSocket address or a shared memory address.
 
     Example address strings:
         - ipc://some_ipc_socket_name
         - tcp://127.0.0.1:1827
         - tcp://[2001:db8::1]:1211
+        - ws://127.0.0.1:8765/
+        - shm:///tmp/some_ipc_socket_name
     """
 
     type: AddressType
-    """Get the address type (IPC or TCP)"""
+    """Get the address type"""
 
     def __init__(self, address: str) -> None:
         """Create an Address from a string."""
@@ -77,15 +91,36 @@ class BinderSocket:
     identity: str
     """Get the identity of the socket"""
 
-    def __init__(self, context: IOContext, identity: str) -> None:
-        """Create a BinderSocket with the specified identity."""
+    num_threads: int
+    """Get the number of IOContext threads the socket's connections are distributed across"""
+
+    send_queue_depth: Tuple[int, int]
+    """Get the messages queued for sending and not yet written to the network, as (messages, bytes)"""
+
+    def __init__(
+        self,
+        context: IOContext,
+        identity: str,
+        num_threads: int = 1,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
+    ) -> None:
+        """Create a BinderSocket with the specified identity, spreading its connections across num_threads threads.
+
+        Sends exceeding `max_queued_messages` or `max_queued_bytes` queued for the same peer fail with
+        SendQueueFullError. Zero means unlimited.
+        """
 
     def __repr__(self) -> str: ...
     def bind_to(self, callback: Callable[[Union[Address, Exception]], None], address: str) -> None:
         """Bind the socket to an address and listen for incoming connections."""
 
     def send_message(
-        self, on_message_send: Callable[[Optional[Exception]], None], remote_identity: str, message_payload: Bytes
+        self,
+        on_message_send: Callable[[Optional[Exception]], None],
+        remote_identity: str,
+        message_payload: Bytes,
+        priority: MessagePriority = MessagePriority.Normal,
     ) -> None:
         """Send a message to a remote peer."""
 
@@ -95,6 +130,9 @@ class BinderSocket:
     def recv_message(self, callback: Callable[[Union[Message, Exception]], None]) -> None:
         """Receive a message from a remote peer."""
 
+    def recv_messages(self, callback: Callable[[Union[List[Message], Exception]], None], max_count: int) -> None:
+        """Receive up to `max_count` messages from remote peers, in a single callback."""
+
     def close_connection(self, remote_identity: str) -> None:
         """Close the connection to a specific remote peer."""
 
@@ -113,6 +151,9 @@ class ConnectorSocket:
     identity: str
     """Get the identity of the socket"""
 
+    send_queue_depth: Tuple[int, int]
+    """Get the messages queued for sending and not yet written to the network, as (messages, bytes)"""
+
     @classmethod
     def connect(
         cls,
@@ -122,22 +163,41 @@ class ConnectorSocket:
         address: str,
         max_retry_times: int = DEFAULT_MAX_RETRY_TIMES,
         init_retry_delay: int = DEFAULT_INIT_RETRY_DELAY,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
     ) -> "ConnectorSocket":
-        """Create a ConnectorSocket and initiate connection to the remote address."""
+        """Create a ConnectorSocket and initiate connection to the remote address.
+
+        Sends exceeding `max_queued_messages` or `max_queued_bytes` fail with SendQueueFullError. Zero means unlimited.
+        """
 
     @classmethod
     def bind(
-        cls, callback: Callable[[Union[Address, Exception]], None], context: IOContext, identity: str, address: str
+        cls,
+        callback: Callable[[Union[Address, Exception]], None],
+        context: IOContext,
+        identity: str,
+        address: str,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
     ) -> "ConnectorSocket":
         """Create a ConnectorSocket that binds to an address and waits for incoming connections."""
 
     def __repr__(self) -> str: ...
-    def send_message(self, callback: Callable[[Optional[Exception]], None], message_payload: Bytes) -> None:
+    def send_message(
+        self,
+        callback: Callable[[Optional[Exception]], None],
+        message_payload: Bytes,
+        priority: MessagePriority = MessagePriority.Normal,
+    ) -> None:
         """Send a message to the connected remote peer."""
 
     def recv_message(self, callback: Callable[[Union[Message, Exception]], None]) -> None:
         """Receive a message from the connected remote peer."""
 
+    def recv_messages(self, callback: Callable[[Union[List[Message], Exception]], None], max_count: int) -> None:
+        """Receive up to `max_count` messages from the connected remote peer, in a single callback."""
+
     def shutdown(self) -> None:
         """Shut down the socket and fail pending callbacks."""
 
@@ -149,6 +209,7 @@ class ErrorCode(IntEnum):
     ConnectorSocketClosedByRemoteEnd = 4
     SocketStopRequested = 5
     SysCallError = 6
+    SendQueueFull = 7
 
     def explanation(self) -> str: ...
 
@@ -169,3 +230,4 @@ class RemoteEndDisconnectedOnSocketWithoutGuaranteedDeliveryError(YMQException):
 class ConnectorSocketClosedByRemoteEndError(YMQException): ...
 class SocketStopRequestedError(YMQException): ...
 class SysCallError(YMQException): ...
+class SendQueueFullError(YMQException): ...
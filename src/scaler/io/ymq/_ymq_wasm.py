@@ -10,10 +10,14 @@ browser (via ``js.WebSocket``). The wire protocol is byte-for-byte compatible
 with the native C++ implementation:
 
     1. After the WebSocket Upgrade handshake (handled by the browser), each
-       endpoint sends a 4-byte magic string ``YMQ\\x01``.
+       endpoint sends a 4-byte magic string ``YMQ\\x02``.
     2. Each endpoint then sends its identity as a length-prefixed message
        (8-byte little-endian length followed by the identity bytes).
     3. Subsequent application messages use the same length-prefixed framing.
+       The 2 most significant bits of the length are the frame type: large
+       messages from native peers arrive as a start frame followed by
+       fragments, possibly interleaved with whole messages. This shim only
+       sends whole messages.
 
 Only ``ConnectorSocket.connect`` is implemented; ``BinderSocket`` and
 ``ConnectorSocket.bind`` are not supported in the browser (the browser cannot
@@ -27,7 +31,7 @@ import struct
 import sys
 from collections import deque
 from enum import IntEnum
-from typing import Any, Callable, Deque, List, Optional, Union
+from typing import Any, Callable, Deque, List, Optional, Tuple, Union
 
 logger = logging.getLogger(__name__)
 
@@ -36,9 +40,14 @@ DEFAULT_MAX_RETRY_TIMES: int = 8
 DEFAULT_INIT_RETRY_DELAY: int = 100  # milliseconds
 
 # YMQ wire-protocol constants (mirror src/cpp/scaler/ymq/configuration.h).
-_MAGIC_STRING: bytes = b"YMQ\x01"
+_MAGIC_STRING: bytes = b"YMQ\x03"
 _HEADER_FORMAT: str = "<Q"  # uint64_t little-endian, matches C++ ``Header``
 _HEADER_SIZE: int = struct.calcsize(_HEADER_FORMAT)
+_HEADER_TYPE_SHIFT: int = 62
+_HEADER_SIZE_MASK: int = (1 << _HEADER_TYPE_SHIFT) - 1
+_HEADER_MESSAGE: int = 0b00
+_HEADER_FRAGMENTED_MESSAGE: int = 0b10
+_HEADER_FRAGMENT: int = 0b11
 
 
 # ---------------------------------------------------------------------------
@@ -53,6 +62,7 @@ class ErrorCode(IntEnum):
     ConnectorSocketClosedByRemoteEnd = 4
     SocketStopRequested = 5
     SysCallError = 6
+    SendQueueFull = 7
 
     def explanation(self) -> str:
         return {
@@ -65,6 +75,7 @@ class ErrorCode(IntEnum):
             ErrorCode.ConnectorSocketClosedByRemoteEnd: "Connector socket closed by remote end",
             ErrorCode.SocketStopRequested: "Socket stop requested",
             ErrorCode.SysCallError: "System call error",
+            ErrorCode.SendQueueFull: "Send queue full",
         }[self]
 
 
@@ -105,6 +116,10 @@ class SysCallError(YMQException):
     pass
 
 
+class SendQueueFullError(YMQException):
+    pass
+
+
 _ERROR_CODE_TO_CLASS = {
     ErrorCode.InvalidPortFormat: InvalidPortFormatError,
     ErrorCode.InvalidAddressFormat: InvalidAddressFormatError,
@@ -114,6 +129,7 @@ _ERROR_CODE_TO_CLASS = {
     ErrorCode.ConnectorSocketClosedByRemoteEnd: ConnectorSocketClosedByRemoteEndError,
     ErrorCode.SocketStopRequested: SocketStopRequestedError,
     ErrorCode.SysCallError: SysCallError,
+    ErrorCode.SendQueueFull: SendQueueFullError,
 }
 
 
@@ -218,15 +234,22 @@ class Message:
         return f"Message(address={self.address!r}, payload={self.payload!r})"
 
 
+class MessagePriority(IntEnum):
+    """Message priority enum. Mirrors the values exposed by the native pymod."""
+
+    Normal = 0
+    High = 1
+
+
 class AddressType(IntEnum):
     """Address type enum. Mirrors the values exposed by the native pymod."""
 
     IPC = 0
     TCP = 1
-    # WebSocket is not exposed by the native pymod today but we expose it here
-    # since browser clients only ever use ws:// addresses. Downstream code does
-    # not currently inspect ``Address.type``.
+    # Browser clients only ever use ws:// addresses. Downstream code does not
+    # currently inspect ``Address.type``.
     WebSocket = 2
+    SharedMemory = 3
 
 
 class Address:
@@ -306,6 +329,9 @@ class ConnectorSocket:
 
         # Reassembly of the raw byte stream coming out of the WebSocket.
         self._recv_buffer: bytearray = bytearray()
+        # Reassembly of the fragmented message being received, with its total size.
+        self._recv_fragmented: Optional[bytearray] = None
+        self._recv_fragmented_size: int = 0
         # Decoded application messages waiting to be delivered.
         self._recv_queue: Deque[Message] = deque()
         # Callbacks waiting for a message to arrive.
@@ -333,6 +359,8 @@ class ConnectorSocket:
         address: str,
         max_retry_times: int = DEFAULT_MAX_RETRY_TIMES,
         init_retry_delay: int = DEFAULT_INIT_RETRY_DELAY,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
     ) -> "ConnectorSocket":
         """Create a ConnectorSocket and initiate connection to the remote address.
 
@@ -343,11 +371,12 @@ class ConnectorSocket:
         WebSocket transitions to OPEN. Connection failures surface through
         the next pending recv/send callback.
 
-        ``max_retry_times`` and ``init_retry_delay`` are accepted for API
-        compatibility but ignored: browser WebSockets do not expose the retry
-        semantics native ymq uses.
+        ``max_retry_times``, ``init_retry_delay``, ``max_queued_messages`` and
+        ``max_queued_bytes`` are accepted for API compatibility but ignored:
+        browser WebSockets do not expose the retry semantics native ymq uses,
+        and buffer their sends themselves.
         """
-        del context, max_retry_times, init_retry_delay  # unused
+        del context, max_retry_times, init_retry_delay, max_queued_messages, max_queued_bytes  # unused
 
         ws_url = _normalize_ws_address(address)
 
@@ -355,6 +384,12 @@ class ConnectorSocket:
         socket._open_websocket(ws_url)
         return socket
 
+    @property
+    def send_queue_depth(self) -> Tuple[int, int]:
+        """The messages queued before the WebSocket opened, as (messages, bytes)."""
+        header_size = struct.calcsize(_HEADER_FORMAT)
+        return len(self._pending_sends), sum(len(framed) - header_size for framed, _ in self._pending_sends)
+
     @classmethod
     def bind(cls, *args: Any, **kwargs: Any) -> "ConnectorSocket":
         raise NotImplementedError(
@@ -365,7 +400,12 @@ class ConnectorSocket:
     # Low-level callback API. Mirrors the native ``_ymq.ConnectorSocket``
     # callback contract; the async / sync wrappers below adapt it to the
     # surface that ``scaler.io.ymq.sockets`` exposes for the C extension.
-    def send_message_with_callback(self, callback: SendCallback, message_payload: Bytes) -> None:
+    def send_message_with_callback(
+        self, callback: SendCallback, message_payload: Bytes, priority: MessagePriority = MessagePriority.Normal
+    ) -> None:
+        # The browser sends each message as soon as the WebSocket is open: there is no queue to prioritize.
+        del priority  # unused
+
         if self._closed:
             self._invoke(
                 callback,
@@ -397,7 +437,7 @@ class ConnectorSocket:
 
         self._recv_callbacks.append(callback)
 
-    async def send_message(self, message_payload: Bytes) -> None:
+    async def send_message(self, message_payload: Bytes, priority: MessagePriority = MessagePriority.Normal) -> None:
         """Async wrapper around ``send_message_with_callback``.
 
         Matches the high-level surface that ``scaler.io.ymq.sockets.ConnectorSocket``
@@ -417,7 +457,7 @@ class ConnectorSocket:
             else:
                 future.set_result(None)
 
-        self.send_message_with_callback(_cb, message_payload)
+        self.send_message_with_callback(_cb, message_payload, priority)
         await future
 
     async def recv_message(self) -> Message:
@@ -438,7 +478,13 @@ class ConnectorSocket:
         self.recv_message_with_callback(_cb)
         return await future
 
-    def send_message_sync(self, message_payload: Bytes, /, timeout: Optional[float] = None) -> None:
+    def send_message_sync(
+        self,
+        message_payload: Bytes,
+        priority: MessagePriority = MessagePriority.Normal,
+        /,
+        timeout: Optional[float] = None,
+    ) -> None:
         """Block via JSPI until the message is sent.
 
         Mirrors the native ``_ymq.ConnectorSocket.send_message_sync``. On
@@ -446,7 +492,7 @@ class ConnectorSocket:
         while the asyncio loop continues to drive the WebSocket events that
         complete the underlying callback.
         """
-        _drive_callback_sync(lambda cb: self.send_message_with_callback(cb, message_payload), timeout)
+        _drive_callback_sync(lambda cb: self.send_message_with_callback(cb, message_payload, priority), timeout)
 
     def recv_message_sync(self, /, timeout: Optional[float] = None) -> Message:
         """Block via JSPI until a message is available; mirror of native API."""
@@ -618,11 +664,46 @@ class ConnectorSocket:
         while True:
             if len(self._recv_buffer) < _HEADER_SIZE:
                 return
-            (length,) = struct.unpack_from(_HEADER_FORMAT, self._recv_buffer, 0)
-            if len(self._recv_buffer) < _HEADER_SIZE + length:
+            (header,) = struct.unpack_from(_HEADER_FORMAT, self._recv_buffer, 0)
+            frame_type = header >> _HEADER_TYPE_SHIFT
+            length = header & _HEADER_SIZE_MASK
+
+            if frame_type == _HEADER_FRAGMENTED_MESSAGE:
+                if self._recv_fragmented is not None:
+                    self._fail(
+                        _make_exception(ErrorCode.InvalidAddressFormat, "Unexpected fragmented message from remote")
+                    )
+                    return
+                del self._recv_buffer[:_HEADER_SIZE]
+                self._recv_fragmented = bytearray()
+                self._recv_fragmented_size = length
+                if length > 0:
+                    continue
+                payload = bytes(self._recv_fragmented)
+                self._recv_fragmented = None
+            elif frame_type == _HEADER_FRAGMENT:
+                if self._recv_fragmented is None or len(self._recv_fragmented) + length > self._recv_fragmented_size:
+                    self._fail(
+                        _make_exception(ErrorCode.InvalidAddressFormat, "Unexpected message fragment from remote")
+                    )
+                    return
+                if len(self._recv_buffer) < _HEADER_SIZE + length:
+                    return
+                self._recv_fragmented += self._recv_buffer[_HEADER_SIZE : _HEADER_SIZE + length]
+                del self._recv_buffer[: _HEADER_SIZE + length]
+                if len(self._recv_fragmented) < self._recv_fragmented_size:
+                    continue
+                payload = bytes(self._recv_fragmented)
+                self._recv_fragmented = None
+            elif frame_type == _HEADER_MESSAGE:
+                if len(self._recv_buffer) < _HEADER_SIZE + length:
+                    return
+                payload = bytes(self._recv_buffer[_HEADER_SIZE : _HEADER_SIZE + length])
+                del self._recv_buffer[: _HEADER_SIZE + length]
+            else:
+                message = f"Invalid YMQ frame header from remote: {header:#x}"
+                self._fail(_make_exception(ErrorCode.InvalidAddressFormat, message))
                 return
-            payload = bytes(self._recv_buffer[_HEADER_SIZE : _HEADER_SIZE + length])
-            del self._recv_buffer[: _HEADER_SIZE + length]
 
             if not self._handshake_complete:
                 # First framed message after the magic is the remote identity.
@@ -692,6 +773,7 @@ __all__ = [
     "RemoteEndDisconnectedOnSocketWithoutGuaranteedDeliveryError",
     "SocketStopRequestedError",
     "SysCallError",
+    "SendQueueFullError",
     "DEFAULT_MAX_RETRY_TIMES",
     "DEFAULT_INIT_RETRY_DELAY",
 ]
@@ -1,4 +1,4 @@
-from typing import Optional
+from typing import List, Optional, Tuple
 
 from scaler.io.ymq import _ymq
 from scaler.io.ymq.utils import call_async, call_sync
@@ -9,26 +9,51 @@ class BinderSocket:
 
     _base: _ymq.BinderSocket
 
-    def __init__(self, context: _ymq.IOContext, identity: str) -> None:
-        self._base = _ymq.BinderSocket(context, identity)
+    def __init__(
+        self,
+        context: _ymq.IOContext,
+        identity: str,
+        num_threads: int = 1,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
+    ) -> None:
+        self._base = _ymq.BinderSocket(context, identity, num_threads, max_queued_messages, max_queued_bytes)
 
     @property
     def identity(self) -> str:
         return self._base.identity
 
+    @property
+    def num_threads(self) -> int:
+        return self._base.num_threads
+
+    @property
+    def send_queue_depth(self) -> Tuple[int, int]:
+        return self._base.send_queue_depth
+
     async def bind_to(self, address: str) -> _ymq.Address:
         return await call_async(self._base.bind_to, address)
 
     def bind_to_sync(self, address: str, /, timeout: Optional[float] = None) -> _ymq.Address:
         return call_sync(self._base.bind_to, address, timeout=timeout)
 
-    async def send_message(self, remote_identity: str, message_payload: _ymq.Bytes) -> None:
-        await call_async(self._base.send_message, remote_identity, message_payload)
+    async def send_message(
+        self,
+        remote_identity: str,
+        message_payload: _ymq.Bytes,
+        priority: _ymq.MessagePriority = _ymq.MessagePriority.Normal,
+    ) -> None:
+        await call_async(self._base.send_message, remote_identity, message_payload, priority)
 
     def send_message_sync(
-        self, remote_identity: str, message_payload: _ymq.Bytes, /, timeout: Optional[float] = None
+        self,
+        remote_identity: str,
+        message_payload: _ymq.Bytes,
+        priority: _ymq.MessagePriority = _ymq.MessagePriority.Normal,
+        /,
+        timeout: Optional[float] = None,
     ) -> None:
-        call_sync(self._base.send_message, remote_identity, message_payload, timeout=timeout)
+        call_sync(self._base.send_message, remote_identity, message_payload, priority, timeout=timeout)
 
     def send_multicast_message(self, message_payload: _ymq.Bytes, remote_prefix: Optional[str] = None) -> None:
         self._base.send_multicast_message(message_payload, remote_prefix)
@@ -39,6 +64,12 @@ class BinderSocket:
     def recv_message_sync(self, /, timeout: Optional[float] = None) -> _ymq.Message:
         return call_sync(self._base.recv_message, timeout=timeout)
 
+    async def recv_messages(self, max_count: int) -> List[_ymq.Message]:
+        return await call_async(self._base.recv_messages, max_count)
+
+    def recv_messages_sync(self, max_count: int, /, timeout: Optional[float] = None) -> List[_ymq.Message]:
+        return call_sync(self._base.recv_messages, max_count, timeout=timeout)
+
     def close_connection(self, remote_identity: str) -> None:
         self._base.close_connection(remote_identity)
 
@@ -61,6 +92,8 @@ class ConnectorSocket:
         address: str,
         max_retry_times: int = _ymq.DEFAULT_MAX_RETRY_TIMES,
         init_retry_delay: int = _ymq.DEFAULT_INIT_RETRY_DELAY,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
     ) -> "ConnectorSocket":
         base_socket: Optional[_ymq.ConnectorSocket] = None
 
@@ -68,7 +101,16 @@ class ConnectorSocket:
             nonlocal base_socket
             base_socket = _ymq.ConnectorSocket.connect(callback, *args, **kwargs)
 
-        call_sync(create, context, identity, address, max_retry_times, init_retry_delay)
+        call_sync(
+            create,
+            context,
+            identity,
+            address,
+            max_retry_times,
+            init_retry_delay,
+            max_queued_messages,
+            max_queued_bytes,
+        )
         assert base_socket is not None
 
         return ConnectorSocket(base_socket)
@@ -80,6 +122,8 @@ class ConnectorSocket:
         address: str,
         max_retry_times: int = _ymq.DEFAULT_MAX_RETRY_TIMES,
         init_retry_delay: int = _ymq.DEFAULT_INIT_RETRY_DELAY,
+        max_queued_messages: int = 0,
+        max_queued_bytes: int = 0,
     ) -> "ConnectorSocket":
         base_socket: Optional[_ymq.ConnectorSocket] = None
 
@@ -87,20 +131,31 @@ class ConnectorSocket:
             nonlocal base_socket
             base_socket = _ymq.ConnectorSocket.connect(callback, *args, **kwargs)
 
-        await call_async(create, context, identity, address, max_retry_times, init_retry_delay)
+        await call_async(
+            create,
+            context,
+            identity,
+            address,
+            max_retry_times,
+            init_retry_delay,
+            max_queued_messages,
+            max_queued_bytes,
+        )
         assert base_socket is not None
 
         return ConnectorSocket(base_socket)
 
     @staticmethod
-    def bind(context: _ymq.IOContext, identity: str, address: str) -> "ConnectorSocket":
+    def bind(
+        context: _ymq.IOContext, identity: str, address: str, max_queued_messages: int = 0, max_queued_bytes: int = 0
+    ) -> "ConnectorSocket":
         base_socket: Optional[_ymq.ConnectorSocket] = None
 
         def create(callback, *args, **kwargs):
             nonlocal base_socket
             base_socket = _ymq.ConnectorSocket.bind(callback, *args, **kwargs)
 
-        call_sync(create, context, identity, address)
+        call_sync(create, context, identity, address, max_queued_messages, max_queued_bytes)
         assert base_socket is not None
 
         return ConnectorSocket(base_socket)
@@ -109,11 +164,23 @@ class ConnectorSocket:
     def identity(self) -> str:
         return self._base.identity
 
-    async def send_message(self, message_payload: _ymq.Bytes) -> None:
-        await call_async(self._base.send_message, message_payload)
+    @property
+    def send_queue_depth(self) -> Tuple[int, int]:
+        return self._base.send_queue_depth
 
-    def send_message_sync(self, message_payload: _ymq.Bytes, /, timeout: Optional[float] = None) -> None:
-        call_sync(self._base.send_message, message_payload, timeout=timeout)
+    async def send_message(
+        self, message_payload: _ymq.Bytes, priority: _ymq.MessagePriority = _ymq.MessagePriority.Normal
+    ) -> None:
+        await call_async(self._base.send_message, message_payload, priority)
+
+    def send_message_sync(
+        self,
+        message_payload: _ymq.Bytes,
+        priority: _ymq.MessagePriority = _ymq.MessagePriority.Normal,
+        /,
+        timeout: Optional[float] = None,
+    ) -> None:
+        call_sync(self._base.send_message, message_payload, priority, timeout=timeout)
 
     async def recv_message(self) -> _ymq.Message:
         return await call_async(self._base.recv_message)
@@ -121,5 +188,11 @@ class ConnectorSocket:
     def recv_message_sync(self, /, timeout: Optional[float] = None) -> _ymq.Message:
         return call_sync(self._base.recv_message, timeout=timeout)
 
+    async def recv_messages(self, max_count: int) -> List[_ymq.Message]:
+        return await call_async(self._base.recv_messages, max_count)
+
+    def recv_messages_sync(self, max_count: int, /, timeout: Optional[float] = None) -> List[_ymq.Message]:
+        return call_sync(self._base.recv_messages, max_count, timeout=timeout)
+
     def shutdown(self) -> None:
         self._base.shutdown()
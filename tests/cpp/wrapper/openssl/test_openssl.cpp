@@ -8,9 +8,11 @@
 #include <string>
 #include <vector>
 
+#include "scaler/wrapper/openssl/kernel_tls.h"
 #include "scaler/wrapper/openssl/secure_server.h"
 #include "scaler/wrapper/openssl/secure_socket.h"
 #include "scaler/wrapper/openssl/ssl_context.h"
+#include "scaler/wrapper/openssl/types.h"
 #include "scaler/wrapper/uv/callback.h"
 #include "scaler/wrapper/uv/loop.h"
 #include "scaler/wrapper/uv/socket_address.h"
@@ -133,17 +135,16 @@ private:
     }
 };
 
-TEST_F(OpenSSLTest, EchoServer)
+// Connects a client to the TLSEchoServer, checks the echoed message, and shuts both ends down.
+//
+// Returns whether the client resumed a previous TLS session.
+static bool echo(
+    scaler::wrapper::uv::Loop& loop, TLSEchoServer& server, scaler::wrapper::openssl::SSLContext clientContext)
 {
     const std::vector<uint8_t> message {'h', 'e', 'l', 'l', 'o'};
 
-    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
-
-    TLSEchoServer server(loop, createServerContext());
-
     // Create a TLS client and connect to the server
 
-    auto clientContext = createClientContext();
     scaler::wrapper::openssl::SecureSocket client =
         UV_EXIT_ON_ERROR(scaler::wrapper::openssl::SecureSocket::init(loop, std::move(clientContext)));
 
@@ -175,7 +176,7 @@ TEST_F(OpenSSLTest, EchoServer)
     }
 
     client.readStop();
-    ASSERT_TRUE(server.clientConnected());
+    EXPECT_TRUE(server.clientConnected());
 
     // Shutdown the client and verify the server sees the disconnect
 
@@ -189,4 +190,147 @@ TEST_F(OpenSSLTest, EchoServer)
     while (!shutdownComplete || server.clientConnected()) {
         loop.run(UV_RUN_ONCE);
     }
+
+    return client.sessionReused();
+}
+
+static void runEcho(
+    scaler::wrapper::openssl::SSLContext serverContext, scaler::wrapper::openssl::SSLContext clientContext)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    TLSEchoServer server(loop, std::move(serverContext));
+
+    echo(loop, server, std::move(clientContext));
+}
+
+TEST_F(OpenSSLTest, EchoServer)
+{
+    runEcho(createServerContext(), createClientContext());
+}
+
+TEST_F(OpenSSLTest, EchoServerKernelTLS)
+{
+    // Falls back to user space encryption when the kernel doesn't support kTLS.
+    auto serverContext = createServerContext();
+    serverContext.enableKernelTLS();
+    ASSERT_TRUE(serverContext.kernelTLSEnabled());
+
+    auto clientContext = createClientContext();
+    clientContext.enableKernelTLS();
+
+    runEcho(std::move(serverContext), std::move(clientContext));
+}
+
+TEST_F(OpenSSLTest, EchoServerManyBuffers)
+{
+    // Small buffers are coalesced into records, large ones are written directly. The echoed data must be identical.
+    const std::vector<size_t> bufferSizes {8, 0, 100, 1, 16 * 1024 - 3, 8, 40 * 1024, 5, 0, 16 * 1024, 3};
+
+    std::vector<std::vector<uint8_t>> buffers {};
+    std::vector<uint8_t> expected {};
+    for (const size_t size: bufferSizes) {
+        std::vector<uint8_t> buffer(size);
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] = static_cast<uint8_t>(expected.size() + i);
+        }
+        expected.insert(expected.end(), buffer.begin(), buffer.end());
+        buffers.emplace_back(std::move(buffer));
+    }
+
+    const std::vector<std::span<const uint8_t>> spans(buffers.begin(), buffers.end());
+
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    TLSEchoServer server(loop, createServerContext());
+
+    scaler::wrapper::openssl::SecureSocket client =
+        UV_EXIT_ON_ERROR(scaler::wrapper::openssl::SecureSocket::init(loop, createClientContext()));
+
+    std::vector<uint8_t> received {};
+    bool writeComplete = false;
+
+    auto onClientRead = [&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+        std::span<const uint8_t> buffer = UV_EXIT_ON_ERROR(result);
+        received.insert(received.end(), buffer.begin(), buffer.end());
+    };
+
+    auto onClientConnected = [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+
+        UV_EXIT_ON_ERROR(client.readStart(onClientRead));
+
+        UV_EXIT_ON_ERROR(client.write(spans, [&](std::expected<void, scaler::wrapper::uv::Error>&& result) {
+            UV_EXIT_ON_ERROR(result);
+            writeComplete = true;
+        }));
+    };
+
+    UV_EXIT_ON_ERROR(client.connect(server.address(), onClientConnected));
+
+    while (!writeComplete || received.size() < expected.size()) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    ASSERT_EQ(received, expected);
+
+    client.readStop();
+
+    bool shutdownComplete = false;
+
+    UV_EXIT_ON_ERROR(client.shutdown([&](std::expected<void, scaler::wrapper::uv::Error> shutdownResult) {
+        UV_EXIT_ON_ERROR(shutdownResult);
+        shutdownComplete = true;
+    }));
+
+    while (!shutdownComplete || server.clientConnected()) {
+        loop.run(UV_RUN_ONCE);
+    }
+}
+
+TEST_F(OpenSSLTest, SessionResumption)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    TLSEchoServer server(loop, createServerContext());
+
+    auto clientContext = createClientContext();
+    clientContext.enableSessionResumption();
+    ASSERT_NE(clientContext.sessionCache(), nullptr);
+
+    // The first connection does a full handshake, and receives a session ticket.
+    ASSERT_FALSE(echo(loop, server, clientContext));
+
+    // The following ones resume the session.
+    ASSERT_TRUE(echo(loop, server, clientContext));
+    ASSERT_TRUE(echo(loop, server, clientContext));
+
+    // Without a session cache, the client always does a full handshake.
+    ASSERT_FALSE(echo(loop, server, createClientContext()));
+}
+
+TEST_F(OpenSSLTest, DeriveTLS13TrafficKeys)
+{
+    // Server application traffic secret and keys from RFC 8448 section 3.
+    const std::vector<uint8_t> secret {
+        0xa1, 0x1a, 0xf9, 0xf0, 0x55, 0x31, 0xf8, 0x56, 0xad, 0x47, 0x11, 0x6b, 0x45, 0xa9, 0x50, 0x32,
+        0x82, 0x04, 0xb4, 0xf4, 0x4b, 0xfb, 0x6b, 0x3a, 0x4b, 0x4f, 0x1f, 0x3f, 0xcb, 0x63, 0x16, 0x43,
+    };
+    const std::vector<uint8_t> expectedKey {
+        0x9f, 0x02, 0x28, 0x3b, 0x6c, 0x9c, 0x07, 0xef, 0xc2, 0x6b, 0xb9, 0xf2, 0xac, 0x92, 0xe3, 0x56,
+    };
+    const std::vector<uint8_t> expectedIV {0xcf, 0x78, 0x2b, 0x88, 0xdd, 0x83, 0x54, 0x9a, 0xad, 0xf1, 0xe9, 0x84};
+
+    auto context = createClientContext();
+    scaler::wrapper::openssl::SSLPtr<SSL> ssl {SSL_new(context.native())};
+    ASSERT_NE(ssl, nullptr);
+
+    const unsigned char aes128GCMSHA256[] = {0x13, 0x01};
+    const SSL_CIPHER* cipher              = SSL_CIPHER_find(ssl.get(), aes128GCMSHA256);
+    ASSERT_NE(cipher, nullptr);
+
+    auto keys = scaler::wrapper::openssl::deriveTLS13TrafficKeys(cipher, secret);
+    ASSERT_TRUE(keys.has_value());
+    ASSERT_EQ(keys->key, expectedKey);
+    ASSERT_EQ(keys->iv, expectedIV);
 }
@@ -1,3 +1,86 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "scaler/wrapper/uv/callback.h"
+#include "scaler/wrapper/uv/loop.h"
+#include "scaler/wrapper/uv/pipe.h"
+
 // Unix-specific pipe name prefix
 // On Unix, pipes are file paths, typically in /tmp/
 const char* pipeNamePrefix = "/tmp/";
+
+class UVPipeTestUnix: public ::testing::Test {};
+
+TEST_F(UVPipeTestUnix, SendFileDescriptor)
+{
+    const std::string fileContent = "hello";
+
+    const std::string pipeName = std::string(pipeNamePrefix) + "scaler_test_pipe_fd_" + std::to_string(getpid());
+
+    // A temporary file to send over the pipe
+    std::string filePath = std::string(pipeNamePrefix) + "scaler_test_pipe_fd_XXXXXX";
+    const int fd         = mkstemp(filePath.data());
+    ASSERT_GE(fd, 0);
+    unlink(filePath.c_str());
+    ASSERT_EQ(write(fd, fileContent.data(), fileContent.size()), static_cast<ssize_t>(fileContent.size()));
+
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    scaler::wrapper::uv::PipeServer server = UV_EXIT_ON_ERROR(scaler::wrapper::uv::PipeServer::init(loop, false));
+    UV_EXIT_ON_ERROR(server.bind(pipeName));
+
+    std::optional<scaler::wrapper::uv::Pipe> serverClient {};
+    std::optional<std::string> receivedContent {};
+
+    auto onServerClientRead = [&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+
+        // The file descriptor is received along with the data
+        scaler::wrapper::uv::Pipe pending = UV_EXIT_ON_ERROR(serverClient->acceptPending());
+
+        std::string content(fileContent.size(), '\0');
+        ASSERT_EQ(
+            pread(UV_EXIT_ON_ERROR(pending.fileno()), content.data(), content.size(), 0),
+            static_cast<ssize_t>(content.size()));
+        receivedContent = content;
+
+        ASSERT_EQ(serverClient->acceptPending().error(), scaler::wrapper::uv::Error {UV_EAGAIN});
+    };
+
+    UV_EXIT_ON_ERROR(server.listen(16, [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+
+        serverClient.emplace(UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(loop, true)));
+        UV_EXIT_ON_ERROR(server.accept(*serverClient));
+        UV_EXIT_ON_ERROR(serverClient->readStart(onServerClientRead));
+    }));
+
+    scaler::wrapper::uv::Pipe client = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(loop, true));
+
+    const std::string message = "x";
+    const std::span<const uint8_t> buffer(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+
+    UV_EXIT_ON_ERROR(client.connect(pipeName, [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+
+        UV_EXIT_ON_ERROR(client.write(
+            std::span<const std::span<const uint8_t>>(&buffer, 1),
+            fd,
+            [](std::expected<void, scaler::wrapper::uv::Error> result) { UV_EXIT_ON_ERROR(result); }));
+    }));
+
+    while (!receivedContent.has_value()) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    EXPECT_EQ(receivedContent, fileContent);
+
+    unlink(pipeName.c_str());
+}
@@ -9,6 +9,7 @@
 #include "scaler/wrapper/uv/async.h"
 #include "scaler/wrapper/uv/error.h"
 #include "scaler/wrapper/uv/loop.h"
+#include "scaler/wrapper/uv/prepare.h"
 #include "scaler/wrapper/uv/request.h"
 #include "scaler/wrapper/uv/signal.h"
 #include "scaler/wrapper/uv/timer.h"
@@ -120,6 +121,28 @@ TEST_F(UVTest, Loop)
     }
 }
 
+TEST_F(UVTest, Prepare)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    int nTimesCalled = 0;
+
+    scaler::wrapper::uv::Prepare prepare = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Prepare::init(loop));
+    UV_EXIT_ON_ERROR(prepare.start([&]() { ++nTimesCalled; }));
+
+    // Called once per loop iteration
+    loop.run(UV_RUN_NOWAIT);
+    ASSERT_EQ(nTimesCalled, 1);
+
+    loop.run(UV_RUN_NOWAIT);
+    ASSERT_EQ(nTimesCalled, 2);
+
+    // Stop should prevent further executions
+    UV_EXIT_ON_ERROR(prepare.stop());
+    loop.run(UV_RUN_NOWAIT);
+    ASSERT_EQ(nTimesCalled, 2);
+}
+
 TEST_F(UVTest, Request)
 {
     // Mock a write request
@@ -1,8 +1,14 @@
 #include <errno.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <uv.h>
 
+#include <array>
+#include <expected>
+
 #include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/loop.h"
+#include "scaler/wrapper/uv/poll.h"
 
 class UVTestUnix: public ::testing::Test {};
 
@@ -10,3 +16,42 @@ TEST_F(UVTestUnix, Error)
 {
     ASSERT_EQ(scaler::wrapper::uv::Error::fromSysError(EEXIST), scaler::wrapper::uv::Error(UV_EEXIST));
 }
+
+TEST_F(UVTestUnix, Poll)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+
+    std::array<int, 2> fds {};
+    ASSERT_EQ(pipe(fds.data()), 0);
+
+    int nTimesCalled = 0;
+
+    {
+        scaler::wrapper::uv::Poll poll = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Poll::init(loop, fds[0]));
+
+        UV_EXIT_ON_ERROR(poll.start(UV_READABLE, [&](std::expected<int, scaler::wrapper::uv::Error> events) {
+            ASSERT_EQ(UV_EXIT_ON_ERROR(events) & UV_READABLE, UV_READABLE);
+            ++nTimesCalled;
+        }));
+
+        // Not readable yet
+        loop.run(UV_RUN_NOWAIT);
+        ASSERT_EQ(nTimesCalled, 0);
+
+        const char byte = 'x';
+        ASSERT_EQ(write(fds[1], &byte, 1), 1);
+
+        loop.run(UV_RUN_NOWAIT);
+        ASSERT_EQ(nTimesCalled, 1);
+
+        // Stop should prevent further executions, even if the file descriptor is still readable
+        UV_EXIT_ON_ERROR(poll.stop());
+        loop.run(UV_RUN_NOWAIT);
+        ASSERT_EQ(nTimesCalled, 1);
+    }
+
+    loop.run(UV_RUN_NOWAIT);
+
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -31,6 +31,7 @@ std::vector<std::string> getTransports()
     transports.push_back("ws");
 #ifdef __linux__
     transports.push_back("ipc");
+    transports.push_back("shm");
 #endif
     return transports;
 }
@@ -50,6 +51,13 @@ std::string getTransportAddress(const std::string& transport, int port)
         }
         return std::format("ipc:///tmp/ymq-test-{}.ipc", port);
     }
+    if (transport == "shm") {
+        const char* runnerTemp = std::getenv("RUNNER_TEMP");
+        if (runnerTemp) {
+            return std::format("shm://{}/ymq-test-{}.shm", runnerTemp, port);
+        }
+        return std::format("shm:///tmp/ymq-test-{}.shm", port);
+    }
     if (transport == "ws") {
         return std::format("ws://127.0.0.1:{}/", port);
     }
@@ -20,7 +20,7 @@ void chdirToProjectRoot();
 // Return the list of transports to parameterize the socket test suites with.
 std::vector<std::string> getTransports();
 
-// Build an address string for the given transport ("tcp", "tls", "ipc", "ws" or "wss").
+// Build an address string for the given transport ("tcp", "tls", "ipc", "ws", "wss" or "shm").
 std::string getTransportAddress(const std::string& transport, int port);
 
 // Return a TLSConfig for secure transports, or std::nullopt otherwise.
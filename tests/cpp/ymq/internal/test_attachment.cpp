@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/ymq/internal/attachment.h"
+
+class AttachmentTest: public ::testing::Test {};
+
+TEST_F(AttachmentTest, CreateAndMap)
+{
+    ASSERT_TRUE(scaler::ymq::internal::attachmentsSupported());
+
+    std::vector<uint8_t> payload(3 * 4096 + 17);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    const int fd = UV_EXIT_ON_ERROR(scaler::ymq::internal::createAttachment(payload));
+
+    auto bytes = UV_EXIT_ON_ERROR(scaler::ymq::internal::mapAttachment(fd, payload.size()));
+    ::close(fd);  // the mapping outlives the file descriptor
+
+    ASSERT_EQ(bytes->size(), payload.size());
+    ASSERT_EQ(std::memcmp(bytes->data(), payload.data(), payload.size()), 0);
+
+    // The mapping is private, writing to it doesn't change the attachment.
+    bytes->data()[0] = ~payload[0];
+    EXPECT_NE(bytes->data()[0], payload[0]);
+}
+
+TEST_F(AttachmentTest, EmptyPayload)
+{
+    const int fd = UV_EXIT_ON_ERROR(scaler::ymq::internal::createAttachment({}));
+
+    auto bytes = UV_EXIT_ON_ERROR(scaler::ymq::internal::mapAttachment(fd, 0));
+    ::close(fd);
+
+    EXPECT_EQ(bytes->size(), 0);
+}
+
+TEST_F(AttachmentTest, RejectsSizeMismatch)
+{
+    const std::string payload = "hello";
+
+    const int fd = UV_EXIT_ON_ERROR(scaler::ymq::internal::createAttachment(
+        std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(payload.data()), payload.size())));
+
+    auto bytes = scaler::ymq::internal::mapAttachment(fd, payload.size() + 1);
+    ::close(fd);
+
+    ASSERT_FALSE(bytes.has_value());
+    EXPECT_EQ(bytes.error(), scaler::wrapper::uv::Error {UV_EPROTO});
+}
+
+TEST_F(AttachmentTest, RejectsUnsealedFile)
+{
+    // The sender could still truncate the file while the receiver reads it.
+    const int fd = ::memfd_create("ymq-test-attachment", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::ftruncate(fd, 4096), 0);
+
+    auto bytes = scaler::ymq::internal::mapAttachment(fd, 4096);
+    ::close(fd);
+
+    ASSERT_FALSE(bytes.has_value());
+    EXPECT_EQ(bytes.error(), scaler::wrapper::uv::Error {UV_EPROTO});
+}
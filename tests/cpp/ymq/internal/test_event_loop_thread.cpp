@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "scaler/ymq/internal/event_loop_thread.h"
 
@@ -27,3 +28,34 @@ TEST_F(YMQEventLoopThreadTest, EventLoopThread)
 
     ASSERT_EQ(nTimesCalled, nTasks);
 }
+
+TEST_F(YMQEventLoopThreadTest, ExecuteThreadSafeMultipleProducers)
+{
+    // Test that no callback is lost when several threads schedule callbacks concurrently
+
+    const size_t nProducers        = 8;
+    const size_t nTasksPerProducer = 10000;
+
+    std::atomic<size_t> nTimesCalled {0};
+
+    {
+        scaler::ymq::internal::EventLoopThread thread {};
+
+        std::vector<std::jthread> producers {};
+        for (size_t i = 0; i < nProducers; ++i) {
+            producers.emplace_back([&]() {
+                for (size_t j = 0; j < nTasksPerProducer; ++j) {
+                    thread.executeThreadSafe([&]() { ++nTimesCalled; });
+                }
+            });
+        }
+        producers.clear();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+        while (nTimesCalled < nProducers * nTasksPerProducer && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    ASSERT_EQ(nTimesCalled, nProducers * nTasksPerProducer);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/loop.h"
+#include "scaler/wrapper/uv/socket_address.h"
+#include "scaler/wrapper/uv/tcp.h"
+#include "scaler/ymq/internal/io_uring.h"
+#include "scaler/ymq/internal/io_uring_stream.h"
+
+class IOUringStreamTest: public ::testing::Test {};
+
+namespace {
+
+void runUntil(scaler::wrapper::uv::Loop& loop, const bool& done)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done && std::chrono::steady_clock::now() < deadline)
+        loop.run(UV_RUN_ONCE);
+}
+
+// Creates a pair of connected TCP sockets via a local TCP server, and moves both into an IOUringStream.
+// Not movable - lambdas capture 'this' by pointer.
+struct TestIOUringStreamPair {
+    scaler::wrapper::uv::Loop& _loop;
+    std::optional<scaler::ymq::internal::IOUring> _ring;
+    std::optional<scaler::wrapper::uv::TCPServer> _server;
+    std::optional<scaler::ymq::internal::IOUringStream> _client;
+    std::optional<scaler::ymq::internal::IOUringStream> _serverSide;
+
+    explicit TestIOUringStreamPair(scaler::wrapper::uv::Loop& loop): _loop(loop)
+    {
+        auto ring = scaler::ymq::internal::IOUring::init(_loop);
+        if (!ring.has_value()) {
+            return;  // io_uring is not available on this host
+        }
+        _ring.emplace(std::move(ring.value()));
+
+        _server.emplace(UV_EXIT_ON_ERROR(scaler::wrapper::uv::TCPServer::init(_loop)));
+        UV_EXIT_ON_ERROR(
+            _server->bind(UV_EXIT_ON_ERROR(scaler::wrapper::uv::SocketAddress::IPv4("127.0.0.1", 0)), uv_tcp_flags(0)));
+        UV_EXIT_ON_ERROR(_server->listen(1, [this](std::expected<void, scaler::wrapper::uv::Error> result) {
+            UV_EXIT_ON_ERROR(result);
+            auto socket = UV_EXIT_ON_ERROR(scaler::wrapper::uv::TCPSocket::init(_loop));
+            UV_EXIT_ON_ERROR(_server->accept(socket));
+            _serverSide.emplace(_ring.value(), std::move(socket));
+        }));
+
+        auto socket = UV_EXIT_ON_ERROR(scaler::wrapper::uv::TCPSocket::init(_loop));
+
+        bool clientConnected = false;
+        UV_EXIT_ON_ERROR(socket.connect(
+            UV_EXIT_ON_ERROR(_server->getSockName()), [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+                UV_EXIT_ON_ERROR(result);
+                clientConnected = true;
+            }));
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((!clientConnected || !_serverSide.has_value()) && std::chrono::steady_clock::now() < deadline)
+            _loop.run(UV_RUN_ONCE);
+
+        _client.emplace(_ring.value(), std::move(socket));
+    }
+
+    ~TestIOUringStreamPair()
+    {
+        // Let the cancelled operations complete before destroying the ring.
+        _client.reset();
+        _serverSide.reset();
+        _server.reset();
+        _loop.run(UV_RUN_NOWAIT);
+    }
+
+    TestIOUringStreamPair(const TestIOUringStreamPair&)            = delete;
+    TestIOUringStreamPair& operator=(const TestIOUringStreamPair&) = delete;
+    TestIOUringStreamPair(TestIOUringStreamPair&&)                 = delete;
+    TestIOUringStreamPair& operator=(TestIOUringStreamPair&&)      = delete;
+};
+
+}  // namespace
+
+// Streams several megabytes in more writes than fit in a single chain of linked sends, so that the writes queued while
+// a chain is in flight are submitted as the next ones.
+TEST_F(IOUringStreamTest, LargeTransfer)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestIOUringStreamPair pair(loop);
+    if (!pair._ring.has_value()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._serverSide.has_value());
+
+    std::vector<uint8_t> sent(8 * 1024 * 1024);
+    for (size_t i = 0; i < sent.size(); ++i)
+        sent[i] = static_cast<uint8_t>(i * 31 + 7);
+
+    std::vector<uint8_t> received {};
+    bool allReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._serverSide->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            received.insert(received.end(), result->begin(), result->end());
+            allReceived = received.size() == sent.size();
+        }));
+
+    // Each write is made of two buffers, to exercise the scatter-gather sends. The sizes grow up to 128 KB, then
+    // restart from small writes.
+    std::vector<std::array<std::span<const uint8_t>, 2>> writes {};
+    for (size_t offset = 0, size = 1; offset < sent.size(); offset += size) {
+        size = std::min(size > 64 * 1024 ? 1 : size * 2 + 1, sent.size() - offset);
+
+        const size_t half = size / 2;
+        writes.push_back({
+            std::span<const uint8_t>(sent.data() + offset, half),
+            std::span<const uint8_t>(sent.data() + offset + half, size - half),
+        });
+    }
+    ASSERT_GT(writes.size(), 64U);
+
+    size_t writesDone = 0;
+    for (const auto& buffers: writes) {
+        UV_EXIT_ON_ERROR(
+            pair._client->write(buffers, [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+                UV_EXIT_ON_ERROR(result);
+                ++writesDone;
+            }));
+    }
+
+    runUntil(loop, allReceived);
+
+    ASSERT_TRUE(allReceived);
+    EXPECT_EQ(received, sent);
+    EXPECT_EQ(writesDone, writes.size());
+}
+
+// The shutdown waits for the pending writes, the peer then reads the pending bytes and UV_EOF.
+TEST_F(IOUringStreamTest, GracefulShutdown)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestIOUringStreamPair pair(loop);
+    if (!pair._ring.has_value()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._serverSide.has_value());
+
+    const std::string message = "hello";
+    const std::span<const uint8_t> buffer(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+
+    bool writeDone = false;
+    UV_EXIT_ON_ERROR(pair._serverSide->write(
+        std::span<const std::span<const uint8_t>>(&buffer, 1),
+        [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+            UV_EXIT_ON_ERROR(result);
+            writeDone = true;
+        }));
+
+    bool shutdownDone = false;
+    UV_EXIT_ON_ERROR(pair._serverSide->shutdown([&](std::expected<void, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+        EXPECT_TRUE(writeDone);
+        shutdownDone = true;
+    }));
+
+    // Can no longer write once shut down
+    ASSERT_FALSE(pair._serverSide
+                     ->write(
+                         std::span<const std::span<const uint8_t>>(&buffer, 1),
+                         [](std::expected<void, scaler::wrapper::uv::Error>) {})
+                     .has_value());
+
+    std::string received {};
+    bool eofReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._client->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            if (!result.has_value()) {
+                EXPECT_EQ(result.error(), scaler::wrapper::uv::Error {UV_EOF});
+                eofReceived = true;
+                return;
+            }
+            received.append(reinterpret_cast<const char*>(result->data()), result->size());
+        }));
+
+    runUntil(loop, eofReceived);
+    runUntil(loop, shutdownDone);
+
+    EXPECT_EQ(received, message);
+    EXPECT_TRUE(eofReceived);
+    EXPECT_TRUE(shutdownDone);
+}
+
+// closeReset() is reported to the peer as a reset, once the pending receive is cancelled.
+TEST_F(IOUringStreamTest, CloseReset)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestIOUringStreamPair pair(loop);
+    if (!pair._ring.has_value()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._serverSide.has_value());
+
+    UV_EXIT_ON_ERROR(pair._client->readStart([](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error>) {
+        FAIL() << "read callback called after closeReset()";
+    }));
+
+    bool errorReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._serverSide->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            ASSERT_FALSE(result.has_value());
+            EXPECT_EQ(result.error(), scaler::wrapper::uv::Error {UV_ECONNRESET});
+            errorReceived = true;
+        }));
+
+    loop.run(UV_RUN_NOWAIT);
+
+    UV_EXIT_ON_ERROR(pair._client->closeReset());
+
+    runUntil(loop, errorReceived);
+    EXPECT_TRUE(errorReceived);
+}
+
+// The data received after readStop() is not passed to the callback, and reading can be resumed.
+TEST_F(IOUringStreamTest, ReadStop)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestIOUringStreamPair pair(loop);
+    if (!pair._ring.has_value()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._serverSide.has_value());
+
+    const std::string message = "ping";
+    const std::span<const uint8_t> buffer(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+
+    std::string received {};
+    bool messageReceived = false;
+    const auto onRead    = [&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+        ASSERT_TRUE(result.has_value());
+        received.append(reinterpret_cast<const char*>(result->data()), result->size());
+        messageReceived = received.size() == message.size();
+    };
+
+    UV_EXIT_ON_ERROR(pair._serverSide->readStart(onRead));
+    UV_EXIT_ON_ERROR(pair._client->write(
+        std::span<const std::span<const uint8_t>>(&buffer, 1),
+        [](std::expected<void, scaler::wrapper::uv::Error> result) { UV_EXIT_ON_ERROR(result); }));
+
+    runUntil(loop, messageReceived);
+    ASSERT_EQ(received, message);
+
+    pair._serverSide->readStop();
+    received.clear();
+    messageReceived = false;
+
+    UV_EXIT_ON_ERROR(pair._serverSide->readStart(onRead));
+    UV_EXIT_ON_ERROR(pair._client->write(
+        std::span<const std::span<const uint8_t>>(&buffer, 1),
+        [](std::expected<void, scaler::wrapper::uv::Error> result) { UV_EXIT_ON_ERROR(result); }));
+
+    runUntil(loop, messageReceived);
+    EXPECT_EQ(received, message);
+}
@@ -4,6 +4,7 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <vector>
 
 #include "scaler/wrapper/uv/callback.h"
 #include "scaler/wrapper/uv/error.h"
@@ -12,7 +13,9 @@
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/buffered_bytes.h"
 #include "scaler/ymq/bytes.h"
+#include "scaler/ymq/configuration.h"
 #include "scaler/ymq/internal/message_connection.h"
+#include "scaler/ymq/message_priority.h"
 
 class YMQMessageConnectionTest: public ::testing::Test {};
 
@@ -307,6 +310,57 @@ TEST_F(YMQMessageConnectionTest, EmptyMessage)
     }
 }
 
+TEST_F(YMQMessageConnectionTest, HighPriorityMessageOvertakesLargeMessage)
+{
+    // Test that a high priority message is sent in between the fragments of a large normal priority message sent
+    // before it, and that the large message is reassembled intact.
+
+    const std::string largeMessagePayload(16 * scaler::ymq::messageFragmentSize + 1, 'x');
+    const std::string highPriorityMessagePayload = "heartbeat";
+
+    std::vector<std::string> serverMessagesReceived {};
+
+    ConnectionPair connections(
+        // Server callbacks
+        []([[maybe_unused]] auto identity) {},                      // onRemoteIdentity
+        [](auto) { FAIL() << "Unexpected disconnect on server"; },  // onRemoteDisconnect
+        [&](std::unique_ptr<scaler::ymq::Bytes> messagePayload) {   // onMessage
+            serverMessagesReceived.push_back(messagePayload->asString().value());
+        },
+
+        // Client callbacks
+        []([[maybe_unused]] auto identity) {},                      // onRemoteIdentity
+        [](auto) { FAIL() << "Unexpected disconnect on client"; },  // onRemoteDisconnect
+        [](auto) { FAIL() << "Unexpected message on client"; }      // onMessage
+    );
+
+    scaler::ymq::internal::MessageConnection& server = connections.server();
+    scaler::ymq::internal::MessageConnection& client = connections.client();
+    scaler::wrapper::uv::Loop& loop                  = connections.loop();
+
+    // Wait for identity exchange
+    while (!server.established() || !client.established()) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    client.sendMessage(std::make_unique<scaler::ymq::BufferedBytes>(largeMessagePayload), [](auto result, auto) {
+        ASSERT_TRUE(result.has_value());
+    });
+
+    client.sendMessage(
+        std::make_unique<scaler::ymq::BufferedBytes>(highPriorityMessagePayload),
+        [](auto result, auto) { ASSERT_TRUE(result.has_value()); },
+        scaler::ymq::MessagePriority::High);
+
+    // Wait for the messages
+    while (serverMessagesReceived.size() < 2) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    ASSERT_EQ(serverMessagesReceived[0], highPriorityMessagePayload);
+    ASSERT_EQ(serverMessagesReceived[1], largeMessagePayload);
+}
+
 TEST_F(YMQMessageConnectionTest, InvalidMagicString)
 {
     // Check the message connection abort a connection if it does not receive the expected magic string
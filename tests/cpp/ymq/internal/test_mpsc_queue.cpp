@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "scaler/ymq/internal/mpsc_queue.h"
+
+namespace {
+
+struct Item: public scaler::ymq::internal::MPSCQueueNode {
+    size_t producer;
+    size_t value;
+
+    Item(size_t producer, size_t value): producer(producer), value(value) {}
+};
+
+}  // namespace
+
+class YMQMPSCQueueTest: public ::testing::Test {};
+
+TEST_F(YMQMPSCQueueTest, FIFOOrder)
+{
+    scaler::ymq::internal::MPSCQueue<Item> queue {};
+
+    ASSERT_TRUE(queue.empty());
+
+    queue.push(std::make_unique<Item>(0, 0));
+    queue.push(std::make_unique<Item>(0, 1));
+    queue.push(std::make_unique<Item>(0, 2));
+
+    ASSERT_FALSE(queue.empty());
+
+    std::vector<size_t> values {};
+    size_t count = queue.consumeAll([&](std::unique_ptr<Item> item) { values.push_back(item->value); });
+
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(values, (std::vector<size_t> {0, 1, 2}));
+    ASSERT_TRUE(queue.empty());
+
+    // Nodes pushed while consuming are kept for the next call
+    queue.push(std::make_unique<Item>(0, 3));
+    count = queue.consumeAll([&](std::unique_ptr<Item> item) {
+        values.push_back(item->value);
+        if (item->value == 3) {
+            queue.push(std::make_unique<Item>(0, 4));
+        }
+    });
+
+    ASSERT_EQ(count, 1);
+    ASSERT_FALSE(queue.empty());
+
+    count = queue.consumeAll([&](std::unique_ptr<Item> item) { values.push_back(item->value); });
+
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(values, (std::vector<size_t> {0, 1, 2, 3, 4}));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(YMQMPSCQueueTest, MultipleProducers)
+{
+    // Test that items pushed concurrently by several threads are all consumed, in the order each producer pushed them
+
+    constexpr size_t nProducers        = 8;
+    constexpr size_t nItemsPerProducer = 10000;
+
+    scaler::ymq::internal::MPSCQueue<Item> queue {};
+
+    std::vector<size_t> nextValues(nProducers, 0);
+    size_t nConsumed = 0;
+
+    auto consume = [&](std::unique_ptr<Item> item) {
+        ASSERT_EQ(item->value, nextValues[item->producer]);
+        ++nextValues[item->producer];
+        ++nConsumed;
+    };
+
+    {
+        std::vector<std::jthread> producers {};
+        for (size_t producer = 0; producer < nProducers; ++producer) {
+            producers.emplace_back([&queue, producer]() {
+                for (size_t value = 0; value < nItemsPerProducer; ++value) {
+                    queue.push(std::make_unique<Item>(producer, value));
+                }
+            });
+        }
+
+        while (nConsumed < nProducers * nItemsPerProducer) {
+            queue.consumeAll(consume);
+        }
+    }
+
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(nextValues, std::vector<size_t>(nProducers, nItemsPerProducer));
+}
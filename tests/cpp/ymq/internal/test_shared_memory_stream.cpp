@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "scaler/wrapper/uv/error.h"
+#include "scaler/wrapper/uv/loop.h"
+#include "scaler/wrapper/uv/pipe.h"
+#include "scaler/ymq/internal/shared_memory_stream.h"
+
+class SharedMemoryStreamTest: public ::testing::Test {};
+
+namespace {
+
+// Small enough for the tests to wrap around the rings and fill them up.
+constexpr size_t testRingCapacity = 4096;
+
+void runUntil(scaler::wrapper::uv::Loop& loop, const bool& done)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done && std::chrono::steady_clock::now() < deadline)
+        loop.run(UV_RUN_ONCE);
+}
+
+// Creates a pair of connected pipes via a local pipe server.
+// Not movable - lambdas capture 'this' by pointer.
+struct TestPipePair {
+    scaler::wrapper::uv::Loop& _loop;
+    std::string _path;
+    std::optional<scaler::wrapper::uv::PipeServer> _server;
+    std::optional<scaler::wrapper::uv::Pipe> _client;
+    std::optional<scaler::wrapper::uv::Pipe> _serverSide;
+    bool _clientConnected = false;
+
+    explicit TestPipePair(scaler::wrapper::uv::Loop& loop)
+        : _loop(loop), _path(std::format("/tmp/ymq-test-shm-stream-{}.ipc", ::getpid()))
+    {
+        std::filesystem::remove(_path);
+
+        _server.emplace(UV_EXIT_ON_ERROR(scaler::wrapper::uv::PipeServer::init(_loop, false)));
+        UV_EXIT_ON_ERROR(_server->bind(_path));
+        UV_EXIT_ON_ERROR(_server->listen(1, [this](std::expected<void, scaler::wrapper::uv::Error> result) {
+            UV_EXIT_ON_ERROR(result);
+            auto pipe = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(_loop, false));
+            UV_EXIT_ON_ERROR(_server->accept(pipe));
+            _serverSide.emplace(std::move(pipe));
+        }));
+
+        _client.emplace(UV_EXIT_ON_ERROR(scaler::wrapper::uv::Pipe::init(_loop, false)));
+        UV_EXIT_ON_ERROR(_client->connect(_path, [this](std::expected<void, scaler::wrapper::uv::Error> result) {
+            UV_EXIT_ON_ERROR(result);
+            _clientConnected = true;
+        }));
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((!_clientConnected || !_serverSide.has_value()) && std::chrono::steady_clock::now() < deadline)
+            _loop.run(UV_RUN_ONCE);
+    }
+
+    ~TestPipePair()
+    {
+        _server.reset();
+        std::filesystem::remove(_path);
+    }
+
+    TestPipePair(const TestPipePair&)            = delete;
+    TestPipePair& operator=(const TestPipePair&) = delete;
+    TestPipePair(TestPipePair&&)                 = delete;
+    TestPipePair& operator=(TestPipePair&&)      = delete;
+};
+
+// Sets up a SharedMemoryStream on both ends of a pipe pair.
+struct TestSharedMemoryStreamPair {
+    TestPipePair _pipes;
+    std::optional<scaler::ymq::internal::SharedMemoryStream> _client;
+    std::optional<scaler::ymq::internal::SharedMemoryStream> _server;
+
+    explicit TestSharedMemoryStreamPair(scaler::wrapper::uv::Loop& loop): _pipes(loop)
+    {
+        bool clientUpgraded = false;
+        bool serverUpgraded = false;
+
+        scaler::ymq::internal::SharedMemoryStream::upgradeAsServer(
+            std::move(_pipes._serverSide.value()),
+            [&](std::expected<scaler::ymq::internal::SharedMemoryStream, scaler::wrapper::uv::Error> result) {
+                _server.emplace(UV_EXIT_ON_ERROR(result));
+                serverUpgraded = true;
+            });
+
+        scaler::ymq::internal::SharedMemoryStream::upgradeAsClient(
+            std::move(_pipes._client.value()),
+            [&](std::expected<scaler::ymq::internal::SharedMemoryStream, scaler::wrapper::uv::Error> result) {
+                _client.emplace(UV_EXIT_ON_ERROR(result));
+                clientUpgraded = true;
+            },
+            testRingCapacity);
+
+        runUntil(loop, clientUpgraded);
+        runUntil(loop, serverUpgraded);
+    }
+};
+
+}  // namespace
+
+// Streams more than the ring capacity in writes of various sizes, so that the producer wraps around the ring and waits
+// for free space.
+TEST_F(SharedMemoryStreamTest, LargeTransfer)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestSharedMemoryStreamPair pair(loop);
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._server.has_value());
+
+    std::vector<uint8_t> sent(256 * 1024);
+    for (size_t i = 0; i < sent.size(); ++i)
+        sent[i] = static_cast<uint8_t>(i * 31 + 7);
+
+    std::vector<uint8_t> received {};
+    bool allReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._server->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            received.insert(received.end(), result->begin(), result->end());
+            allReceived = received.size() == sent.size();
+        }));
+
+    size_t writesDone = 0;
+    size_t nWrites    = 0;
+    for (size_t offset = 0, size = 1; offset < sent.size(); offset += size, size = size * 3 + 1) {
+        size = std::min(size, sent.size() - offset);
+
+        const std::span<const uint8_t> buffer(sent.data() + offset, size);
+        UV_EXIT_ON_ERROR(pair._client->write(
+            std::span<const std::span<const uint8_t>>(&buffer, 1),
+            [&](std::expected<void, scaler::wrapper::uv::Error> result) {
+                UV_EXIT_ON_ERROR(result);
+                ++writesDone;
+            }));
+        ++nWrites;
+    }
+
+    runUntil(loop, allReceived);
+
+    ASSERT_TRUE(allReceived);
+    EXPECT_EQ(received, sent);
+    EXPECT_EQ(writesDone, nWrites);
+}
+
+// The peer reads the pending bytes, then UV_EOF.
+TEST_F(SharedMemoryStreamTest, GracefulShutdown)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestSharedMemoryStreamPair pair(loop);
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._server.has_value());
+
+    const std::string message = "hello";
+    const std::span<const uint8_t> buffer(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    UV_EXIT_ON_ERROR(pair._server->write(
+        std::span<const std::span<const uint8_t>>(&buffer, 1),
+        [](std::expected<void, scaler::wrapper::uv::Error> result) { UV_EXIT_ON_ERROR(result); }));
+
+    bool shutdownDone = false;
+    UV_EXIT_ON_ERROR(pair._server->shutdown([&](std::expected<void, scaler::wrapper::uv::Error> result) {
+        UV_EXIT_ON_ERROR(result);
+        shutdownDone = true;
+    }));
+
+    std::string received {};
+    bool eofReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._client->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            if (!result.has_value()) {
+                EXPECT_EQ(result.error(), scaler::wrapper::uv::Error {UV_EOF});
+                eofReceived = true;
+                return;
+            }
+            received.append(reinterpret_cast<const char*>(result->data()), result->size());
+        }));
+
+    runUntil(loop, eofReceived);
+    runUntil(loop, shutdownDone);
+
+    EXPECT_EQ(received, message);
+    EXPECT_TRUE(eofReceived);
+    EXPECT_TRUE(shutdownDone);
+}
+
+// Destroying a stream without shutting it down is reported to the peer as a reset.
+TEST_F(SharedMemoryStreamTest, PeerDestroyed)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestSharedMemoryStreamPair pair(loop);
+    ASSERT_TRUE(pair._client.has_value());
+    ASSERT_TRUE(pair._server.has_value());
+
+    bool errorReceived = false;
+    UV_EXIT_ON_ERROR(
+        pair._server->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            ASSERT_FALSE(result.has_value());
+            EXPECT_EQ(result.error(), scaler::wrapper::uv::Error {UV_ECONNRESET});
+            errorReceived = true;
+        }));
+
+    pair._client.reset();
+
+    runUntil(loop, errorReceived);
+    EXPECT_TRUE(errorReceived);
+}
+
+// A server rejects a connection that doesn't start with the handshake.
+TEST_F(SharedMemoryStreamTest, InvalidHandshake)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestPipePair pipes(loop);
+    ASSERT_TRUE(pipes._serverSide.has_value());
+
+    std::optional<scaler::wrapper::uv::Error> upgradeError {};
+    bool upgradeDone = false;
+    scaler::ymq::internal::SharedMemoryStream::upgradeAsServer(
+        std::move(pipes._serverSide.value()),
+        [&](std::expected<scaler::ymq::internal::SharedMemoryStream, scaler::wrapper::uv::Error> result) {
+            ASSERT_FALSE(result.has_value());
+            upgradeError = result.error();
+            upgradeDone  = true;
+        });
+
+    static const std::string request = "GET / HTTP/1.1\r\n\r\n";
+    UV_EXIT_ON_ERROR(pipes._client->write(
+        std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(request.data()), request.size()),
+        [](std::expected<void, scaler::wrapper::uv::Error>) {}));
+
+    runUntil(loop, upgradeDone);
+
+    ASSERT_TRUE(upgradeError.has_value());
+    EXPECT_EQ(upgradeError.value(), scaler::wrapper::uv::Error {UV_EPROTO});
+}
@@ -140,7 +140,7 @@ struct TestWebSocketStreamPair {
     TestWebSocketStreamPair& operator=(TestWebSocketStreamPair&&)      = delete;
 };
 
-// Builds a masked WebSocket frame (client->server) for payloads up to 125 bytes.
+// Builds a masked WebSocket frame (client->server).
 // byte0 encodes FIN and opcode: 0x82 (FIN|binary), 0x02 (FIN=0|binary),
 // 0x00 (FIN=0|continuation), 0x80 (FIN=1|continuation), 0x89 (FIN|ping).
 std::vector<uint8_t> maskedFrame(uint8_t byte0, std::vector<uint8_t> payload)
@@ -148,7 +148,17 @@ std::vector<uint8_t> maskedFrame(uint8_t byte0, std::vector<uint8_t> payload)
     const std::array<uint8_t, 4> maskKey = {0xDE, 0xAD, 0xBE, 0xEF};
     std::vector<uint8_t> frame;
     frame.push_back(byte0);
-    frame.push_back(0x80 | static_cast<uint8_t>(payload.size()));
+    if (payload.size() < 126) {
+        frame.push_back(0x80 | static_cast<uint8_t>(payload.size()));
+    } else if (payload.size() < 65536) {
+        frame.push_back(0x80 | 126);
+        frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+        frame.push_back(static_cast<uint8_t>(payload.size()));
+    } else {
+        frame.push_back(0x80 | 127);
+        for (int i = 7; i >= 0; --i)
+            frame.push_back(static_cast<uint8_t>(payload.size() >> (i * 8)));
+    }
     frame.insert(frame.end(), maskKey.begin(), maskKey.end());
     for (size_t i = 0; i < payload.size(); ++i)
         frame.push_back(payload[i] ^ maskKey[i % 4]);
@@ -276,6 +286,66 @@ TEST_F(WebSocketStreamTest, FragmentedMessage)
     loop.run(UV_RUN_DEFAULT);
 }
 
+// Sends a burst of small frames followed by a frame larger than a single read, all in one write, and verifies that
+// every message is delivered intact and in order.
+TEST_F(WebSocketStreamTest, FrameBurstAndLargeFrame)
+{
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    TestWebSocketStreamPair pair(loop);
+
+    constexpr size_t nSmallFrames   = 1000;
+    constexpr size_t largeFrameSize = 1024 * 1024 + 3;
+
+    std::vector<std::vector<uint8_t>> expected;
+    auto allFrames = std::make_shared<std::vector<uint8_t>>();
+
+    for (size_t i = 0; i < nSmallFrames; ++i) {
+        // Vary the payload sizes so that the frames straddle the read boundaries at every possible offset.
+        std::vector<uint8_t> payload(i % 300);
+        for (size_t j = 0; j < payload.size(); ++j)
+            payload[j] = static_cast<uint8_t>(i + j);
+        expected.push_back(payload);
+
+        const auto frame = maskedFrame(0x82, std::move(payload));
+        allFrames->insert(allFrames->end(), frame.begin(), frame.end());
+    }
+
+    std::vector<uint8_t> largePayload(largeFrameSize);
+    for (size_t j = 0; j < largePayload.size(); ++j)
+        largePayload[j] = static_cast<uint8_t>(j * 7);
+    expected.push_back(largePayload);
+
+    const auto largeFrame = maskedFrame(0x82, std::move(largePayload));
+    allFrames->insert(allFrames->end(), largeFrame.begin(), largeFrame.end());
+
+    std::vector<std::vector<uint8_t>> received;
+    bool done = false;
+
+    UV_EXIT_ON_ERROR(
+        pair._server->readStart([&](std::expected<std::span<const uint8_t>, scaler::wrapper::uv::Error> result) {
+            if (!result.has_value())
+                return;
+            received.emplace_back(result->begin(), result->end());
+            done = received.size() == expected.size();
+        }));
+
+    const std::span<const uint8_t> frameSpan(*allFrames);
+    UV_EXIT_ON_ERROR(pair._tcp->_client->write(
+        std::span<const std::span<const uint8_t>>(&frameSpan, 1),
+        [allFrames](std::expected<void, scaler::wrapper::uv::Error>) {}));
+
+    runUntil(loop, done);
+
+    ASSERT_EQ(received.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(received[i], expected[i]) << "message " << i;
+
+    pair._server->readStop();
+    UV_EXIT_ON_ERROR(pair._server->closeReset());
+    UV_EXIT_ON_ERROR(pair._tcp->_client->closeReset());
+    loop.run(UV_RUN_DEFAULT);
+}
+
 // Verifies that a PING frame from the client causes the server to send back a PONG.
 TEST_F(WebSocketStreamTest, PingReceivesPong)
 {
@@ -5,6 +5,7 @@
 #include <map>
 #include <span>
 #include <string>
+#include <vector>
 
 #include "scaler/ymq/internal/websocket_utils.h"
 
@@ -175,3 +176,48 @@ TEST_F(WebSocketUtilsTest, ExtractHeadersMissingHeaderReturnsEnd)
     const auto map = scaler::ymq::internal::extractHeaders(headers);
     EXPECT_EQ(map.find("sec-websocket-key"), map.end());
 }
+
+// ---------------------------------------------------------------------------
+// applyWebSocketMask
+// ---------------------------------------------------------------------------
+
+TEST_F(WebSocketUtilsTest, ApplyWebSocketMaskMatchesBytewiseMasking)
+{
+    const scaler::ymq::internal::WebSocketMaskKey maskKey = {0x12, 0x34, 0x56, 0x78};
+
+    // Cover the vectorized loops, the word loop and the byte tail, at every key offset.
+    for (size_t size = 0; size < 100; ++size) {
+        for (size_t keyOffset = 0; keyOffset < 4; ++keyOffset) {
+            std::vector<uint8_t> source(size);
+            for (size_t i = 0; i < size; ++i)
+                source[i] = static_cast<uint8_t>(i * 31 + 7);
+
+            std::vector<uint8_t> expected(size);
+            for (size_t i = 0; i < size; ++i)
+                expected[i] = source[i] ^ maskKey[(keyOffset + i) % 4];
+
+            std::vector<uint8_t> masked(size);
+            scaler::ymq::internal::applyWebSocketMask(source, masked, maskKey, keyOffset);
+            EXPECT_EQ(masked, expected) << "size " << size << ", offset " << keyOffset;
+
+            // In place.
+            scaler::ymq::internal::applyWebSocketMask(source, source, maskKey, keyOffset);
+            EXPECT_EQ(source, expected) << "size " << size << ", offset " << keyOffset;
+        }
+    }
+}
+
+TEST_F(WebSocketUtilsTest, ApplyWebSocketMaskTwiceRestoresPayload)
+{
+    const auto maskKey = scaler::ymq::internal::generateWebSocketMaskKey();
+
+    std::vector<uint8_t> payload(4096 + 13);
+    for (size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<uint8_t>(i);
+    const std::vector<uint8_t> original = payload;
+
+    scaler::ymq::internal::applyWebSocketMask(payload, payload, maskKey);
+    scaler::ymq::internal::applyWebSocketMask(payload, payload, maskKey);
+
+    EXPECT_EQ(payload, original);
+}
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <expected>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "scaler/wrapper/uv/callback.h"
@@ -15,6 +21,7 @@
 #include "scaler/ymq/internal/connect_client.h"
 #include "scaler/ymq/internal/message_connection.h"
 #include "scaler/ymq/io_context.h"
+#include "scaler/ymq/send_queue_limits.h"
 #include "tests/cpp/ymq/common/utils.h"
 
 namespace {
@@ -255,6 +262,94 @@ TEST_P(YMQBinderSocketTest, SendMulticastMessage)
     }
 }
 
+TEST_P(YMQBinderSocketTest, SendMulticastMessageToPrefix)
+{
+    // Test that multicast messages only reach the peers whose identity starts with the prefix, on all threads
+
+    constexpr size_t numThreads = 2;
+
+    const std::vector<scaler::ymq::Identity> clientIdentities {"a", "ab", "abc", "abd-1", "ac", "b"};
+    const scaler::ymq::Identity prefix = "ab";
+
+    scaler::ymq::IOContext context {numThreads};
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    scaler::ymq::BinderSocket binder {context, BinderClientPair::binderIdentity, numThreads};
+
+    std::promise<scaler::ymq::Address> bindPromise {};
+    binder.bindTo(
+        getTransportAddress(GetParam(), 0),
+        [&](std::expected<scaler::ymq::Address, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            bindPromise.set_value(result.value());
+        },
+        getTLSConfig(GetParam()));
+
+    scaler::ymq::Address boundAddress = bindPromise.get_future().get();
+
+    // Connect the clients, and make each of them send a message so that the binder knows their identity
+
+    std::vector<std::vector<std::string>> clientPayloads(clientIdentities.size());
+
+    std::vector<std::unique_ptr<scaler::ymq::internal::MessageConnection>> clients {};
+    std::vector<scaler::ymq::internal::ConnectClient> connectClients {};
+
+    for (size_t i = 0; i < clientIdentities.size(); ++i) {
+        auto& client = clients.emplace_back(std::make_unique<scaler::ymq::internal::MessageConnection>(
+            clientIdentities[i],
+            std::nullopt,
+            [](scaler::ymq::Identity) {},
+            [](auto) { FAIL() << "Unexpected disconnect on client"; },
+            [&, i](std::unique_ptr<scaler::ymq::Bytes> payload) {
+                clientPayloads[i].push_back(*payload->asString());
+            }));
+
+        client->sendMessage(std::make_unique<scaler::ymq::BufferedBytes>(clientIdentities[i]), [](auto, auto) {});
+
+        auto onConnect = [client = client.get()](
+                             std::expected<scaler::ymq::internal::Client, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            client->connect(std::move(result.value()));
+        };
+
+        connectClients.push_back(scaler::ymq::internal::ConnectClient::init(loop, boundAddress, onConnect).value());
+    }
+
+    std::atomic<size_t> binderMessagesReceived {0};
+    for (size_t i = 0; i < clientIdentities.size(); ++i) {
+        binder.recvMessage([&](std::expected<scaler::ymq::Message, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            ++binderMessagesReceived;
+        });
+    }
+
+    while (binderMessagesReceived < clientIdentities.size()) {
+        loop.run(UV_RUN_NOWAIT);
+    }
+
+    // Send a multicast message, followed by a broadcast message that all the clients receive after it
+
+    binder.sendMulticastMessage(std::make_unique<scaler::ymq::BufferedBytes>("multicast"), prefix);
+    binder.sendMulticastMessage(std::make_unique<scaler::ymq::BufferedBytes>("broadcast"));
+
+    auto allReceivedBroadcast = [&]() {
+        return std::ranges::all_of(clientPayloads, [](const auto& payloads) {
+            return !payloads.empty() && payloads.back() == "broadcast";
+        });
+    };
+
+    while (!allReceivedBroadcast()) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    for (size_t i = 0; i < clientIdentities.size(); ++i) {
+        if (clientIdentities[i].starts_with(prefix)) {
+            ASSERT_EQ(clientPayloads[i], (std::vector<std::string> {"multicast", "broadcast"})) << clientIdentities[i];
+        } else {
+            ASSERT_EQ(clientPayloads[i], (std::vector<std::string> {"broadcast"})) << clientIdentities[i];
+        }
+    }
+}
+
 TEST_P(YMQBinderSocketTest, RecvMessage)
 {
     // Test that the binder can receive messages
@@ -322,6 +417,70 @@ TEST_P(YMQBinderSocketTest, RecvMessage)
     ASSERT_EQ(message.payload->asString(), messagePayload);
 }
 
+TEST_P(YMQBinderSocketTest, RecvMessages)
+{
+    // Test that the binder can receive batches of messages
+
+    constexpr size_t nMessages = 10;
+    constexpr size_t maxCount  = 4;
+
+    auto onClientRecvMessage = [](std::unique_ptr<scaler::ymq::Bytes>) { FAIL() << "Unexpected message on client"; };
+
+    auto onClientDisconnect = [](auto) { FAIL() << "Unexpected disconnect on client"; };
+
+    BinderClientPair connections(GetParam(), std::move(onClientRecvMessage), std::move(onClientDisconnect));
+
+    scaler::ymq::BinderSocket& binder                = connections.binder();
+    scaler::ymq::internal::MessageConnection& client = connections.client();
+    scaler::wrapper::uv::Loop& loop                  = connections.loop();
+
+    auto recvMessages = [&]() {
+        std::promise<std::vector<scaler::ymq::Message>> recvCalled {};
+        auto future = recvCalled.get_future();
+
+        binder.recvMessages(
+            maxCount, [&](std::expected<std::vector<scaler::ymq::Message>, scaler::ymq::Error> result) {
+                ASSERT_TRUE(result.has_value());
+                recvCalled.set_value(std::move(*result));
+            });
+
+        return future.get();
+    };
+
+    // Make the client send all the messages, waiting for them to be sent
+
+    size_t nSent       = 0;
+    auto onMessageSent = [&](std::expected<void, scaler::ymq::Error> result,
+                             [[maybe_unused]] std::unique_ptr<scaler::ymq::Bytes>) {
+        ASSERT_TRUE(result.has_value());
+        ++nSent;
+    };
+
+    for (size_t i = 0; i < nMessages; ++i) {
+        client.sendMessage(std::make_unique<scaler::ymq::BufferedBytes>(std::to_string(i)), onMessageSent);
+    }
+
+    while (nSent < nMessages) {
+        loop.run(UV_RUN_NOWAIT);
+    }
+
+    // Receive the messages in batches, in order
+
+    size_t nReceived = 0;
+    while (nReceived < nMessages) {
+        std::vector<scaler::ymq::Message> messages = recvMessages();
+
+        ASSERT_FALSE(messages.empty());
+        ASSERT_LE(messages.size(), maxCount);
+
+        for (const auto& message: messages) {
+            ASSERT_EQ(message.address->asString(), BinderClientPair::clientIdentity);
+            ASSERT_EQ(message.payload->asString(), std::to_string(nReceived));
+            ++nReceived;
+        }
+    }
+}
+
 TEST_P(YMQBinderSocketTest, CloseConnection)
 {
     // Test that the client receives a disconnect event when the binder calls closeConnection()
@@ -461,6 +620,90 @@ TEST_P(YMQBinderSocketTest, SendToClosedIdentityFailsFast)
     ASSERT_EQ(result.error()._errorCode, scaler::ymq::Error::ErrorCode::ConnectorSocketClosedByRemoteEnd);
 }
 
+TEST_P(YMQBinderSocketTest, MultiThreaded)
+{
+    // Test that a binder spreading its connections across several threads routes messages from and to all its peers
+
+    constexpr size_t numThreads = 4;
+    constexpr size_t numClients = 16;
+
+    scaler::ymq::IOContext context {numThreads};
+    scaler::wrapper::uv::Loop loop = UV_EXIT_ON_ERROR(scaler::wrapper::uv::Loop::init());
+    scaler::ymq::BinderSocket binder {context, BinderClientPair::binderIdentity, numThreads};
+
+    ASSERT_EQ(binder.numThreads(), numThreads);
+
+    std::promise<scaler::ymq::Address> bindPromise {};
+    binder.bindTo(
+        getTransportAddress(GetParam(), 0),
+        [&](std::expected<scaler::ymq::Address, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            bindPromise.set_value(result.value());
+        },
+        getTLSConfig(GetParam()));
+
+    scaler::ymq::Address boundAddress = bindPromise.get_future().get();
+
+    // Connect the clients, and make each of them send a message with its identity
+
+    size_t clientMessagesReceived = 0;
+
+    std::vector<std::unique_ptr<scaler::ymq::internal::MessageConnection>> clients {};
+    std::vector<scaler::ymq::internal::ConnectClient> connectClients {};
+
+    for (size_t i = 0; i < numClients; ++i) {
+        const scaler::ymq::Identity clientIdentity = "client-" + std::to_string(i);
+
+        auto& client = clients.emplace_back(std::make_unique<scaler::ymq::internal::MessageConnection>(
+            clientIdentity,
+            std::nullopt,
+            [](scaler::ymq::Identity identity) { ASSERT_EQ(identity, BinderClientPair::binderIdentity); },
+            [](auto) { FAIL() << "Unexpected disconnect on client"; },
+            [&, clientIdentity](std::unique_ptr<scaler::ymq::Bytes> payload) {
+                ASSERT_EQ(payload->asString(), clientIdentity);
+                ++clientMessagesReceived;
+            }));
+
+        client->sendMessage(std::make_unique<scaler::ymq::BufferedBytes>(clientIdentity), [](auto result, auto) {
+            ASSERT_TRUE(result.has_value());
+        });
+
+        auto onConnect = [client = client.get()](
+                             std::expected<scaler::ymq::internal::Client, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            client->connect(std::move(result.value()));
+        };
+
+        connectClients.push_back(scaler::ymq::internal::ConnectClient::init(loop, boundAddress, onConnect).value());
+    }
+
+    // Receive all the messages on the binder, and echo them back
+
+    std::mutex binderMutex {};
+    size_t binderMessagesReceived = 0;
+
+    for (size_t i = 0; i < numClients; ++i) {
+        binder.recvMessage([&](std::expected<scaler::ymq::Message, scaler::ymq::Error> result) {
+            ASSERT_TRUE(result.has_value());
+            ASSERT_EQ(result->address->asString(), result->payload->asString());
+
+            binder.sendMessage(*result->address->asString(), std::move(result->payload), [](auto sendResult, auto) {
+                ASSERT_TRUE(sendResult.has_value());
+            });
+
+            std::lock_guard<std::mutex> lock {binderMutex};
+            ++binderMessagesReceived;
+        });
+    }
+
+    while (clientMessagesReceived < numClients) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    std::lock_guard<std::mutex> lock {binderMutex};
+    ASSERT_EQ(binderMessagesReceived, numClients);
+}
+
 TEST_P(YMQBinderSocketTest, StopRequested)
 {
     scaler::ymq::IOContext context {};
@@ -506,6 +749,102 @@ TEST_P(YMQBinderSocketTest, StopRequested)
     ASSERT_EQ(sendError->_errorCode, scaler::ymq::Error::ErrorCode::SocketStopRequested);
 }
 
+namespace {
+
+// Send a message to a binder's peer, returning the send result and the returned payload.
+std::future<std::pair<std::expected<void, scaler::ymq::Error>, std::string>> sendToPeer(
+    scaler::ymq::BinderSocket& binder, const scaler::ymq::Identity& remoteIdentity, const std::string& payload)
+{
+    auto promise = std::make_shared<std::promise<std::pair<std::expected<void, scaler::ymq::Error>, std::string>>>();
+    auto future  = promise->get_future();
+
+    binder.sendMessage(
+        remoteIdentity,
+        std::make_unique<scaler::ymq::BufferedBytes>(payload),
+        [promise](std::expected<void, scaler::ymq::Error> result, std::unique_ptr<scaler::ymq::Bytes> payload) {
+            promise->set_value({std::move(result), payload->asString().value_or("")});
+        });
+
+    return future;
+}
+
+}  // namespace
+
+TEST(YMQBinderSocketSendQueueTest, RejectWhenFull)
+{
+    // Sends to peers that are not connected yet are queued, and must be bounded by both the per-peer and the
+    // per-socket limits.
+
+    scaler::ymq::IOContext context {};
+    scaler::ymq::BinderSocket binder {
+        context,
+        BinderClientPair::binderIdentity,
+        1,
+        scaler::ymq::SendQueueLimits {.maxMessages = 2},
+        scaler::ymq::SendQueueLimits {.maxBytes = 3 * messagePayload.size()}};
+
+    auto sentA1 = sendToPeer(binder, "peer-a", messagePayload);
+    auto sentA2 = sendToPeer(binder, "peer-a", messagePayload);
+    auto sentA3 = sendToPeer(binder, "peer-a", messagePayload);  // exceeds the peer's limit
+    auto sentB1 = sendToPeer(binder, "peer-b", messagePayload);
+    auto sentB2 = sendToPeer(binder, "peer-b", messagePayload);  // exceeds the socket's limit
+
+    ASSERT_EQ(sentA3.wait_for(std::chrono::seconds {1}), std::future_status::ready);
+    ASSERT_EQ(sentA3.get().first.error()._errorCode, scaler::ymq::Error::ErrorCode::SendQueueFull);
+
+    ASSERT_EQ(sentB2.wait_for(std::chrono::seconds {1}), std::future_status::ready);
+    ASSERT_EQ(sentB2.get().first.error()._errorCode, scaler::ymq::Error::ErrorCode::SendQueueFull);
+
+    // The accepted messages are still queued.
+    ASSERT_EQ(sentA1.wait_for(std::chrono::milliseconds {0}), std::future_status::timeout);
+    ASSERT_EQ(sentA2.wait_for(std::chrono::milliseconds {0}), std::future_status::timeout);
+    ASSERT_EQ(sentB1.wait_for(std::chrono::milliseconds {0}), std::future_status::timeout);
+
+    scaler::ymq::SendQueueDepth depth = binder.sendQueueDepth();
+    ASSERT_EQ(depth.messages, 3);
+    ASSERT_EQ(depth.bytes, 3 * messagePayload.size());
+
+    // Shutting down fails the queued messages, and empties the queue.
+
+    std::promise<void> shutdownDone {};
+    binder.shutdown([&]() { shutdownDone.set_value(); });
+    shutdownDone.get_future().wait();
+
+    ASSERT_EQ(sentA1.get().first.error()._errorCode, scaler::ymq::Error::ErrorCode::SocketStopRequested);
+}
+
+TEST(YMQBinderSocketSendQueueTest, DropOldestWhenFull)
+{
+    scaler::ymq::IOContext context {};
+    scaler::ymq::BinderSocket binder {
+        context,
+        BinderClientPair::binderIdentity,
+        1,
+        scaler::ymq::SendQueueLimits {.maxMessages = 2, .policy = scaler::ymq::SendQueueFullPolicy::DropOldest}};
+
+    auto sent1 = sendToPeer(binder, "peer-a", "message-1");
+    auto sent2 = sendToPeer(binder, "peer-a", "message-2");
+    auto sent3 = sendToPeer(binder, "peer-a", "message-3");
+
+    // The oldest message is dropped to make room for the newest one.
+    ASSERT_EQ(sent1.wait_for(std::chrono::seconds {1}), std::future_status::ready);
+
+    auto [result, payload] = sent1.get();
+    ASSERT_EQ(result.error()._errorCode, scaler::ymq::Error::ErrorCode::SendQueueFull);
+    ASSERT_EQ(payload, "message-1");
+
+    ASSERT_EQ(sent2.wait_for(std::chrono::milliseconds {0}), std::future_status::timeout);
+    ASSERT_EQ(sent3.wait_for(std::chrono::milliseconds {0}), std::future_status::timeout);
+
+    // The newest message is only queued after the oldest one's callback returned.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {1};
+    while (binder.sendQueueDepth().messages != 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(binder.sendQueueDepth().messages, 2);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     YMQTransport,
     YMQBinderSocketTest,
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <expected>
 #include <future>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/buffered_bytes.h"
 #include "scaler/ymq/bytes.h"
+#include "scaler/ymq/configuration.h"
 #include "scaler/ymq/connector_socket.h"
 #include "scaler/ymq/internal/accept_server.h"
 #include "scaler/ymq/internal/message_connection.h"
@@ -283,6 +285,72 @@ TEST_P(YMQConnectorSocketTest, RecvMessage)
     message = recvCalled.get_future().get();
 }
 
+TEST_P(YMQConnectorSocketTest, LargeMessages)
+{
+    // Test exchanging messages large enough to be passed as attachments on ipc:// connections
+
+    std::string largePayload(4 * scaler::ymq::minAttachmentSize, '\0');
+    for (size_t i = 0; i < largePayload.size(); ++i) {
+        largePayload[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    std::optional<std::string> serverReceived {};
+
+    ConnectorServerPair connections(
+        GetParam(),
+
+        // Server callbacks
+        []([[maybe_unused]] auto identity) {},                      // onRemoteIdentity
+        [](auto) { FAIL() << "Unexpected disconnect on server"; },  // onRemoteDisconnect
+        [&](std::unique_ptr<scaler::ymq::Bytes> receivedPayload) {  // onMessage
+            serverReceived = receivedPayload->asString();
+        },
+
+        // Connector callback
+        []([[maybe_unused]] auto result) {});
+
+    scaler::ymq::internal::MessageConnection& server = connections.server();
+    scaler::ymq::ConnectorSocket& connector          = connections.connector();
+    scaler::wrapper::uv::Loop& loop                  = connections.loop();
+
+    std::promise<scaler::ymq::Message> recvCalled {};
+    connector.recvMessage([&](std::expected<scaler::ymq::Message, scaler::ymq::Error> result) {
+        ASSERT_TRUE(result.has_value());
+        recvCalled.set_value(std::move(*result));
+    });
+
+    // Send a large message from the server
+    bool sendCalled = false;
+    server.sendMessage(
+        std::make_unique<scaler::ymq::BufferedBytes>(largePayload),
+        [&](std::expected<void, scaler::ymq::Error> result, [[maybe_unused]] std::unique_ptr<scaler::ymq::Bytes>) {
+            ASSERT_TRUE(result.has_value());
+            sendCalled = true;
+        });
+
+    while (!sendCalled) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    scaler::ymq::Message message = recvCalled.get_future().get();
+    ASSERT_EQ(message.payload->size(), largePayload.size());
+    ASSERT_TRUE(message.payload->asString() == largePayload);
+
+    // Send a large message from the connector
+    connector.sendMessage(
+        std::make_unique<scaler::ymq::BufferedBytes>(largePayload),
+        [](std::expected<void, scaler::ymq::Error> result, [[maybe_unused]] std::unique_ptr<scaler::ymq::Bytes>) {
+            ASSERT_TRUE(result.has_value());
+        });
+
+    while (!serverReceived.has_value()) {
+        loop.run(UV_RUN_ONCE);
+    }
+
+    ASSERT_EQ(serverReceived->size(), largePayload.size());
+    ASSERT_TRUE(serverReceived == largePayload);
+}
+
 TEST_P(YMQConnectorSocketTest, RemoteDisconnect)
 {
     // Test that ConnectorSocket properly handles a graceful remote disconnection
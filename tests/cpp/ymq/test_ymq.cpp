@@ -10,7 +10,9 @@
 #include "scaler/error/error.h"
 #include "scaler/ymq/address.h"
 #include "scaler/ymq/io_context.h"
+#include "scaler/ymq/tls_config.h"
 #include "tests/cpp/ymq/common/testing.h"
+#include "tests/cpp/ymq/common/utils.h"
 
 class YMQTest: public ::testing::Test {};
 
@@ -65,6 +67,12 @@ TEST_F(YMQTest, Address)
     ASSERT_EQ(address->type(), scaler::ymq::Address::Type::WebSocket);
     ASSERT_TRUE(address->secure());
 
+    address = scaler::ymq::Address::fromString("shm:///tmp/some_ipc_socket_name");
+    ASSERT_TRUE(address.has_value());
+    ASSERT_EQ(address->type(), scaler::ymq::Address::Type::SharedMemory);
+    ASSERT_FALSE(address->secure());
+    ASSERT_EQ(address->asSharedMemory().path, "/tmp/some_ipc_socket_name");
+
     // Invalid addresses
 
     address = scaler::ymq::Address::fromString("http://127.0.0.1:8080");
@@ -103,6 +111,27 @@ TEST_F(YMQTest, Address)
     address = scaler::ymq::Address::fromString("wss://127.0.0.1:443/ymq");
     ASSERT_TRUE(address.has_value());
     ASSERT_EQ(address->toString().value(), "wss://127.0.0.1:443/ymq");
+
+    address = scaler::ymq::Address::fromString("shm:///tmp/some_ipc_socket_name");
+    ASSERT_TRUE(address.has_value());
+    ASSERT_EQ(address->toString().value(), "shm:///tmp/some_ipc_socket_name");
+}
+
+TEST_F(YMQTest, TLSConfigSharesSSLContext)
+{
+    const scaler::ymq::TLSConfig config = getTLSConfig("tls").value();
+    const scaler::ymq::TLSConfig copy   = config;
+
+    auto context = config.getSSLContext();
+    ASSERT_TRUE(context.has_value());
+    ASSERT_NE(context->sessionCache(), nullptr);
+
+    // The credentials are only loaded once, all the connections share the same context.
+    ASSERT_EQ(config.getSSLContext()->native(), context->native());
+    ASSERT_EQ(copy.getSSLContext()->native(), context->native());
+
+    const scaler::ymq::TLSConfig other = getTLSConfig("tls").value();
+    ASSERT_NE(other.getSSLContext()->native(), context->native());
 }
 
 TEST_F(YMQTest, IOContext)
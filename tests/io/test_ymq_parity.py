@@ -85,6 +85,7 @@ class ModuleSurfaceParityTest(unittest.TestCase):
         "Message",
         "Address",
         "AddressType",
+        "MessagePriority",
         "IOContext",
         "BinderSocket",
         "ConnectorSocket",
@@ -152,6 +153,13 @@ class ErrorCodeParityTest(unittest.TestCase):
                 )
 
 
+class MessagePriorityParityTest(unittest.TestCase):
+    def test_priorities_match(self) -> None:
+        self.assertEqual(
+            {p.name: int(p) for p in _ymq_native.MessagePriority}, {p.name: int(p) for p in _ymq_wasm.MessagePriority}
+        )
+
+
 class BytesParityTest(unittest.TestCase):
     def test_bytes_roundtrip_matches(self) -> None:
         for payload in [b"", b"a", b"hello world", bytes(range(256))]:
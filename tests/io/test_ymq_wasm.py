@@ -27,7 +27,7 @@ from scaler.io.ymq._ymq_wasm import (
     YMQException,
 )
 
-_MAGIC = b"YMQ\x01"
+_MAGIC = b"YMQ\x03"
 _HEADER = "<Q"
 
 
@@ -35,6 +35,14 @@ def _frame(payload: bytes) -> bytes:
     return struct.pack(_HEADER, len(payload)) + payload
 
 
+def _fragmented_frame_start(size: int) -> bytes:
+    return struct.pack(_HEADER, (0b10 << 62) | size)
+
+
+def _fragment_frame(chunk: bytes) -> bytes:
+    return struct.pack(_HEADER, (0b11 << 62) | len(chunk)) + chunk
+
+
 class _FakeWebSocket:
     """Minimal stand-in for ``js.WebSocket`` to drive the shim from Python."""
 
@@ -272,6 +280,27 @@ class FramingTest(unittest.TestCase):
         self.assertEqual(len(received), 1)
         self.assertEqual(received[0].payload.data, b"first")
 
+    def test_fragmented_message_is_reassembled(self) -> None:
+        socket = self._open_handshaken()
+        received: List[Any] = []
+        socket.recv_message_with_callback(received.append)
+        socket.recv_message_with_callback(received.append)
+        # A whole (high priority) message can arrive between the fragments.
+        _feed(
+            socket,
+            _fragmented_frame_start(6) + _fragment_frame(b"abc") + _frame(b"urgent") + _fragment_frame(b"def"),
+        )
+        self.assertEqual([m.payload.data for m in received], [b"urgent", b"abcdef"])
+
+    def test_unexpected_fragment_fails_socket(self) -> None:
+        socket = self._open_handshaken()
+        received: List[Any] = []
+        socket.recv_message_with_callback(received.append)
+        _feed(socket, _fragment_frame(b"orphan"))
+        self.assertEqual(len(received), 1)
+        self.assertIsInstance(received[0], YMQException)
+        self.assertTrue(socket._closed)
+
 
 class ShutdownTest(unittest.TestCase):
     def test_shutdown_closes_ws_and_drains_callbacks(self) -> None:
@@ -1,7 +1,15 @@
 import asyncio
 import unittest
 
-from scaler.io.ymq import BinderSocket, Bytes, ConnectorSocket, ErrorCode, InvalidAddressFormatError, IOContext
+from scaler.io.ymq import (
+    BinderSocket,
+    Bytes,
+    ConnectorSocket,
+    ErrorCode,
+    InvalidAddressFormatError,
+    IOContext,
+    SendQueueFullError,
+)
 
 
 class TestSockets(unittest.IsolatedAsyncioTestCase):
@@ -47,6 +55,70 @@ class TestSockets(unittest.IsolatedAsyncioTestCase):
         msg2 = await connector2.recv_message()
         self.assertEqual(msg2.payload.data, b"2")
 
+    async def test_multi_threaded_binder(self):
+        ctx = IOContext(num_threads=4)
+        binder = BinderSocket(ctx, "binder", num_threads=4)
+        self.assertEqual(binder.num_threads, 4)
+
+        address = await binder.bind_to("tcp://127.0.0.1:0")
+
+        connectors = [ConnectorSocket.connect(ctx, f"connector{i}", repr(address)) for i in range(8)]
+
+        for connector in connectors:
+            await connector.send_message(Bytes(connector.identity.encode()))
+
+        for _ in connectors:
+            msg = await binder.recv_message()
+            assert msg.address is not None
+            self.assertEqual(msg.address.data, msg.payload.data)
+            await binder.send_message(msg.address.data.decode(), msg.payload)
+
+        for connector in connectors:
+            msg = await connector.recv_message()
+            self.assertEqual(msg.payload.data, connector.identity.encode())
+
+    async def test_recv_messages(self):
+        ctx = IOContext()
+        binder = BinderSocket(ctx, "binder")
+
+        address = await binder.bind_to("tcp://127.0.0.1:0")
+
+        connector = ConnectorSocket.connect(ctx, "connector", repr(address))
+
+        for i in range(10):
+            await connector.send_message(Bytes(str(i).encode()))
+
+        payloads = []
+        while len(payloads) < 10:
+            messages = await binder.recv_messages(4)
+            self.assertGreater(len(messages), 0)
+            self.assertLessEqual(len(messages), 4)
+            payloads.extend(msg.payload.data for msg in messages)
+
+        self.assertEqual(payloads, [str(i).encode() for i in range(10)])
+
+        with self.assertRaises(ValueError):
+            await binder.recv_messages(0)
+
+    async def test_send_queue_limits(self):
+        ctx = IOContext()
+        binder = BinderSocket(ctx, "binder", max_queued_messages=2)
+
+        await binder.bind_to("tcp://127.0.0.1:0")
+
+        # The peer never connects, the messages remain queued
+        pending = [asyncio.ensure_future(binder.send_message("connector", Bytes(b"payload"))) for _ in range(2)]
+        await asyncio.sleep(0)
+
+        with self.assertRaises(SendQueueFullError) as exc:
+            await binder.send_message("connector", Bytes(b"payload"))
+        self.assertEqual(exc.exception.code, ErrorCode.SendQueueFull)
+
+        self.assertEqual(binder.send_queue_depth, (2, 2 * len(b"payload")))
+
+        for future in pending:
+            future.cancel()
+
     async def test_pingpong(self):
         ctx = IOContext()
         binder = BinderSocket(ctx, "binder")